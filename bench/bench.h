@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+namespace bench {
+
+// Runs `body` repeatedly for at least `min_seconds` and returns
+// the average seconds spent per run
+template <typename F>
+auto time_per_run(F&& body, double min_seconds = 0.5) -> double {
+    using clock = std::chrono::steady_clock;
+    auto const start = clock::now();
+    std::size_t runs = 0;
+    double elapsed = 0;
+    do {
+        body();
+        ++runs;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < min_seconds);
+    return elapsed / static_cast<double>(runs);
+}
+
+// keeps the optimizer from discarding a computed value
+template <typename T>
+void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static_cast<void>(static_cast<T const volatile&>(value));
+#endif
+}
+
+inline void report(char const* name, std::size_t bytes, double seconds) {
+    auto const mb_per_s = static_cast<double>(bytes) / seconds / (1024.0 * 1024.0);
+    std::printf("%-40s %10.1f MB/s %12.3f ms\n", name, mb_per_s, seconds * 1000.0);
+}
+
+// many small objects with string members, the case where per-node
+// allocations and the destructor walk dominate
+inline auto make_records(std::size_t count) -> std::string {
+    std::string out = "[";
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i != 0) { out += ","; }
+        out += R"({"id":)" + std::to_string(i)
+            + R"(,"name":"user number )" + std::to_string(i) + R"( with a long name")"
+            + R"(,"roles":["reader","writer"],"profile":{"country":"somewhere far away","age":)"
+            + std::to_string(i % 90) + "}}";
+    }
+    out += "]";
+    return out;
+}
+
+} // namespace bench
@@ -0,0 +1,198 @@
+#include "bench.h"
+#include "corpus.h"
+#include "json_parser/core.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace json;
+
+// the documents of the tweets corpus, see corpus.h
+namespace model {
+
+struct User {
+    std::uint64_t id = 0;
+    std::string name;
+    std::string screen_name;
+    std::uint64_t followers_count = 0;
+    bool verified = false;
+};
+JSON_PARSER_BIND(User, id, name, screen_name, followers_count, verified)
+
+struct Hashtag {
+    std::string text;
+    std::vector<int> indices;
+};
+JSON_PARSER_BIND(Hashtag, text, indices)
+
+struct Entities {
+    std::vector<Hashtag> hashtags;
+    std::vector<std::string> urls;
+};
+JSON_PARSER_BIND(Entities, hashtags, urls)
+
+struct Status {
+    std::uint64_t id = 0;
+    std::string id_str;
+    std::string created_at;
+    std::string text;
+    bool truncated = false;
+    std::optional<std::uint64_t> in_reply_to_status_id;
+    User user;
+    Entities entities;
+    std::uint64_t retweet_count = 0;
+    std::uint64_t favorite_count = 0;
+    std::string lang;
+};
+JSON_PARSER_BIND(Status, id, id_str, created_at, text, truncated, in_reply_to_status_id, user, entities,
+                 retweet_count, favorite_count, lang)
+
+struct Metadata {
+    std::uint64_t count = 0;
+};
+JSON_PARSER_BIND(Metadata, count)
+
+struct Timeline {
+    std::vector<Status> statuses;
+    Metadata search_metadata;
+};
+JSON_PARSER_BIND(Timeline, statuses, search_metadata)
+
+} // namespace model
+
+// the hand written conversions bindings replace
+static auto to_user(Json const& json) -> model::User {
+    auto const& object = json.object();
+    return { object.at("id").unsigned_integer(), std::string(object.at("name").string()),
+             std::string(object.at("screen_name").string()), object.at("followers_count").unsigned_integer(),
+             object.at("verified").boolean() };
+}
+
+static auto to_timeline(Json const& json) -> model::Timeline {
+    auto timeline = model::Timeline{};
+    for (auto const& element : json.object().at("statuses").array()) {
+        auto const& object = element.object();
+        auto& status = timeline.statuses.emplace_back();
+        status.id = object.at("id").unsigned_integer();
+        status.id_str = object.at("id_str").string();
+        status.created_at = object.at("created_at").string();
+        status.text = object.at("text").string();
+        status.truncated = object.at("truncated").boolean();
+        if (auto const& reply = object.at("in_reply_to_status_id"); not reply.is_null()) {
+            status.in_reply_to_status_id = reply.unsigned_integer();
+        }
+        status.user = to_user(object.at("user"));
+        auto const& entities = object.at("entities").object();
+        for (auto const& tag : entities.at("hashtags").array()) {
+            auto& hashtag = status.entities.hashtags.emplace_back();
+            hashtag.text = tag.object().at("text").string();
+            for (auto const& index : tag.object().at("indices").array()) {
+                hashtag.indices.push_back(static_cast<int>(index.integer()));
+            }
+        }
+        for (auto const& url : entities.at("urls").array()) {
+            status.entities.urls.emplace_back(url.string());
+        }
+        status.retweet_count = object.at("retweet_count").unsigned_integer();
+        status.favorite_count = object.at("favorite_count").unsigned_integer();
+        status.lang = object.at("lang").string();
+    }
+    timeline.search_metadata.count = json.object().at("search_metadata").object().at("count").unsigned_integer();
+    return timeline;
+}
+
+static auto to_json(model::Timeline const& timeline) -> Json {
+    auto statuses = Json(Type::Array);
+    for (auto const& status : timeline.statuses) {
+        auto object = Json(Type::Object);
+        auto& members = object.object();
+        members["id"] = Json(status.id);
+        members["id_str"] = Json(std::string_view(status.id_str));
+        members["created_at"] = Json(std::string_view(status.created_at));
+        members["text"] = Json(std::string_view(status.text));
+        members["truncated"] = Json(status.truncated);
+        members["in_reply_to_status_id"] = status.in_reply_to_status_id ? Json(*status.in_reply_to_status_id) : Json();
+        auto user = Json(Type::Object);
+        user.object()["id"] = Json(status.user.id);
+        user.object()["name"] = Json(std::string_view(status.user.name));
+        user.object()["screen_name"] = Json(std::string_view(status.user.screen_name));
+        user.object()["followers_count"] = Json(status.user.followers_count);
+        user.object()["verified"] = Json(status.user.verified);
+        members["user"] = std::move(user);
+        auto hashtags = Json(Type::Array);
+        for (auto const& hashtag : status.entities.hashtags) {
+            auto tag = Json(Type::Object);
+            tag.object()["text"] = Json(std::string_view(hashtag.text));
+            auto indices = Json(Type::Array);
+            for (auto const index : hashtag.indices) { indices.array().emplace_back(index); }
+            tag.object()["indices"] = std::move(indices);
+            hashtags.array().push_back(std::move(tag));
+        }
+        auto urls = Json(Type::Array);
+        for (auto const& url : status.entities.urls) { urls.array().emplace_back(std::string_view(url)); }
+        auto entities = Json(Type::Object);
+        entities.object()["hashtags"] = std::move(hashtags);
+        entities.object()["urls"] = std::move(urls);
+        members["entities"] = std::move(entities);
+        members["retweet_count"] = Json(status.retweet_count);
+        members["favorite_count"] = Json(status.favorite_count);
+        members["lang"] = Json(std::string_view(status.lang));
+        statuses.array().push_back(std::move(object));
+    }
+    auto metadata = Json(Type::Object);
+    metadata.object()["count"] = Json(timeline.search_metadata.count);
+    auto root = Json(Type::Object);
+    root.object()["statuses"] = std::move(statuses);
+    root.object()["search_metadata"] = std::move(metadata);
+    return root;
+}
+
+int main() {
+    auto const corpus = bench::make_corpus(bench::Shape::Tweets, 4 * 1024 * 1024, 42);
+    std::printf("%s: %zu documents, %zu bytes\n", corpus.name, corpus.documents.size(), corpus.bytes);
+
+    auto timelines = std::vector<model::Timeline>{};
+    for (auto const& document : corpus.documents) {
+        timelines.push_back(parse_bound<model::Timeline>(document));
+        if (serialize_bound(timelines.back()) != document) {
+            std::printf("serialize_bound does not reproduce the corpus\n");
+            return 1;
+        }
+    }
+
+    auto const convert_seconds = bench::time_per_run([&] {
+        for (auto const& document : corpus.documents) {
+            bench::do_not_optimize(to_timeline(parse_string(document)));
+        }
+    });
+    bench::report("parse_string, then convert", corpus.bytes, convert_seconds);
+
+    auto const document_seconds = bench::time_per_run([&] {
+        for (auto const& document : corpus.documents) {
+            bench::do_not_optimize(to_timeline(parse_document(document).root()));
+        }
+    });
+    bench::report("parse_document, then convert", corpus.bytes, document_seconds);
+
+    auto const bound_seconds = bench::time_per_run([&] {
+        for (auto const& document : corpus.documents) {
+            bench::do_not_optimize(parse_bound<model::Timeline>(document));
+        }
+    });
+    bench::report("parse_bound", corpus.bytes, bound_seconds);
+
+    auto const to_json_seconds = bench::time_per_run([&] {
+        for (auto const& timeline : timelines) {
+            bench::do_not_optimize(serialize(to_json(timeline)));
+        }
+    });
+    bench::report("convert, then serialize", corpus.bytes, to_json_seconds);
+
+    auto const serialize_seconds = bench::time_per_run([&] {
+        for (auto const& timeline : timelines) {
+            bench::do_not_optimize(serialize_bound(timeline));
+        }
+    });
+    bench::report("serialize_bound", corpus.bytes, serialize_seconds);
+}
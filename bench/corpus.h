@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+// splitmix64, so a seed gives the same corpus on every platform and
+// standard library, unlike the std distributions
+class Random {
+public:
+
+    explicit Random(std::uint64_t seed) : state_(seed) { }
+
+    auto next() -> std::uint64_t {
+        auto z = (state_ += 0x9E3779B97F4A7C15u);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9u;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBu;
+        return z ^ (z >> 31);
+    }
+
+    // uniform enough in [0, bound) for generating data
+    auto below(std::uint64_t bound) -> std::uint64_t { return next() % bound; }
+
+    auto pick(std::vector<char const*> const& words) -> char const* {
+        return words[below(words.size())];
+    }
+
+private:
+
+    std::uint64_t state_;
+};
+
+enum class Shape {
+    Tweets,         // nested objects of mixed values, like a social media API
+    Numbers,        // arrays of integers and decimals, like metrics or coordinates
+    Logs,           // arrays of records whose strings need escapes
+    Deep,           // arrays and objects nested hundreds of levels
+    FlatObject,     // one object with thousands of members
+};
+
+struct Corpus {
+    char const* name;
+    std::vector<std::string> documents;
+    std::size_t bytes;
+};
+
+inline auto to_string(Shape shape) -> char const* {
+    switch (shape) {
+    case Shape::Tweets:     return "tweets";
+    case Shape::Numbers:    return "numbers";
+    case Shape::Logs:       return "logs";
+    case Shape::Deep:       return "deep";
+    case Shape::FlatObject: return "flat_object";
+    }
+    return "unknown";
+}
+
+namespace detail {
+
+inline auto make_tweet(Random& random, std::uint64_t id) -> std::string {
+    static std::vector<char const*> const words = {
+        "json", "parser", "fast", "today", "release", "coffee", "benchmark", "tape", "arena", "simd",
+    };
+    auto text = std::string{};
+    for (auto i = 0u, n = 5 + static_cast<unsigned>(random.below(15)); i < n; ++i) {
+        if (i != 0) { text += ' '; }
+        text += random.pick(words);
+    }
+    auto out = std::string{};
+    out += R"({"id":)" + std::to_string(id) + R"(,"id_str":")" + std::to_string(id) + R"(")";
+    out += R"(,"created_at":"Mon Oct )" + std::to_string(1 + random.below(28)) + R"( 12:00:00 +0000 2026")";
+    out += R"(,"text":")" + text + R"(","truncated":false,"in_reply_to_status_id":null)";
+    out += R"(,"user":{"id":)" + std::to_string(random.below(1'000'000)) + R"(,"name":"user )"
+        + std::to_string(random.below(1000)) + R"(","screen_name":"user_)" + std::to_string(random.below(1000))
+        + R"(","followers_count":)" + std::to_string(random.below(100'000))
+        + R"(,"verified":)" + (random.below(10) == 0 ? "true" : "false") + "}";
+    out += R"(,"entities":{"hashtags":[)";
+    for (auto i = 0u, n = static_cast<unsigned>(random.below(4)); i < n; ++i) {
+        if (i != 0) { out += ','; }
+        out += R"({"text":")" + std::string(random.pick(words)) + R"(","indices":[)"
+            + std::to_string(i * 10) + "," + std::to_string(i * 10 + 8) + "]}";
+    }
+    out += R"(],"urls":[]},"retweet_count":)" + std::to_string(random.below(5000));
+    out += R"(,"favorite_count":)" + std::to_string(random.below(20'000)) + R"(,"lang":"en"})";
+    return out;
+}
+
+inline auto make_tweets(Random& random, std::size_t count) -> std::string {
+    auto out = std::string(R"({"statuses":[)");
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i != 0) { out += ','; }
+        out += make_tweet(random, 1'000'000'000'000 + random.below(1'000'000'000));
+    }
+    out += R"(],"search_metadata":{"count":)" + std::to_string(count) + "}}";
+    return out;
+}
+
+inline auto make_numbers(Random& random, std::size_t count) -> std::string {
+    auto out = std::string("[");
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i != 0) { out += ','; }
+        auto const value = random.below(10'000'000);
+        switch (random.below(3)) {
+        case 0: out += std::to_string(value); break;
+        case 1: out += "-" + std::to_string(value / 100) + "." + std::to_string(value % 100'000); break;
+        default: out += std::to_string(value % 1000) + "." + std::to_string(value) + "e-" + std::to_string(value % 20); break;
+        }
+    }
+    out += "]";
+    return out;
+}
+
+inline auto make_logs(Random& random, std::size_t count) -> std::string {
+    static std::vector<char const*> const messages = {
+        R"(request \"GET /index.html\" served)",
+        R"(path C:\\data\\logs\\today.log rotated)",
+        R"(multi-line\nstack trace\n\tat main)",
+        R"(caf\u00e9 opened, price \u20ac3)",
+        R"(plain message without escapes)",
+    };
+    static std::vector<char const*> const levels = { "debug", "info", "warning", "error" };
+    auto out = std::string("[");
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i != 0) { out += ','; }
+        out += R"({"timestamp":"2026-10-18T12:)" + std::to_string(10 + random.below(50)) + R"(:00Z")";
+        out += R"(,"level":")" + std::string(random.pick(levels)) + R"(","message":")"
+            + random.pick(messages) + R"(","thread":)" + std::to_string(random.below(16)) + "}";
+    }
+    out += "]";
+    return out;
+}
+
+inline auto make_deep(Random& random, std::size_t depth) -> std::string {
+    auto out = std::string{};
+    auto closers = std::string{};
+    for (std::size_t i = 0; i < depth; ++i) {
+        if (random.below(2) == 0) {
+            out += R"([)" + std::to_string(i) + ",";
+            closers += ']';
+        } else {
+            out += R"({"level":)" + std::to_string(i) + R"(,"child":)";
+            closers += '}';
+        }
+    }
+    out += "null";
+    out.append(closers.rbegin(), closers.rend());
+    return out;
+}
+
+inline auto make_flat_object(Random& random, std::size_t members) -> std::string {
+    auto out = std::string("{");
+    for (std::size_t i = 0; i < members; ++i) {
+        if (i != 0) { out += ','; }
+        out += R"("field_)" + std::to_string(i) + R"(":)";
+        out += random.below(2) == 0 ? std::to_string(random.below(1'000'000)) : R"("value )" + std::to_string(i) + R"(")";
+    }
+    out += "}";
+    return out;
+}
+
+} // namespace detail
+
+// Documents of `shape` adding up to about `target_bytes`, the same ones for a given seed
+inline auto make_corpus(Shape shape, std::size_t target_bytes, std::uint64_t seed = 1) -> Corpus {
+    auto random = Random(seed);
+    auto corpus = Corpus{ to_string(shape), {}, 0 };
+    while (corpus.bytes < target_bytes) {
+        auto document = std::string{};
+        switch (shape) {
+        case Shape::Tweets:     document = detail::make_tweets(random, 50); break;
+        case Shape::Numbers:    document = detail::make_numbers(random, 2000); break;
+        case Shape::Logs:       document = detail::make_logs(random, 200); break;
+        case Shape::Deep:       document = detail::make_deep(random, 500); break;
+        case Shape::FlatObject: document = detail::make_flat_object(random, 5000); break;
+        }
+        corpus.bytes += document.size();
+        corpus.documents.push_back(std::move(document));
+    }
+    return corpus;
+}
+
+} // namespace bench
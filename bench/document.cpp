@@ -0,0 +1,62 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <string>
+
+using namespace json;
+
+// counts values, the cheapest useful SAX handler
+struct CountingHandler {
+    std::size_t values = 0;
+    auto on_null() -> bool                   { ++values; return true; }
+    auto on_bool(bool) -> bool               { ++values; return true; }
+    auto on_number(double) -> bool           { ++values; return true; }
+    auto on_string(std::string_view) -> bool { ++values; return true; }
+    auto on_key(std::string_view) -> bool    { return true; }
+    auto on_start_object() -> bool           { return true; }
+    auto on_end_object() -> bool             { ++values; return true; }
+    auto on_start_array() -> bool            { return true; }
+    auto on_end_array() -> bool              { ++values; return true; }
+};
+
+int main() {
+    auto const source = bench::make_records(50'000);
+    std::printf("records: %zu bytes\n", source.size());
+
+    auto const heap_seconds = bench::time_per_run([&] {
+        auto const json = parse_string(source);
+        bench::do_not_optimize(json);
+    });
+    bench::report("parse_string + destroy", source.size(), heap_seconds);
+
+    auto const arena_seconds = bench::time_per_run([&] {
+        auto const doc = parse_document(source);
+        bench::do_not_optimize(doc);
+    });
+    bench::report("parse_document + destroy", source.size(), arena_seconds);
+
+    auto const in_situ_seconds = bench::time_per_run([&] {
+        auto const doc = parse_document_in_situ(source);
+        bench::do_not_optimize(doc);
+    });
+    bench::report("parse_document_in_situ + destroy", source.size(), in_situ_seconds);
+
+    auto const sax_seconds = bench::time_per_run([&] {
+        auto handler = CountingHandler{};
+        bench::do_not_optimize(parse_sax(source, handler));
+        bench::do_not_optimize(handler.values);
+    });
+    bench::report("parse_sax (counting)", source.size(), sax_seconds);
+
+    // the size of a typical socket read
+    auto const chunk_size = std::size_t{4096};
+    auto const push_seconds = bench::time_per_run([&] {
+        auto handler = CountingHandler{};
+        auto parser = PushParser<CountingHandler>(handler);
+        for (std::size_t i = 0; i < source.size(); i += chunk_size) {
+            parser.feed(std::string_view(source).substr(i, chunk_size));
+        }
+        bench::do_not_optimize(parser.finish());
+        bench::do_not_optimize(handler.values);
+    });
+    bench::report("PushParser, 4 KiB chunks (counting)", source.size(), push_seconds);
+}
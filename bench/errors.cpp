@@ -0,0 +1,62 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <string>
+#include <vector>
+
+using namespace json;
+
+// small request bodies, most of them malformed like abusive traffic
+static auto make_requests(std::size_t count) -> std::vector<std::string> {
+    auto requests = std::vector<std::string>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        auto request = R"({"user":)" + std::to_string(i) + R"(,"action":"search","query":"term )"
+                     + std::to_string(i % 97) + R"(","page":)" + std::to_string(i % 10) + "}";
+        switch (i % 4) {
+        case 0:  break;
+        case 1:  request.resize(request.size() / 2); break;         // truncated
+        case 2:  request[request.size() / 3] = '@'; break;          // invalid character
+        default: request.insert(1, R"("user":0,)"); break;          // duplicate key
+        }
+        requests.push_back(std::move(request));
+    }
+    return requests;
+}
+
+int main() {
+    auto const requests = make_requests(100'000);
+    auto bytes = std::size_t{0};
+    for (auto const& request : requests) { bytes += request.size(); }
+    std::printf("requests: %zu, 3 in 4 malformed, %zu bytes\n", requests.size(), bytes);
+
+    auto const throw_seconds = bench::time_per_run([&] {
+        auto failures = std::size_t{0};
+        for (auto const& request : requests) {
+            try {
+                bench::do_not_optimize(parse_string(request));
+            } catch (JsonException const&) {
+                ++failures;
+            }
+        }
+        bench::do_not_optimize(failures);
+    });
+    bench::report("parse_string, catching JsonException", bytes, throw_seconds);
+
+    auto const code_seconds = bench::time_per_run([&] {
+        auto failures = std::size_t{0};
+        for (auto const& request : requests) {
+            auto const result = try_parse(request);
+            if (not result) { ++failures; }
+            bench::do_not_optimize(result);
+        }
+        bench::do_not_optimize(failures);
+    });
+    bench::report("try_parse", bytes, code_seconds);
+
+    auto const message_seconds = bench::time_per_run([&] {
+        for (auto const& request : requests) {
+            auto const result = try_parse(request);
+            if (not result) { bench::do_not_optimize(result.error().message(request)); }
+        }
+    });
+    bench::report("try_parse, then message()", bytes, message_seconds);
+}
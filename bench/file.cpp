@@ -0,0 +1,53 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace json;
+
+static auto read_into_string(std::string const& path) -> std::string {
+    auto file = std::ifstream(path, std::ios::binary);
+    auto ss = std::ostringstream{};
+    ss << file.rdbuf();
+    return std::move(ss).str();
+}
+
+int main() {
+    auto const path = (std::filesystem::temp_directory_path() / "json_parser_bench_file.json").string();
+    auto const size = [&] {
+        auto const source = bench::make_records(200'000);
+        std::ofstream(path, std::ios::binary) << source;
+        return source.size();
+    }();
+    std::printf("records: %zu bytes, served from the page cache\n", size);
+
+    auto const read_seconds = bench::time_per_run([&] {
+        auto const source = read_into_string(path);
+        bench::do_not_optimize(source);
+    });
+    bench::report("read into string", size, read_seconds);
+
+    auto const string_seconds = bench::time_per_run([&] {
+        auto const json = parse_string(read_into_string(path));
+        bench::do_not_optimize(json);
+    });
+    bench::report("read into string + parse_string", size, string_seconds);
+
+    auto const in_situ_seconds = bench::time_per_run([&] {
+        auto owned = std::make_shared<std::string const>(read_into_string(path));
+        auto const doc = parse_document_in_situ(*owned, owned);
+        bench::do_not_optimize(doc);
+    });
+    bench::report("read into string + in situ", size, in_situ_seconds);
+
+    auto const file_seconds = bench::time_per_run([&] {
+        auto const doc = parse_file(path);
+        bench::do_not_optimize(doc);
+    });
+    bench::report("parse_file (mapped, in situ)", size, file_seconds);
+
+    std::filesystem::remove(path);
+}
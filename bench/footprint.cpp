@@ -0,0 +1,64 @@
+#include "bench.h"
+#include "corpus.h"
+#include "json_parser/core.h"
+#include "json_parser/detail/DomBuilder.h"
+#include <cstdio>
+#include <memory_resource>
+
+using namespace json;
+
+// heap allocations, counting the bytes still allocated and their peak
+class LiveBytes : public std::pmr::memory_resource {
+public:
+
+    std::size_t live = 0;
+    std::size_t peak = 0;
+    std::size_t allocations = 0;
+
+private:
+
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+        live += bytes;
+        peak = std::max(peak, live);
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        live -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+int main() {
+    std::printf("sizeof(Json) %zu, sizeof(JsonObject::value_type) %zu\n\n",
+                sizeof(Json), sizeof(JsonObject::value_type));
+    std::printf("%-12s %12s %12s %8s %12s %14s\n", "corpus", "source", "tree", "ratio", "allocations", "parse_string");
+
+    for (auto const shape : { bench::Shape::Tweets, bench::Shape::Numbers, bench::Shape::Logs,
+                              bench::Shape::Deep, bench::Shape::FlatObject }) {
+        auto const corpus = bench::make_corpus(shape, 4 * 1024 * 1024, 42);
+
+        // the trees all alive at once, like a cache of parsed documents
+        auto resource = LiveBytes{};
+        auto trees = std::vector<Json>{};
+        for (auto const& document : corpus.documents) {
+            trees.push_back(build_dom(document, &resource));
+        }
+
+        auto const seconds = bench::time_per_run([&] {
+            for (auto const& document : corpus.documents) {
+                bench::do_not_optimize(parse_string(document));
+            }
+        });
+        auto const mb_per_s = static_cast<double>(corpus.bytes) / seconds / (1024.0 * 1024.0);
+        std::printf("%-12s %12zu %12zu %8.2f %12zu %9.1f MB/s\n", corpus.name, corpus.bytes, resource.live,
+                    static_cast<double>(resource.live) / static_cast<double>(corpus.bytes), resource.allocations,
+                    mb_per_s);
+        trees.clear();
+    }
+}
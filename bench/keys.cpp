@@ -0,0 +1,86 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace json;
+
+namespace {
+
+// counts the bytes held from the heap, to compare resident trees
+class HeldBytesResource : public std::pmr::memory_resource {
+public:
+
+    std::size_t held = 0;
+
+private:
+
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+        held += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        held -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override {
+        return this == &other;
+    }
+};
+
+// one record per document, with the descriptive key names of a typical API
+auto make_documents(std::size_t count) -> std::vector<std::string> {
+    auto documents = std::vector<std::string>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        documents.push_back(R"({"customer_identifier":)" + std::to_string(i)
+            + R"(,"registration_timestamp":"2024-01-01T00:00:00Z","preferred_language":"en")"
+            + R"(,"shipping_address":{"street_and_number":"Main Street 1","postal_code":"12345"}})");
+    }
+    return documents;
+}
+
+} // namespace
+
+int main() {
+    auto const documents = make_documents(20'000);
+    std::size_t bytes = 0;
+    for (auto const& document : documents) { bytes += document.size(); }
+
+    auto counting = HeldBytesResource{};
+    auto* const previous = std::pmr::set_default_resource(&counting);
+
+    auto const parse_all = [&](KeyDictionary* keys) {
+        auto parsed = std::vector<Json>{};
+        parsed.reserve(documents.size());
+        for (auto const& document : documents) {
+            parsed.push_back(keys != nullptr ? parse_string(document, *keys) : parse_string(document));
+        }
+        return parsed;
+    };
+
+    {
+        auto const before = counting.held;
+        auto const parsed = parse_all(nullptr);
+        std::printf("%-40s %10zu KiB\n", "resident, keys copied", (counting.held - before) / 1024);
+    }
+    {
+        auto keys = KeyDictionary{};
+        auto const before = counting.held;
+        auto const parsed = parse_all(&keys);
+        auto const stats = keys.stats();
+        std::printf("%-40s %10zu KiB\n", "resident, keys interned", (counting.held - before) / 1024);
+        std::printf("%-40s %10zu keys %zu bytes, hit rate %.4f\n", "dictionary", stats.keys, stats.bytes,
+                    stats.hit_rate());
+    }
+
+    bench::report("parse, keys copied", bytes, bench::time_per_run([&] {
+        bench::do_not_optimize(parse_all(nullptr));
+    }));
+    auto keys = KeyDictionary{};
+    bench::report("parse, keys interned", bytes, bench::time_per_run([&] {
+        bench::do_not_optimize(parse_all(&keys));
+    }));
+
+    std::pmr::set_default_resource(previous);
+}
@@ -0,0 +1,43 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <string>
+
+using namespace json;
+
+// a request payload of about 50 KB of which a handler reads a few fields
+static auto make_payload() -> std::string {
+    auto out = std::string(R"({"request_id":"abc-123","items":)");
+    out += bench::make_records(300);
+    out += R"(,"user":{"id":42,"name":"Ada","roles":["admin"]},"flags":{"dry_run":false}})";
+    return out;
+}
+
+int main() {
+    auto const payload = make_payload();
+    std::printf("payload: %zu bytes\n", payload.size());
+
+    auto const dom_seconds = bench::time_per_run([&] {
+        auto const json = parse_string(payload);
+        auto const& user = json.object().at("user").object();
+        bench::do_not_optimize(json.object().at("request_id").string());
+        bench::do_not_optimize(user.at("id").number());
+        bench::do_not_optimize(user.at("name").string());
+        bench::do_not_optimize(json.object().at("flags").object().at("dry_run").boolean());
+    });
+    bench::report("parse_string, 4 fields", payload.size(), dom_seconds);
+
+    auto const lazy_seconds = bench::time_per_run([&] {
+        auto const doc = LazyDocument(payload);
+        auto const user = doc["user"];
+        bench::do_not_optimize(doc["request_id"].get_string());
+        bench::do_not_optimize(user["id"].get_number());
+        bench::do_not_optimize(user["name"].get_string());
+        bench::do_not_optimize(doc["flags"]["dry_run"].get_bool());
+    });
+    bench::report("LazyDocument, 4 fields", payload.size(), lazy_seconds);
+
+    auto const validate_seconds = bench::time_per_run([&] {
+        LazyDocument(payload).validate();
+    });
+    bench::report("LazyDocument::validate", payload.size(), validate_seconds);
+}
@@ -0,0 +1,78 @@
+#include "bench.h"
+#include "counting_new.h"
+#include "json_parser/core.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace json;
+
+static auto make_lines(std::size_t count) -> std::string {
+    std::string out;
+    for (std::size_t i = 0; i < count; ++i) {
+        out += R"({"id":)" + std::to_string(i)
+            + R"(,"level":"info","message":"request number )" + std::to_string(i) + R"( served")"
+            + R"(,"tags":["http","api"],"latency_ms":)" + std::to_string(i % 250) + ".5}\n";
+    }
+    return out;
+}
+
+int main() {
+    auto const source = make_lines(200'000);
+    auto const hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("log lines: %zu bytes, %u hardware threads\n", source.size(), hardware);
+
+    // today's path: one parse_string call per line on the calling thread
+    auto const baseline_seconds = bench::time_per_run([&] {
+        std::size_t position = 0;
+        while (position < source.size()) {
+            auto const end = source.find('\n', position);
+            auto const json = parse_string(source.substr(position, end - position));
+            bench::do_not_optimize(json);
+            position = end + 1;
+        }
+    });
+    bench::report("parse_string per line", source.size(), baseline_seconds);
+
+    for (std::size_t threads = 1; threads <= std::max(4u, hardware); threads *= 2) {
+        auto options = NdJsonOptions{};
+        options.threads = threads;
+        options.ordered = false;
+        auto parser = NdJsonParser(options);
+
+        auto const seconds = bench::time_per_run([&] {
+            std::size_t lines = 0;
+            parser.parse(source, [&](NdJsonLine&&) { ++lines; });
+            bench::do_not_optimize(lines);
+        });
+        auto const name = "NdJsonParser, " + std::to_string(threads) + " threads";
+        bench::report(name.c_str(), source.size(), seconds);
+        std::printf("%-40s %10.2fx\n", "  speedup over parse_string per line", baseline_seconds / seconds);
+    }
+
+    // the parse contexts of the workers are warm after their first lines,
+    // what is left is the Json of every line and the bookkeeping of batches
+    std::printf("\n%-40s %12s\n", "heap allocations per line", "");
+    auto line_sources = std::vector<std::string>{};
+    for (std::size_t position = 0; position < source.size();) {
+        auto const end = source.find('\n', position);
+        line_sources.push_back(source.substr(position, end - position));
+        position = end + 1;
+    }
+    auto const lines = static_cast<double>(line_sources.size());
+    auto const allocated = heap_allocations();
+    for (auto const& line : line_sources) {
+        bench::do_not_optimize(parse_string(line));
+    }
+    std::printf("%-40s %12.2f\n", "parse_string per line", static_cast<double>(heap_allocations() - allocated) / lines);
+
+    auto options = NdJsonOptions{};
+    options.ordered = false;
+    auto parser = NdJsonParser(options);
+    for (auto const* pass : { "NdJsonParser, first parse", "NdJsonParser, steady state" }) {
+        auto const before = heap_allocations();
+        parser.parse(source, [](NdJsonLine&& line) { bench::do_not_optimize(line); });
+        std::printf("%-40s %12.2f\n", pass, static_cast<double>(heap_allocations() - before) / lines);
+    }
+}
@@ -0,0 +1,75 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <charconv>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace json;
+
+// numbers of one kind, comma separated inside an array
+static auto make_numbers(std::size_t count, bool ids) -> std::vector<std::string> {
+    auto random = std::mt19937_64(7);
+    auto numbers = std::vector<std::string>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        if (ids) {
+            numbers.push_back(std::to_string(random() >> 1));
+        } else {
+            numbers.push_back(std::to_string(random() % 100'000) + "." + std::to_string(random() % 1000));
+        }
+    }
+    return numbers;
+}
+
+static auto join(std::vector<std::string> const& numbers) -> std::string {
+    auto out = std::string("[");
+    for (auto const& number : numbers) {
+        if (out.size() > 1) { out += ','; }
+        out += number;
+    }
+    return out + "]";
+}
+
+int main() {
+    for (auto const ids : { true, false }) {
+        auto const numbers = make_numbers(200'000, ids);
+        auto const source = join(numbers);
+        std::printf("%s: %zu bytes\n", ids ? "64-bit ids" : "decimals with 3 digits", source.size());
+
+        // the conversion the scanner did before, lossy for ids
+        auto const from_chars_seconds = bench::time_per_run([&] {
+            auto sum = 0.0;
+            for (auto const& text : numbers) {
+                auto value = 0.0;
+                std::from_chars(text.data(), text.data() + text.size(), value);
+                sum += value;
+            }
+            bench::do_not_optimize(sum);
+        });
+        bench::report("from_chars to double", source.size(), from_chars_seconds);
+
+        auto const parse_number_seconds = bench::time_per_run([&] {
+            auto sum = 0.0;
+            for (auto const& text : numbers) {
+                auto number = Number{};
+                static_cast<void>(parse_number(text, number));
+                sum += number.to_double();
+            }
+            bench::do_not_optimize(sum);
+        });
+        bench::report("parse_number", source.size(), parse_number_seconds);
+
+        auto const scan_seconds = bench::time_per_run([&] {
+            auto scanner = Scanner(source);
+            std::size_t count = 0;
+            while (scanner.next_token().type != TokenType::Eof) { ++count; }
+            bench::do_not_optimize(count);
+        });
+        bench::report("Scanner", source.size(), scan_seconds);
+
+        auto const parse_seconds = bench::time_per_run([&] {
+            bench::do_not_optimize(parse_document(source));
+        });
+        bench::report("parse_document", source.size(), parse_seconds);
+    }
+}
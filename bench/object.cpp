@@ -0,0 +1,64 @@
+#include "bench.h"
+#include "json_parser/JsonValue.h"
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace json;
+
+// the std::map layout JsonObject replaced, kept here as the reference
+using map_t = std::pmr::map<Json::string_t, Json, std::less<>>;
+
+static void run(std::size_t members) {
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < members; ++i) {
+        keys.push_back("field_name_" + std::to_string(i * 7919 % 1000));
+    }
+
+    auto object = JsonObject{};
+    auto map = map_t{};
+    for (std::size_t i = 0; i < members; ++i) {
+        object.try_emplace(JsonObject::key_type(keys[i]), Json{ static_cast<double>(i) });
+        map.try_emplace(Json::string_t(keys[i]), Json{ static_cast<double>(i) });
+    }
+
+    auto const lookups = 1'000'000 / members * members;
+    auto const label = [members](char const* what) {
+        return std::string(what) + " (" + std::to_string(members) + " members)";
+    };
+    auto const report = [lookups](std::string const& name, double seconds) {
+        std::printf("%-40s %10.1f ns/op\n", name.c_str(), seconds * 1e9 / static_cast<double>(lookups));
+    };
+
+    report(label("lookup JsonObject"), bench::time_per_run([&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < lookups; ++i) { sum += object.at(keys[i % members]).number(); }
+        bench::do_not_optimize(sum);
+    }, 0.2));
+    report(label("lookup std::map"), bench::time_per_run([&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < lookups; ++i) { sum += map.find(std::string_view(keys[i % members]))->second.number(); }
+        bench::do_not_optimize(sum);
+    }, 0.2));
+
+    report(label("iterate JsonObject"), bench::time_per_run([&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < lookups / members; ++i) {
+            for (auto const& [key, value] : object) { sum += value.number(); }
+        }
+        bench::do_not_optimize(sum);
+    }, 0.2));
+    report(label("iterate std::map"), bench::time_per_run([&] {
+        double sum = 0;
+        for (std::size_t i = 0; i < lookups / members; ++i) {
+            for (auto const& [key, value] : map) { sum += value.number(); }
+        }
+        bench::do_not_optimize(sum);
+    }, 0.2));
+}
+
+int main() {
+    for (auto const members : { 3, 8, 16, 30, 100, 1000 }) {
+        run(static_cast<std::size_t>(members));
+    }
+}
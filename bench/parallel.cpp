@@ -0,0 +1,30 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+
+using namespace json;
+
+int main() {
+    auto const source = bench::make_records(200'000);
+    auto const hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("records: %zu bytes, %u hardware threads\n", source.size(), hardware);
+
+    auto const sequential_seconds = bench::time_per_run([&] {
+        auto const json = parse_string(source);
+        bench::do_not_optimize(json);
+    });
+    bench::report("parse_string", source.size(), sequential_seconds);
+
+    for (std::size_t threads = 1; threads <= std::max(4u, hardware); threads *= 2) {
+        auto pool = ThreadPool(threads);
+        auto const seconds = bench::time_per_run([&] {
+            auto const json = parse_string_parallel(source, pool);
+            bench::do_not_optimize(json);
+        });
+        auto const name = "parse_string_parallel, " + std::to_string(threads) + " threads";
+        bench::report(name.c_str(), source.size(), seconds);
+        std::printf("%-40s %10.2fx\n", "  speedup over parse_string", sequential_seconds / seconds);
+    }
+}
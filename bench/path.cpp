@@ -0,0 +1,50 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <string>
+#include <vector>
+
+using namespace json;
+
+// a routed message: a large body and a few fields the routes look at
+static auto make_message() -> std::string {
+    auto out = std::string(R"({"body":)");
+    out += bench::make_records(300);
+    out += R"(,"headers":{"topic":"orders","tenant":"acme","priority":3},"trace":["edge","gw"]})";
+    return out;
+}
+
+int main() {
+    auto const message = make_message();
+    std::printf("message: %zu bytes\n", message.size());
+
+    auto const paths = std::vector<JsonPath>{
+        JsonPath::pointer("/headers/topic"),
+        JsonPath::pointer("/headers/tenant"),
+        JsonPath::compile("$.headers.priority"),
+        JsonPath::compile("$.trace[-1]"),
+    };
+
+    auto const dom_seconds = bench::time_per_run([&] {
+        auto const json = parse_string(message);
+        for (auto const& path : paths) {
+            bench::do_not_optimize(path.find(json));
+        }
+    });
+    bench::report("parse_string + 4 paths", message.size(), dom_seconds);
+
+    auto const lazy_seconds = bench::time_per_run([&] {
+        auto const doc = LazyDocument(message);
+        for (auto const& path : paths) {
+            bench::do_not_optimize(path.find(doc.root()));
+        }
+    });
+    bench::report("raw input + 4 paths", message.size(), lazy_seconds);
+
+    auto const json = parse_string(message);
+    auto const built_seconds = bench::time_per_run([&] {
+        for (auto const& path : paths) {
+            bench::do_not_optimize(path.find(json));
+        }
+    });
+    bench::report("built Json, 4 paths", message.size(), built_seconds);
+}
@@ -0,0 +1,180 @@
+#include "bench.h"
+#include "json_parser/detail/Scanner.h"
+#include <cctype>
+#include <charconv>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <variant>
+
+using namespace json;
+
+// pretty-printed log records, mostly indentation and newlines
+static auto make_pretty_log(std::size_t records) -> std::string {
+    std::string out = "[\n";
+    for (std::size_t i = 0; i < records; ++i) {
+        out += "    {\n";
+        out += "        \"id\": " + std::to_string(i) + ",\n";
+        out += "        \"level\": \"info\",\n";
+        out += "        \"message\": \"request served in " + std::to_string(i % 97) + " ms\",\n";
+        out += "        \"tags\": [\n            \"http\",\n            \"api\"\n        ],\n";
+        out += "        \"ok\": true\n";
+        out += i + 1 == records ? "    }\n" : "    },\n";
+    }
+    out += "]\n";
+    return out;
+}
+
+/*
+The Scanner as it was before the structural index: every byte goes through
+advance(), which counts lines and columns, whitespace is skipped one byte
+at a time and strings are copied through a stringstream. Kept as the
+baseline the indexed Scanner is measured against; it assumes valid input.
+*/
+class BaselineScanner {
+public:
+
+    struct Token {
+        TokenType type;
+        std::size_t line;
+        std::size_t column;
+        std::variant<std::monostate, double, std::string> literal;
+    };
+
+    explicit BaselineScanner(std::string_view source)
+        : source_(source), start_(0), start_line_(0), start_column_(0),
+          current_(0), current_line_(1), current_column_(1), token_(), has_token_(false) { }
+
+    auto next_token() -> Token {
+        has_token_ = false;
+        while (is_not_end() && not has_token_) {
+            start_ = current_;
+            scan_token();
+        }
+        if (not has_token_) { add_token(TokenType::Eof); }
+        return std::move(token_);
+    }
+
+private:
+
+    void scan_token() {
+        start_line_ = current_line_;
+        start_column_ = current_column_;
+        char const c = advance();
+        switch (c) {
+        case '{': add_token(TokenType::LeftBrace);    break;
+        case '}': add_token(TokenType::RightBrace);   break;
+        case '[': add_token(TokenType::LeftBracket);  break;
+        case ']': add_token(TokenType::RightBracket); break;
+        case ',': add_token(TokenType::Comma);        break;
+        case ':': add_token(TokenType::Colon);        break;
+        case '"': scan_string();                      break;
+        case ' ': case '\n': case '\r': case '\t':    break;
+        default: {
+            if      (is_on_digit(c))   { scan_number(); }
+            else if (std::isalpha(c))  { scan_identifier(); }
+            break;
+        }
+        }
+    }
+
+    void scan_number() {
+        while (is_not_end() && is_on_digit(peek())) { advance(); }
+        auto const sv = source_.substr(start_, current_ - start_);
+        double number = 0;
+        std::from_chars(sv.data(), sv.data() + sv.size(), number);
+        add_token(TokenType::Number, number);
+    }
+
+    void scan_string() {
+        std::stringstream ss;
+        while (is_not_end()) {
+            char const c = advance();
+            if      (c == '"')  { break; }
+            else if (c == '\\') { ss << advance(); }
+            else                { ss << c; }
+        }
+        add_token(TokenType::String, ss.str());
+    }
+
+    void scan_identifier() {
+        while (is_not_end() && std::isalpha(peek())) { advance(); }
+        auto const iden = source_.substr(start_, current_ - start_);
+        if      (iden == "null") { add_token(TokenType::Null); }
+        else if (iden == "true") { add_token(TokenType::True); }
+        else                     { add_token(TokenType::False); }
+    }
+
+    [[nodiscard]] static auto is_on_digit(char const c) -> bool {
+        return std::isdigit(c) || std::tolower(c) == 'e' || c == '+' || c == '-' || c == '.';
+    }
+
+    [[nodiscard]] auto is_not_end() const -> bool {
+        return current_ < source_.size();
+    }
+
+    auto advance() -> char {
+        char const c = source_[current_++];
+        if (c == '\n') {
+            ++current_line_;
+            current_column_ = 1;
+        } else {
+            ++current_column_;
+        }
+        return c;
+    }
+
+    [[nodiscard]] auto peek() const -> char {
+        return source_[current_];
+    }
+
+    void add_token(TokenType type, std::variant<std::monostate, double, std::string> literal = {}) {
+        token_ = Token{ type, start_line_, start_column_, std::move(literal) };
+        has_token_ = true;
+    }
+
+private:
+
+    std::string_view source_;
+    std::size_t start_;
+    std::size_t start_line_;
+    std::size_t start_column_;
+    std::size_t current_;
+    std::size_t current_line_;
+    std::size_t current_column_;
+    Token token_;
+    bool has_token_;
+};
+
+int main() {
+    auto const source = make_pretty_log(100'000);
+    std::printf("pretty-printed log: %zu bytes\n", source.size());
+
+    auto const baseline_seconds = bench::time_per_run([&] {
+        BaselineScanner scanner(source);
+        std::size_t count = 0;
+        while (scanner.next_token().type != TokenType::Eof) { ++count; }
+        bench::do_not_optimize(count);
+    });
+    bench::report("scan   byte by byte, before the index", source.size(), baseline_seconds);
+
+    for (auto const set : { InstructionSet::Scalar, InstructionSet::Sse42, InstructionSet::Avx2 }) {
+        if (not is_supported(set)) { continue; }
+
+        auto const index_seconds = bench::time_per_run([&] {
+            StructuralIndexer indexer(source, set);
+            std::size_t count = 0;
+            while (indexer.next() != source.size()) { ++count; }
+            bench::do_not_optimize(count);
+        });
+        bench::report((std::string("index  ") + to_string(set)).c_str(), source.size(), index_seconds);
+
+        auto const scan_seconds = bench::time_per_run([&] {
+            Scanner scanner(source, set);
+            std::size_t count = 0;
+            while (scanner.next_token().type != TokenType::Eof) { ++count; }
+            bench::do_not_optimize(count);
+        });
+        bench::report((std::string("scan   ") + to_string(set)).c_str(), source.size(), scan_seconds);
+    }
+}
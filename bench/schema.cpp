@@ -0,0 +1,103 @@
+#include "bench.h"
+#include "corpus.h"
+#include "json_parser/core.h"
+#include <string>
+
+using namespace json;
+
+// the documents of the tweets corpus, see corpus.h, as a schema
+constexpr char const* timeline_schema = R"({
+    "type": "object",
+    "required": ["statuses", "search_metadata"],
+    "properties": {
+        "statuses": {
+            "type": "array",
+            "items": {
+                "type": "object",
+                "required": ["id", "id_str", "text", "user", "lang"],
+                "properties": {
+                    "id": { "type": "integer", "minimum": 0 },
+                    "id_str": { "type": "string", "pattern": "^[0-9]+$" },
+                    "created_at": { "type": "string" },
+                    "text": { "type": "string", "maxLength": 280 },
+                    "truncated": { "type": "boolean" },
+                    "in_reply_to_status_id": { "type": ["integer", "null"] },
+                    "user": {
+                        "type": "object",
+                        "required": ["id", "screen_name"],
+                        "properties": {
+                            "id": { "type": "integer" },
+                            "name": { "type": "string" },
+                            "screen_name": { "type": "string", "minLength": 1 },
+                            "followers_count": { "type": "integer", "minimum": 0 },
+                            "verified": { "type": "boolean" }
+                        },
+                        "additionalProperties": false
+                    },
+                    "entities": {
+                        "type": "object",
+                        "properties": {
+                            "hashtags": { "type": "array", "items": { "type": "object" } },
+                            "urls": { "type": "array", "items": { "type": "string" } }
+                        }
+                    },
+                    "retweet_count": { "type": "integer", "minimum": 0 },
+                    "favorite_count": { "type": "integer", "minimum": 0 },
+                    "lang": { "enum": ["en", "fr", "de", "es", "ja", "pt"] }
+                }
+            }
+        },
+        "search_metadata": { "type": "object" }
+    }
+})";
+
+int main() {
+    auto const corpus = bench::make_corpus(bench::Shape::Tweets, 4 * 1024 * 1024, 42);
+    std::printf("%s: %zu documents, %zu bytes\n", corpus.name, corpus.documents.size(), corpus.bytes);
+
+    auto const schema = JsonSchema::compile(parse_string(timeline_schema));
+    for (auto const& document : corpus.documents) {
+        if (not schema.validate(std::string_view(document)).empty()) {
+            std::printf("the corpus does not match the schema: %s\n",
+                        schema.validate(std::string_view(document)).front().message.c_str());
+            return 1;
+        }
+    }
+
+    auto const parse_seconds = bench::time_per_run([&] {
+        for (auto const& document : corpus.documents) {
+            bench::do_not_optimize(schema.validate(parse_string(document)));
+        }
+    });
+    bench::report("parse_string, then validate", corpus.bytes, parse_seconds);
+
+    auto const document_seconds = bench::time_per_run([&] {
+        for (auto const& document : corpus.documents) {
+            bench::do_not_optimize(schema.validate(parse_document(document).root()));
+        }
+    });
+    bench::report("parse_document, then validate", corpus.bytes, document_seconds);
+
+    auto const fused_seconds = bench::time_per_run([&] {
+        for (auto const& document : corpus.documents) {
+            bench::do_not_optimize(schema.validate(std::string_view(document)));
+        }
+    });
+    bench::report("validate while parsing", corpus.bytes, fused_seconds);
+
+    // an invalid first status: the fused validation stops right there
+    auto const rejected = [&] {
+        auto documents = corpus.documents;
+        for (auto& document : documents) {
+            auto const at = document.find("\"lang\":\"");
+            if (at != std::string::npos) { document.replace(at + 8, 2, "xx"); }
+        }
+        return documents;
+    }();
+    auto const reject_seconds = bench::time_per_run([&] {
+        for (auto const& document : rejected) {
+            bench::do_not_optimize(schema.is_valid(std::string_view(document)));
+        }
+    });
+    bench::report("is_valid, invalid first status", corpus.bytes, reject_seconds);
+}
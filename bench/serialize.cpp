@@ -0,0 +1,87 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <string>
+
+using namespace json;
+
+// Json::to_string as it was before the serializer, through the public
+// accessors. Like the original it cannot handle empty containers
+static auto legacy_to_string(Json const& json) -> std::string {
+    auto const enclose = [](std::string str, std::string beg, std::string end) {
+        return std::move(beg) + std::move(str) + std::move(end);
+    };
+    auto const separate_by_space = [](std::string a, std::string b) {
+        return std::move(a) + ", " + std::move(b);
+    };
+    auto const object_elem_ts = [&](Json::object_elem_t const& elem) {
+        return enclose(std::string(elem.first), "\"", "\"") + ": " + legacy_to_string(elem.second);
+    };
+
+    switch (json.type()) {
+    case Type::Null:    return "null";
+    case Type::Boolean: return json.boolean() ? "true" : "false";
+    case Type::Number: {
+        std::stringstream ss;
+        ss << json.number();
+        return ss.str();
+    }
+    case Type::String: return enclose(std::string(json.string()), "\"", "\"");
+    case Type::Array: {
+        auto const& v = json.array();
+        auto s = std::transform_reduce(std::next(v.begin()), v.end(),
+            legacy_to_string(*v.begin()), separate_by_space, legacy_to_string);
+        return enclose(std::move(s), "[ ", " ]");
+    }
+    case Type::Object: {
+        auto const& v = json.object();
+        auto s = std::transform_reduce(std::next(v.begin()), v.end(),
+            object_elem_ts(*v.begin()), separate_by_space, object_elem_ts);
+        return enclose(std::move(s), "{ ", " }");
+    }
+    }
+    return "";
+}
+
+int main() {
+    auto const json = parse_string(bench::make_records(50'000));
+
+    auto legacy_size = std::size_t{0};
+    auto const legacy_seconds = bench::time_per_run([&] {
+        auto const text = legacy_to_string(json);
+        legacy_size = text.size();
+        bench::do_not_optimize(text);
+    });
+    bench::report("legacy to_string", legacy_size, legacy_seconds);
+
+    auto compact_size = std::size_t{0};
+    auto const compact_seconds = bench::time_per_run([&] {
+        auto const text = serialize(json);
+        compact_size = text.size();
+        bench::do_not_optimize(text);
+    });
+    bench::report("serialize, compact", compact_size, compact_seconds);
+
+    auto pretty = SerializeOptions{};
+    pretty.indent = 2;
+    auto pretty_size = std::size_t{0};
+    auto const pretty_seconds = bench::time_per_run([&] {
+        auto const text = serialize(json, pretty);
+        pretty_size = text.size();
+        bench::do_not_optimize(text);
+    });
+    bench::report("serialize, indent 2", pretty_size, pretty_seconds);
+
+    if (auto* const null_file = std::fopen("/dev/null", "wb")) {
+        auto const file_seconds = bench::time_per_run([&] {
+            auto writer = Writer(null_file);
+            serialize(json, writer);
+            writer.flush();
+        });
+        bench::report("serialize, compact to FILE*", compact_size, file_seconds);
+        std::fclose(null_file);
+    }
+}
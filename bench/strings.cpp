@@ -0,0 +1,59 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include "json_parser/detail/Utf8.h"
+#include <random>
+#include <string>
+
+using namespace json;
+
+// an array of strings, mostly multilingual text or mostly escape sequences
+static auto make_strings(std::size_t count, bool escaped) -> std::string {
+    // Latin, Greek, CJK and an emoji: one to four bytes per character
+    static char const* const words[] = {
+        "caf\xc3\xa9", "\xce\xb1\xce\xbb\xcf\x86\xce\xb1", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e",
+        "stra\xc3\x9f" "e", "\xf0\x9f\x98\x80", "plain", "\xd0\xbc\xd0\xb8\xd1\x80",
+    };
+    static char const* const escapes[] = {
+        "\\n", "\\\"", "\\\\", "\\u00e9", "\\u20AC", "\\uD83D\\uDE00", "\\t", "\\/",
+    };
+    auto random = std::mt19937(11);
+    auto out = std::string("[");
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i != 0) { out += ','; }
+        out += '"';
+        for (auto j = 0; j < 12; ++j) {
+            if (j != 0) { out += ' '; }
+            out += escaped ? escapes[random() % std::size(escapes)] : words[random() % std::size(words)];
+        }
+        out += '"';
+    }
+    return out + "]";
+}
+
+int main() {
+    for (auto const escaped : { false, true }) {
+        auto const source = make_strings(50'000, escaped);
+        std::printf("%s: %zu bytes\n", escaped ? "escape-heavy strings" : "multilingual strings", source.size());
+
+        for (auto const set : { InstructionSet::Scalar, InstructionSet::Sse42, InstructionSet::Avx2 }) {
+            if (not is_supported(set)) { continue; }
+            auto const seconds = bench::time_per_run([&] {
+                bench::do_not_optimize(find_invalid_utf8(source, set));
+            });
+            bench::report((std::string("find_invalid_utf8 ") + to_string(set)).c_str(), source.size(), seconds);
+        }
+
+        auto const scan_seconds = bench::time_per_run([&] {
+            auto scanner = Scanner(source);
+            std::size_t count = 0;
+            while (scanner.next_token().type != TokenType::Eof) { ++count; }
+            bench::do_not_optimize(count);
+        });
+        bench::report("Scanner", source.size(), scan_seconds);
+
+        auto const parse_seconds = bench::time_per_run([&] {
+            bench::do_not_optimize(parse_document(source));
+        });
+        bench::report("parse_document", source.size(), parse_seconds);
+    }
+}
@@ -0,0 +1,213 @@
+#include "bench.h"
+#include "corpus.h"
+#include "json_parser/core.h"
+#include "counting_new.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+json_parser_bench: every phase of the library on generated corpora.
+
+    json_parser_bench [--json] [--min-time=SECONDS] [--size=BYTES]
+                      [--corpus=NAME] [--label=TEXT]
+
+Each corpus is measured in five phases: scan (tokens only), parse (into a
+Json), reuse (parse into a ParserContext), serialize (compact) and destroy
+(the parsed trees). Throughput is in
+MB/s of source and documents/s; allocations are the calls of the global
+operator new per document. --json prints the same results as one JSON
+document, tagged with --label (a commit hash, say) so runs can be diffed.
+The corpora only depend on the generator, not on the platform.
+*/
+
+using namespace json;
+
+namespace {
+
+struct Options {
+    bool json = false;
+    double min_seconds = 0.5;
+    std::size_t corpus_bytes = 4 * 1024 * 1024;
+    std::string corpus;
+    std::string label;
+};
+
+// One phase over one corpus, totals of all its passes
+struct Measurement {
+    double seconds = 0;
+    std::size_t allocations = 0;
+    std::size_t passes = 0;
+};
+
+struct Result {
+    char const* corpus;
+    char const* phase;
+    std::size_t bytes;          // source bytes of the corpus
+    std::size_t documents;
+    Measurement measurement;
+
+    [[nodiscard]] auto seconds_per_pass() const -> double {
+        return measurement.seconds / static_cast<double>(measurement.passes);
+    }
+    [[nodiscard]] auto mb_per_s() const -> double {
+        return static_cast<double>(bytes) / seconds_per_pass() / (1024.0 * 1024.0);
+    }
+    [[nodiscard]] auto documents_per_s() const -> double {
+        return static_cast<double>(documents) / seconds_per_pass();
+    }
+    [[nodiscard]] auto allocations_per_document() const -> double {
+        return static_cast<double>(measurement.allocations)
+             / static_cast<double>(measurement.passes * documents);
+    }
+};
+
+auto parse_options(int argc, char** argv) -> Options {
+    auto options = Options{};
+    for (auto i = 1; i < argc; ++i) {
+        auto const argument = std::string_view(argv[i]);
+        auto const equals = argument.find('=');
+        auto const name = argument.substr(0, equals);
+        auto const value = std::string(equals == std::string_view::npos ? "" : argument.substr(equals + 1));
+
+        if (name == "--json" && equals == std::string_view::npos) {
+            options.json = true;
+        } else if (name == "--min-time" && not value.empty()) {
+            options.min_seconds = std::strtod(value.c_str(), nullptr);
+        } else if (name == "--size" && not value.empty()) {
+            options.corpus_bytes = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (name == "--corpus" && not value.empty()) {
+            options.corpus = value;
+        } else if (name == "--label") {
+            options.label = value;
+        } else {
+            std::fprintf(stderr, "usage: %s [--json] [--min-time=SECONDS] [--size=BYTES] "
+                                 "[--corpus=NAME] [--label=TEXT]\n", argv[0]);
+            std::exit(2);
+        }
+    }
+    return options;
+}
+
+// Runs `pass` until `min_seconds` were spent in it
+template <typename Pass>
+auto measure(double min_seconds, Pass&& pass) -> Measurement {
+    using clock = std::chrono::steady_clock;
+    auto measurement = Measurement{};
+    do {
+        auto const allocated = heap_allocations();
+        auto const start = clock::now();
+        pass();
+        measurement.seconds += std::chrono::duration<double>(clock::now() - start).count();
+        measurement.allocations += heap_allocations() - allocated;
+        ++measurement.passes;
+    } while (measurement.seconds < min_seconds);
+    return measurement;
+}
+
+auto run(bench::Corpus const& corpus, double min_seconds) -> std::vector<Result> {
+    auto const& documents = corpus.documents;
+    auto results = std::vector<Result>{};
+    auto const add = [&](char const* phase, Measurement measurement) {
+        results.push_back({ corpus.name, phase, corpus.bytes, documents.size(), measurement });
+    };
+
+    add("scan", measure(min_seconds, [&] {
+        std::size_t tokens = 0;
+        for (auto const& document : documents) {
+            auto scanner = Scanner(document);
+            while (scanner.next_token().type != TokenType::Eof) { ++tokens; }
+        }
+        bench::do_not_optimize(tokens);
+    }));
+
+    // parse and destroy alternate, so each destroy pass has fresh trees
+    auto parsed = std::vector<Json>{};
+    parsed.reserve(documents.size());
+    auto parse = Measurement{};
+    auto destroy = Measurement{};
+    do {
+        auto const parse_pass = measure(0, [&] {
+            for (auto const& document : documents) { parsed.push_back(parse_string(document)); }
+        });
+        auto const destroy_pass = measure(0, [&] { parsed.clear(); });
+        parse.seconds += parse_pass.seconds;
+        parse.allocations += parse_pass.allocations;
+        destroy.seconds += destroy_pass.seconds;
+        destroy.allocations += destroy_pass.allocations;
+        ++parse.passes;
+        ++destroy.passes;
+    } while (parse.seconds < min_seconds);
+    add("parse", parse);
+
+    // the same with a ParserContext, its result dropped by the next parse
+    auto context = ParserContext{};
+    add("reuse", measure(min_seconds, [&] {
+        std::size_t size = 0;
+        for (auto const& document : documents) { size += context.parse(document).is_object() ? 1u : 0u; }
+        bench::do_not_optimize(size);
+    }));
+
+    for (auto const& document : documents) { parsed.push_back(parse_string(document)); }
+    add("serialize", measure(min_seconds, [&] {
+        std::size_t size = 0;
+        for (auto const& json : parsed) { size += serialize(json).size(); }
+        bench::do_not_optimize(size);
+    }));
+    add("destroy", destroy);
+    return results;
+}
+
+void print_table(std::vector<Result> const& results) {
+    std::printf("%-12s %-10s %12s %14s %14s\n", "corpus", "phase", "MB/s", "documents/s", "allocs/doc");
+    for (auto const& result : results) {
+        std::printf("%-12s %-10s %12.1f %14.1f %14.1f\n", result.corpus, result.phase,
+                    result.mb_per_s(), result.documents_per_s(), result.allocations_per_document());
+    }
+}
+
+void print_json(std::vector<Result> const& results, Options const& options) {
+    auto list = Json::array_t{};
+    for (auto const& result : results) {
+        auto entry = Json{ Json::object_t{} };
+        auto& object = entry.object();
+        object["corpus"] = Json{ result.corpus };
+        object["phase"] = Json{ result.phase };
+        object["bytes"] = Json(result.bytes);
+        object["documents"] = Json(result.documents);
+        object["passes"] = Json(result.measurement.passes);
+        object["seconds_per_pass"] = Json{ result.seconds_per_pass() };
+        object["mb_per_s"] = Json{ result.mb_per_s() };
+        object["documents_per_s"] = Json{ result.documents_per_s() };
+        object["allocations_per_document"] = Json{ result.allocations_per_document() };
+        list.push_back(std::move(entry));
+    }
+
+    auto report = Json{ Json::object_t{} };
+    report.object()["label"] = Json{ std::string_view(options.label) };
+    report.object()["min_seconds"] = Json{ options.min_seconds };
+    report.object()["results"] = Json{ std::move(list) };
+    std::printf("%s\n", serialize(report, { 2 }).c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto const options = parse_options(argc, argv);
+
+    auto results = std::vector<Result>{};
+    for (auto const shape : { bench::Shape::Tweets, bench::Shape::Numbers, bench::Shape::Logs,
+                              bench::Shape::Deep, bench::Shape::FlatObject }) {
+        if (not options.corpus.empty() && options.corpus != bench::to_string(shape)) { continue; }
+        auto const corpus = bench::make_corpus(shape, options.corpus_bytes);
+        auto corpus_results = run(corpus, options.min_seconds);
+        results.insert(results.end(), corpus_results.begin(), corpus_results.end());
+    }
+
+    if (options.json) { print_json(results, options); }
+    else              { print_table(results); }
+}
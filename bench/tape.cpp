@@ -0,0 +1,55 @@
+#include "bench.h"
+#include "json_parser/core.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace json;
+
+int main() {
+    auto const directory = std::filesystem::temp_directory_path();
+    auto const json_path = (directory / "json_parser_bench_tape.json").string();
+    auto const tape_path = (directory / "json_parser_bench_tape.tape").string();
+
+    auto const size = [&] {
+        auto const source = bench::make_records(200'000);
+        std::ofstream(json_path, std::ios::binary) << source;
+        save_tape(parse_string(source), tape_path);
+        return source.size();
+    }();
+    std::printf("records: %zu bytes of JSON, %ju bytes of tape, served from the page cache\n",
+                size, std::filesystem::file_size(tape_path));
+
+    // startup: open the data and read one record
+    auto const parse_seconds = bench::time_per_run([&] {
+        auto const doc = parse_file(json_path);
+        bench::do_not_optimize(doc.root().array()[123'456].object().at("name").string());
+    });
+    bench::report("parse_file + 1 lookup", size, parse_seconds);
+
+    auto const load_seconds = bench::time_per_run([&] {
+        auto const doc = load_tape(tape_path);
+        bench::do_not_optimize(doc.root().array()[123'456].object().at("name").string());
+    });
+    bench::report("load_tape + 1 lookup", size, load_seconds);
+
+    // a full pass over the data once loaded
+    auto const tape = load_tape(tape_path);
+    auto const scan_seconds = bench::time_per_run([&] {
+        auto total = 0.0;
+        for (auto const record : tape.root().array()) {
+            total += record.object().at("profile").object().at("age").number();
+        }
+        bench::do_not_optimize(total);
+    });
+    bench::report("tape, read every record", size, scan_seconds);
+
+    auto const encode_seconds = bench::time_per_run([&] {
+        save_tape(tape.root().to_json(), tape_path);
+    });
+    bench::report("to_json + save_tape", size, encode_seconds);
+
+    std::filesystem::remove(json_path);
+    std::filesystem::remove(tape_path);
+}
@@ -0,0 +1,399 @@
+#pragma once
+
+#include "Serializer.h"
+#include "detail/Parser.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/*
+Binding of C++ types to JSON: values are read straight from the input into
+the type, without a Json in between, and written straight from it.
+
+Supported are bool, the arithmetic types, std::string, std::optional (null
+when empty), std::vector, std::map and std::unordered_map with std::string
+keys, and structs whose members are listed with JSON_PARSER_BIND in the
+namespace of the struct:
+
+    struct User {
+        std::string name;
+        std::int64_t followers = 0;
+        std::optional<std::string> location;
+    };
+    JSON_PARSER_BIND(User, name, followers, location)
+
+    auto user = json::parse_bound<User>(R"({"name": "ada", "followers": 3})");
+    auto text = json::serialize_bound(user);
+
+Members are read from the keys of the same name. Unknown keys are skipped
+(their value is still checked to be valid JSON) and missing ones keep their
+default value. A key repeated in an object is an error, like in parse_string,
+in structs, maps and skipped values alike. Keys are matched by comparisons generated for the listed
+names, the member after the last matched one first: documents written by
+serialize_bound, or by anything else with a fixed member order, find every
+key with one comparison.
+
+Syntax errors and values of the wrong type throw a JsonException, like
+parse_string.
+*/
+
+namespace json {
+
+// A member of a bound struct, see JSON_PARSER_BIND
+template <typename Class, typename T>
+struct BoundField {
+    std::string_view name;
+    T Class::* member;
+};
+
+template <typename Class, typename T>
+constexpr auto bound_field(std::string_view name, T Class::* member) noexcept -> BoundField<Class, T> {
+    return { name, member };
+}
+
+// Argument of the json_binding functions JSON_PARSER_BIND defines, looked up
+// by argument-dependent lookup in the namespace of T
+template <typename T>
+struct binding_tag { };
+
+template <typename T, typename = void>
+struct is_bound : std::false_type { };
+
+template <typename T>
+struct is_bound<T, std::void_t<decltype(json_binding(binding_tag<T>{}))>> : std::true_type { };
+
+template <typename T>
+constexpr bool is_bound_v = is_bound<T>::value;
+
+// The tuple of BoundField of a bound struct, a compile-time constant
+template <typename T>
+struct bound_fields {
+    static constexpr auto value = json_binding(binding_tag<T>{});
+    static constexpr auto size = std::tuple_size_v<std::remove_const_t<decltype(value)>>;
+};
+
+// Token level reading for parse_bound: every function consumes one piece of
+// the grammar or throws the same parse errors as Parser
+class BindingReader : public ParserBase {
+public:
+
+    explicit BindingReader(std::string_view source);
+
+    // throws unless the whole input has been read
+    void finish();
+
+    [[nodiscard]] auto read_null() -> bool;     // consumes a null if it is next
+    [[nodiscard]] auto read_bool() -> bool;
+    [[nodiscard]] auto read_number() -> Number;
+    // valid until the next string is read
+    [[nodiscard]] auto read_string() -> std::string_view;
+
+    // Arrays and objects: open them, then read values until the end
+    //     reader.begin_array();
+    //     if (not reader.end_array()) { do { read value } while (reader.next_element()); }
+    void begin_array();
+    [[nodiscard]] auto end_array() -> bool;     // consumes "]" if it is next
+    [[nodiscard]] auto next_element() -> bool;  // consumes "," or "]"
+    void begin_object();
+    [[nodiscard]] auto end_object() -> bool;
+    // the key and its colon, the key is valid until the next string is read
+    [[nodiscard]] auto read_key() -> std::string_view;
+    [[nodiscard]] auto next_member() -> bool;
+    // throws the error of parse_string for `key`, the key just read, when it
+    // was already in the object
+    void duplicate_key(std::string_view key) const;
+
+    // reads and discards any value
+    void skip_value();
+
+private:
+
+    Token key_;     // the last key read, where duplicate_key() points
+};
+
+namespace detail {
+
+template <typename T>
+struct is_optional : std::false_type { };
+template <typename T>
+struct is_optional<std::optional<T>> : std::true_type { };
+
+template <typename T>
+struct is_vector : std::false_type { };
+template <typename T, typename Allocator>
+struct is_vector<std::vector<T, Allocator>> : std::true_type { };
+
+template <typename T>
+struct is_string_map : std::false_type { };
+template <typename T, typename Compare, typename Allocator>
+struct is_string_map<std::map<std::string, T, Compare, Allocator>> : std::true_type { };
+template <typename T, typename Hash, typename Equal, typename Allocator>
+struct is_string_map<std::unordered_map<std::string, T, Hash, Equal, Allocator>> : std::true_type { };
+
+template <typename T>
+constexpr bool always_false = false;
+
+} // namespace detail
+
+template <typename T>
+void read_bound(BindingReader& reader, T& value);
+
+namespace detail {
+
+template <typename Int>
+void read_integer(BindingReader& reader, Int& value) {
+    auto const number = reader.read_number();
+    if constexpr (std::is_signed_v<Int>) {
+        auto integer = std::int64_t{};
+        if (number.to_int64(integer)) {
+            if constexpr (std::is_same_v<Int, std::int64_t>) {
+                value = integer;
+                return;
+            } else if (std::numeric_limits<Int>::min() <= integer && integer <= std::numeric_limits<Int>::max()) {
+                value = static_cast<Int>(integer);
+                return;
+            }
+        }
+    } else {
+        auto integer = std::uint64_t{};
+        if (number.to_uint64(integer)) {
+            if constexpr (std::is_same_v<Int, std::uint64_t>) {
+                value = integer;
+                return;
+            } else if (integer <= std::numeric_limits<Int>::max()) {
+                value = static_cast<Int>(integer);
+                return;
+            }
+        }
+    }
+    reader.fail("Expected an integer in the range of the member type");
+}
+
+// Reads the value of `key` into its member. Tries the member after the last
+// matched one before comparing the key against every name. `seen` has a bit
+// per member read and `unknown` the keys skipped so far, to reject duplicates
+template <typename T, std::size_t... I>
+void read_member(BindingReader& reader, T& value, std::string_view key, std::size_t& expected,
+                 std::uint32_t& seen, std::unordered_set<std::string>& unknown, std::index_sequence<I...>) {
+    constexpr auto& fields = bound_fields<T>::value;
+    auto const read_if = [&](auto const& field, std::size_t index) {
+        if (field.name != key) { return false; }
+        auto const bit = std::uint32_t{1} << index;
+        if ((seen & bit) != 0) { reader.duplicate_key(key); }
+        seen |= bit;
+        read_bound(reader, value.*field.member);
+        expected = index + 1;
+        return true;
+    };
+    auto const found = ((expected == I && read_if(std::get<I>(fields), I)) || ...)
+                    || ((expected != I && read_if(std::get<I>(fields), I)) || ...);
+    if (not found) {
+        if (not unknown.emplace(key).second) { reader.duplicate_key(key); }
+        reader.skip_value();
+    }
+}
+
+template <typename T, std::size_t... I>
+void write_members(T const& value, Writer& writer, std::index_sequence<I...>);
+
+} // namespace detail
+
+// Reads one value of type T, see the top of this file for the types
+template <typename T>
+void read_bound(BindingReader& reader, T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        value = reader.read_bool();
+    } else if constexpr (std::is_integral_v<T>) {
+        detail::read_integer(reader, value);
+    } else if constexpr (std::is_same_v<T, double>) {
+        value = reader.read_number().to_double();
+    } else if constexpr (std::is_floating_point_v<T>) {
+        value = static_cast<T>(reader.read_number().to_double());
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        value.assign(reader.read_string());
+    } else if constexpr (detail::is_optional<T>::value) {
+        if (reader.read_null()) {
+            value.reset();
+        } else {
+            read_bound(reader, value.emplace());
+        }
+    } else if constexpr (detail::is_vector<T>::value) {
+        value.clear();
+        reader.begin_array();
+        if (reader.end_array()) { return; }
+        do {
+            read_bound(reader, value.emplace_back());
+        } while (reader.next_element());
+    } else if constexpr (detail::is_string_map<T>::value) {
+        value.clear();
+        reader.begin_object();
+        if (reader.end_object()) { return; }
+        do {
+            auto const [it, inserted] = value.try_emplace(std::string(reader.read_key()));
+            if (not inserted) { reader.duplicate_key(it->first); }
+            read_bound(reader, it->second);
+        } while (reader.next_member());
+    } else if constexpr (is_bound_v<T>) {
+        reader.begin_object();
+        if (reader.end_object()) { return; }
+        auto expected = std::size_t{0};
+        auto seen = std::uint32_t{0};
+        auto unknown = std::unordered_set<std::string>{};
+        do {
+            auto const key = reader.read_key();
+            detail::read_member(reader, value, key, expected, seen, unknown,
+                                std::make_index_sequence<bound_fields<T>::size>{});
+        } while (reader.next_member());
+    } else {
+        static_assert(detail::always_false<T>, "T cannot be read from JSON, see Binding.h");
+    }
+}
+
+// Writes `value` as compact JSON, see the top of this file for the types
+template <typename T>
+void write_bound(T const& value, Writer& writer) {
+    if constexpr (std::is_same_v<T, bool>) {
+        writer.write(value ? "true" : "false");
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        write_number(Number::from(std::int64_t{value}), writer);
+    } else if constexpr (std::is_integral_v<T>) {
+        write_number(Number::from(std::uint64_t{value}), writer);
+    } else if constexpr (std::is_floating_point_v<T>) {
+        write_number(Number::from(double{value}), writer);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        write_string(value, writer);
+    } else if constexpr (detail::is_optional<T>::value) {
+        if (value) { write_bound(*value, writer); }
+        else       { writer.write("null"); }
+    } else if constexpr (detail::is_vector<T>::value) {
+        writer.put('[');
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            if (it != value.begin()) { writer.put(','); }
+            write_bound(*it, writer);
+            writer.maybe_flush();
+        }
+        writer.put(']');
+    } else if constexpr (detail::is_string_map<T>::value) {
+        writer.put('{');
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            if (it != value.begin()) { writer.put(','); }
+            write_string(it->first, writer);
+            writer.put(':');
+            write_bound(it->second, writer);
+            writer.maybe_flush();
+        }
+        writer.put('}');
+    } else if constexpr (is_bound_v<T>) {
+        writer.put('{');
+        detail::write_members(value, writer, std::make_index_sequence<bound_fields<T>::size>{});
+        writer.put('}');
+    } else {
+        static_assert(detail::always_false<T>, "T cannot be written as JSON, see Binding.h");
+    }
+}
+
+template <typename T, std::size_t... I>
+void detail::write_members(T const& value, Writer& writer, std::index_sequence<I...>) {
+    constexpr auto& fields = bound_fields<T>::value;
+    auto const write_member = [&](auto const& field, std::size_t index) {
+        if (index != 0) { writer.put(','); }
+        write_string(field.name, writer);
+        writer.put(':');
+        write_bound(value.*field.member, writer);
+    };
+    (write_member(std::get<I>(fields), I), ...);
+}
+
+// Parses `source` into `value`, replacing what the input sets
+template <typename T>
+void parse_bound(std::string_view source, T& value) {
+    auto reader = BindingReader(source);
+    read_bound(reader, value);
+    reader.finish();
+}
+
+template <typename T>
+[[nodiscard]] auto parse_bound(std::string_view source) -> T {
+    auto value = T{};
+    parse_bound(source, value);
+    return value;
+}
+
+template <typename T>
+void serialize_bound(T const& value, Writer& writer) {
+    write_bound(value, writer);
+}
+
+template <typename T>
+[[nodiscard]] auto serialize_bound(T const& value) -> std::string {
+    auto out = std::string{};
+    {
+        auto writer = Writer(out);
+        write_bound(value, writer);
+    }
+    return out;
+}
+
+} // namespace json
+
+// Lists the members of `Type` read and written by parse_bound and
+// serialize_bound, at most 32. Must be used in the namespace of `Type`
+#define JSON_PARSER_BIND(Type, ...)                                                     \
+    [[maybe_unused]] constexpr auto json_binding(::json::binding_tag<Type>) noexcept {  \
+        return ::std::make_tuple(JSON_PARSER_FOR_EACH(JSON_PARSER_BOUND_FIELD, Type, __VA_ARGS__)); \
+    }
+
+#define JSON_PARSER_BOUND_FIELD(Type, member) ::json::bound_field(#member, &Type::member)
+
+// the preprocessor loop over the members, one macro per count
+#define JSON_PARSER_EXPAND(x) x
+#define JSON_PARSER_FE_1(M, T, x) M(T, x)
+#define JSON_PARSER_FE_2(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_1(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_3(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_2(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_4(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_3(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_5(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_4(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_6(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_5(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_7(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_6(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_8(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_7(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_9(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_8(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_10(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_9(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_11(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_10(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_12(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_11(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_13(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_12(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_14(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_13(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_15(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_14(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_16(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_15(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_17(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_16(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_18(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_17(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_19(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_18(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_20(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_19(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_21(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_20(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_22(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_21(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_23(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_22(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_24(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_23(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_25(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_24(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_26(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_25(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_27(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_26(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_28(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_27(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_29(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_28(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_30(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_29(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_31(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_30(M, T, __VA_ARGS__))
+#define JSON_PARSER_FE_32(M, T, x, ...) M(T, x), JSON_PARSER_EXPAND(JSON_PARSER_FE_31(M, T, __VA_ARGS__))
+#define JSON_PARSER_PICK_FE(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define JSON_PARSER_FOR_EACH(M, T, ...) \
+    JSON_PARSER_EXPAND(JSON_PARSER_PICK_FE(__VA_ARGS__, \
+        JSON_PARSER_FE_32, JSON_PARSER_FE_31, JSON_PARSER_FE_30, JSON_PARSER_FE_29, JSON_PARSER_FE_28, JSON_PARSER_FE_27, JSON_PARSER_FE_26, JSON_PARSER_FE_25, \
+        JSON_PARSER_FE_24, JSON_PARSER_FE_23, JSON_PARSER_FE_22, JSON_PARSER_FE_21, JSON_PARSER_FE_20, JSON_PARSER_FE_19, JSON_PARSER_FE_18, JSON_PARSER_FE_17, \
+        JSON_PARSER_FE_16, JSON_PARSER_FE_15, JSON_PARSER_FE_14, JSON_PARSER_FE_13, JSON_PARSER_FE_12, JSON_PARSER_FE_11, JSON_PARSER_FE_10, JSON_PARSER_FE_9, \
+        JSON_PARSER_FE_8, JSON_PARSER_FE_7, JSON_PARSER_FE_6, JSON_PARSER_FE_5, JSON_PARSER_FE_4, JSON_PARSER_FE_3, JSON_PARSER_FE_2, JSON_PARSER_FE_1, \
+    )(M, T, __VA_ARGS__))
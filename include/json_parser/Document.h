@@ -0,0 +1,43 @@
+#pragma once
+
+#include "JsonValue.h"
+#include <memory>
+#include <memory_resource>
+
+namespace json {
+
+/*
+A parsed Json tree whose nodes, keys and strings are all allocated from one
+monotonic arena owned by the document. Parsing does a handful of large
+allocations, and destroying the document frees the arena without walking the
+tree.
+
+The tree is read-only: anything inserted into it would not live in the arena.
+Copy root() into a Json to get a mutable, heap allocated tree.
+A moved-from Document may only be destroyed or assigned to.
+
+Strings of a document parsed in situ may borrow from its input, see
+parse_document_in_situ. The optional `input` is kept alive as long as the
+document is, so it can own the memory these strings reference.
+*/
+class Document {
+public:
+
+    using arena_t = std::pmr::monotonic_buffer_resource;
+
+    Document();
+    Document(std::unique_ptr<arena_t> arena, Json root,
+             std::shared_ptr<void const> input = nullptr);
+
+    [[nodiscard]] auto root() const noexcept -> Json const&;
+    [[nodiscard]] auto resource() const noexcept -> std::pmr::memory_resource*;
+
+private:
+
+    std::shared_ptr<void const> input_;
+    std::unique_ptr<arena_t> arena_;
+    // constructed in the arena and never destroyed, see the comment above
+    Json* root_;
+};
+
+} // namespace json
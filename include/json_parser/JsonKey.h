@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+
+namespace json {
+
+class KeyDictionary;
+
+// Handle of a key stored once in a KeyDictionary, see KeyDictionary.h.
+// A default constructed handle is null
+class InternedKey {
+public:
+
+    InternedKey() noexcept = default;
+
+    [[nodiscard]] auto view() const noexcept -> std::string_view { return { data_, size_ }; }
+    [[nodiscard]] auto dictionary() const noexcept -> KeyDictionary const* { return dictionary_; }
+    explicit operator bool() const noexcept { return data_ != nullptr; }
+
+    // Handles of one dictionary are equal exactly when their pointers are
+    friend auto operator==(InternedKey const& a, InternedKey const& b) noexcept -> bool {
+        if (a.data_ == b.data_) { return a.size_ == b.size_; }
+        if (a.dictionary_ == b.dictionary_) { return false; }
+        return a.view() == b.view();
+    }
+    friend auto operator!=(InternedKey const& a, InternedKey const& b) noexcept -> bool {
+        return not (a == b);
+    }
+
+private:
+
+    friend class KeyDictionary;
+    friend class JsonKey;
+
+    InternedKey(char const* data, std::size_t size, KeyDictionary const* dictionary) noexcept
+        : data_(data), size_(size), dictionary_(dictionary) { }
+
+private:
+
+    char const* data_ = nullptr;
+    std::size_t size_ = 0;
+    KeyDictionary const* dictionary_ = nullptr;
+};
+
+/*
+Key of a JsonObject member, one of
+- inline: up to inline_capacity bytes stored in the key itself
+- owned: allocated from the memory resource given at construction
+- interned: a handle into a KeyDictionary, nothing allocated, which must
+  outlive the key
+Keys take 24 bytes against 40 for a std::pmr::string. Two interned keys of
+the same dictionary compare by pointer.
+
+Allocator-aware like std::pmr::string, so containers using a polymorphic
+allocator hand it their memory resource.
+*/
+class JsonKey {
+public:
+
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    static constexpr std::size_t inline_capacity = 15;
+
+    JsonKey() noexcept;
+    explicit JsonKey(std::string_view text, allocator_type allocator = {});
+    explicit JsonKey(InternedKey key) noexcept;
+
+    JsonKey(JsonKey const& other);
+    JsonKey(JsonKey const& other, allocator_type allocator);
+    JsonKey(JsonKey&& other) noexcept;
+    JsonKey(JsonKey&& other, allocator_type allocator);
+    auto operator=(JsonKey const& other) -> JsonKey&;
+    auto operator=(JsonKey&& other) -> JsonKey&;
+    ~JsonKey();
+
+    [[nodiscard]] auto view() const noexcept -> std::string_view;
+    operator std::string_view() const noexcept { return view(); }
+    [[nodiscard]] auto data() const noexcept -> char const*;
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    // the resource of inline and owned keys, the default one for interned keys
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type;
+    [[nodiscard]] auto is_interned() const noexcept -> bool;
+    // null when the key is not interned
+    [[nodiscard]] auto handle() const noexcept -> InternedKey;
+
+    friend auto operator==(JsonKey const& a, JsonKey const& b) noexcept -> bool;
+    friend auto operator==(JsonKey const& a, std::string_view b) noexcept -> bool { return a.view() == b; }
+    friend auto operator==(std::string_view a, JsonKey const& b) noexcept -> bool { return a == b.view(); }
+    friend auto operator!=(JsonKey const& a, JsonKey const& b) noexcept -> bool { return not (a == b); }
+    friend auto operator!=(JsonKey const& a, std::string_view b) noexcept -> bool { return not (a == b); }
+    friend auto operator!=(std::string_view a, JsonKey const& b) noexcept -> bool { return not (a == b); }
+
+private:
+
+    enum class Storage : std::uint8_t {
+        Inline,
+        Owned,
+        Interned,
+    };
+
+    // the resource of owned and inline keys, the dictionary of interned ones
+    union Owner {
+        std::pmr::memory_resource* resource;
+        KeyDictionary const* dictionary;
+    };
+
+    // copies `other`, into resource() unless it is interned
+    void copy_from(JsonKey const& other);
+    // copies `text` inline or into resource()
+    void assign(std::string_view text);
+    void release() noexcept;
+    // leaves a moved-from key empty and inline
+    void reset() noexcept;
+
+    [[nodiscard]] auto storage() const noexcept -> Storage;
+    // interned keys have none, the default one is used once they are replaced
+    [[nodiscard]] auto resource() const noexcept -> std::pmr::memory_resource*;
+    void set_external(char const* data, std::size_t size, Storage storage) noexcept;
+
+private:
+
+    // inline: the bytes, then their count in the last byte.
+    // owned and interned: a pointer and a size, then the Storage in the last byte
+    alignas(8) unsigned char bytes_[16];
+    Owner owner_;
+};
+
+} // namespace json
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "JsonKey.h"
+#include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace json {
+
+class Json;
+
+/*
+Members of a Json object, kept contiguous and in insertion order.
+Small objects are searched linearly; once an object grows past
+index_threshold members an open-addressing hash index of member positions
+is built and maintained on insertion.
+
+Keys are JsonKey: short ones inline, interned ones (see KeyDictionary)
+compared by pointer when a member is inserted. Keys must not be modified
+through iterators, the index would go stale.
+*/
+class JsonObject {
+public:
+
+    using key_type       = JsonKey;
+    using value_type     = std::pair<key_type, Json>;
+    using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+    using container_t    = std::pmr::vector<value_type>;
+    using iterator       = container_t::iterator;
+    using const_iterator = container_t::const_iterator;
+    using size_type      = std::size_t;
+
+    static constexpr size_type index_threshold = 8;
+
+public:
+
+    JsonObject();
+    explicit JsonObject(allocator_type allocator);
+    JsonObject(std::initializer_list<value_type> list, allocator_type allocator = {});
+
+    [[nodiscard]] auto size()  const noexcept -> size_type;
+    [[nodiscard]] auto empty() const noexcept -> bool;
+    void reserve(size_type capacity);
+    void clear() noexcept;
+
+    [[nodiscard]] auto begin() noexcept -> iterator;
+    [[nodiscard]] auto end()   noexcept -> iterator;
+    [[nodiscard]] auto begin() const noexcept -> const_iterator;
+    [[nodiscard]] auto end()   const noexcept -> const_iterator;
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator;
+    [[nodiscard]] auto cend()   const noexcept -> const_iterator;
+
+    [[nodiscard]] auto find(std::string_view key) -> iterator;
+    [[nodiscard]] auto find(std::string_view key) const -> const_iterator;
+    [[nodiscard]] auto count(std::string_view key) const -> size_type;
+
+    // throw std::out_of_range when the key does not exist, like std::map
+    [[nodiscard]] auto at(std::string_view key) -> Json&;
+    [[nodiscard]] auto at(std::string_view key) const -> Json const&;
+
+    // inserts a null value when the key does not exist
+    auto operator[](std::string_view key) -> Json&;
+
+    // Neither argument is moved from when the key already exists
+    auto try_emplace(key_type&& key, Json&& value) -> std::pair<iterator, bool>;
+    auto insert(value_type member) -> std::pair<iterator, bool>;
+
+    // keeps the order of the remaining members
+    auto erase(std::string_view key) -> size_type;
+
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type;
+
+private:
+
+    // Key is std::string_view or key_type, whose equality is cheaper when both are interned
+    template <typename Key>
+    [[nodiscard]] auto find_position(Key const& key) const -> size_type;
+    void index_member(size_type position);
+    void rebuild_index();
+
+private:
+
+    container_t members_;
+    // slot = position + 1 of a member, 0 for an empty slot. Empty below index_threshold
+    std::pmr::vector<std::uint32_t> index_;
+};
+
+} // namespace json
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "JsonValue.h"
+#include "LazyDocument.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+// One step of a compiled JsonPath
+struct PathStep {
+    enum class Kind : std::uint8_t {
+        Member,     // an object member, or an array element when `key` is an index
+        Index,      // an array element, negative counts from the end
+        Wildcard,   // every member value or element
+        Slice,      // elements from `start` to `stop` by `step`, Python style
+    };
+
+    Kind kind;
+    std::string key;
+    // Member: key read as an array index, npos when it is not one
+    std::size_t key_index;
+    std::ptrdiff_t index;
+    std::optional<std::ptrdiff_t> start;
+    std::optional<std::ptrdiff_t> stop;
+    std::ptrdiff_t step;
+};
+
+/*
+A query compiled once and run against any number of documents, either a
+built Json or raw input through LazyValue, which skips everything off the
+path without parsing it.
+
+Two syntaxes compile to the same steps:
+- RFC 6901 JSON Pointer: "", "/users/0/name", "/a~1b" for the key "a/b"
+- a path language:       "$", "$.users[0].name", "$['a/b']", "$.users[*].id",
+                         "$.users[-1]", "$.users[1:10:2]"
+
+Running a query never throws on a missing member or a value of another type,
+it just does not match there. Syntax errors in raw input met on the path
+do throw, see LazyValue.
+*/
+class JsonPath {
+public:
+
+    // both throw a JsonException on a malformed expression
+    [[nodiscard]] static auto pointer(std::string_view pointer) -> JsonPath;
+    [[nodiscard]] static auto compile(std::string_view expression) -> JsonPath;
+
+    // the first match in document order, if any
+    [[nodiscard]] auto find(Json const& root) const -> Json const*;
+    [[nodiscard]] auto find(LazyValue root) const -> std::optional<LazyValue>;
+
+    // every match in document order
+    [[nodiscard]] auto select(Json const& root) const -> std::vector<Json const*>;
+    [[nodiscard]] auto select(LazyValue root) const -> std::vector<LazyValue>;
+
+    [[nodiscard]] auto steps() const noexcept -> std::vector<PathStep> const&;
+
+private:
+
+    explicit JsonPath(std::vector<PathStep> steps);
+
+private:
+
+    std::vector<PathStep> steps_;
+};
+
+} // namespace json
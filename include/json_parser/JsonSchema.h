@@ -0,0 +1,83 @@
+#pragma once
+
+#include "JsonValue.h"
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+struct SchemaProgram;
+
+// One failed check: where in the instance, which keyword, and why
+struct SchemaViolation {
+    // RFC 6901 JSON Pointer of the value, "" for the root, see JsonPath::pointer
+    std::string path;
+    char const* keyword;
+    std::string message;
+};
+
+struct ValidateOptions {
+    // validation, and parsing when validating raw input, stops once this
+    // many violations are found
+    std::size_t max_violations = std::numeric_limits<std::size_t>::max();
+};
+
+/*
+A JSON Schema compiled once into a program of checks and run against any
+number of instances, either a built Json or raw input, which is validated
+while it is parsed: no Json is built and parsing stops as soon as
+max_violations is reached.
+
+The supported subset of draft 2020-12:
+    true, false                     boolean schemas
+    type                            a type name or an array of them, "integer"
+                                    being a number with an integral value
+    enum                            values compared like JSON Schema does,
+                                    1 and 1.0 are equal, member order is not
+    properties, required
+    additionalProperties            a schema for the members not in properties
+    items                           a schema for every element
+    minimum, maximum, exclusiveMinimum, exclusiveMaximum
+    minLength, maxLength            in code points
+    pattern                         an ECMAScript regular expression, unanchored,
+                                    of the subset of detail/Regex.h
+    minItems, maxItems, minProperties, maxProperties
+Other keywords are ignored, like the annotations of the specification;
+$ref and the combinators (allOf, anyOf, ...) are not supported.
+
+Copies share the program, which is immutable: one schema can validate on
+any number of threads.
+*/
+class JsonSchema {
+public:
+
+    // throws a JsonException when `schema` is not a valid schema of the subset
+    [[nodiscard]] static auto compile(Json const& schema) -> JsonSchema;
+
+    // every violation in document order, none when `instance` is valid
+    [[nodiscard]] auto validate(Json const& instance, ValidateOptions options = {}) const
+        -> std::vector<SchemaViolation>;
+    // Same for the JSON text `source`, parsed while validating. Syntax errors and
+    // duplicate keys throw a JsonException like parse_string; anything up to
+    // them is validated
+    [[nodiscard]] auto validate(std::string_view source, ValidateOptions options = {}) const
+        -> std::vector<SchemaViolation>;
+
+    // stop at the first violation
+    [[nodiscard]] auto is_valid(Json const& instance) const -> bool;
+    [[nodiscard]] auto is_valid(std::string_view source) const -> bool;
+
+private:
+
+    explicit JsonSchema(std::shared_ptr<SchemaProgram const> program) noexcept;
+
+private:
+
+    std::shared_ptr<SchemaProgram const> program_;
+};
+
+} // namespace json
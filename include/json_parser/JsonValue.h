@@ -1,10 +1,17 @@
 #pragma once
 
-#include <variant>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <vector>
 #include <string>
-#include <map>
+#include <string_view>
+#include <memory_resource>
+#include <type_traits>
 #include "JsonException.h"
+#include "JsonObject.h"
+#include "detail/Number.h"
 
 namespace json {
 
@@ -17,6 +24,19 @@ enum class Type {
     Object,
 };
 
+[[nodiscard]] auto to_string(Type type) noexcept -> char const*;
+
+/*
+A JSON value in 16 bytes: a tag, and
+- null, booleans and numbers in the node itself
+- strings of up to inline_capacity bytes in the node itself
+- borrowed strings as a pointer and a size
+- longer strings, arrays and objects out of line, allocated from the memory
+  resource they were built with and referenced by pointer
+Arrays of numbers take 16 bytes an element, and moving a node never moves
+what it references, so references returned by array(), object() and the
+mutable string() stay valid when their Json is moved.
+*/
 class Json {
 public:
 
@@ -24,44 +44,79 @@ public:
     using null_t        = NullValue;
     using boolean_t     = bool;
     using number_t      = double;
-    using string_t      = std::string;
-    using array_t       = std::vector<Json>;
-    // Ideally we would want to use unordered_map but
-    // most STL implementation of
-    // unordered_map requires complete type and map does not
-    using object_t      = std::map<std::string, Json>;
+    // Integers are stored exactly, still with the Number type. number()
+    // reads any of them as a double, see integer() for exact access
+    using integer_t     = std::int64_t;
+    using unsigned_t    = std::uint64_t;
+    // Containers take a polymorphic allocator so a whole tree can live in one
+    // arena (see Document.h). Default-constructed ones use the heap as before
+    using string_t      = std::pmr::string;
+    using array_t       = std::pmr::vector<Json>;
+    // contiguous and insertion ordered, see JsonObject.h
+    using object_t      = JsonObject;
     using object_elem_t = typename object_t::value_type;
 
-    using value_t       =
-        std::variant<null_t, boolean_t, number_t, string_t, array_t, object_t>;
+    // A string referencing memory owned by someone else, see
+    // parse_document_in_situ. Copies of a Json always own their strings
+    struct BorrowedString { std::string_view view; };
+    using borrowed_string_t = BorrowedString;
+
+    static constexpr std::size_t inline_capacity = 14;
 
 public:
 
-    Json()
-        : type_(Type::Null), value_(null_t{}) { }
+    Json() noexcept
+        : bytes_(), tag_(Tag::Null) { }
+
+    Json(Json const& other);
+    Json(Json&& other) noexcept
+        : bytes_(), tag_(other.tag_) {
+        std::memcpy(bytes_, other.bytes_, sizeof bytes_);
+        other.tag_ = Tag::Null;
+    }
+    auto operator=(Json const& other) -> Json&;
+    auto operator=(Json&& other) noexcept -> Json&;
+    ~Json() {
+        if (tag_ >= Tag::OwnedString) { release(); }
+    }
 
     explicit Json(Type type);
 
-    explicit Json(boolean_t boolean)
-        : type_(Type::Boolean), value_(boolean) { }
-
-    explicit Json(number_t number)
-        : type_(Type::Number), value_(number) { }
-
-    explicit Json(string_t string)
-        : type_(Type::String), value_(std::move(string)) { }
-
-    explicit Json(char const* string)
-        : type_(Type::String), value_(string) { }
-
-    explicit Json(array_t array)
-        : type_(Type::Array), value_(std::move(array)) { }
-
-    Json(std::initializer_list<Json> list)
-        : type_(Type::Array), value_(list) { }
-
-    explicit Json(object_t object)
-        : type_(Type::Object), value_(std::move(object)) { }
+    explicit Json(boolean_t boolean) noexcept
+        : bytes_(), tag_(Tag::Boolean) { store(boolean); }
+
+    explicit Json(number_t number) noexcept
+        : bytes_(), tag_(Tag::Double) { store(number); }
+
+    // Any integer type but bool, stored exactly. Unsigned values that fit in
+    // an integer_t are stored as one, like parsed integers
+    template <typename Integer,
+              std::enable_if_t<std::is_integral_v<Integer> && not std::is_same_v<Integer, bool>, int> = 0>
+    explicit Json(Integer integer) noexcept
+        : bytes_(), tag_(Tag::Integer) {
+        if constexpr (std::is_signed_v<Integer>) {
+            store(static_cast<integer_t>(integer));
+        } else if (static_cast<unsigned_t>(integer) <= static_cast<unsigned_t>(std::numeric_limits<integer_t>::max())) {
+            store(static_cast<integer_t>(integer));
+        } else {
+            tag_ = Tag::Unsigned;
+            store(static_cast<unsigned_t>(integer));
+        }
+    }
+
+    // short strings are stored inline, longer ones keep `string` with its resource
+    explicit Json(string_t string);
+    // longer strings are allocated from `resource`
+    explicit Json(std::string_view string, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    explicit Json(char const* string);
+    // short strings are copied inline instead of borrowed
+    explicit Json(borrowed_string_t string);
+
+    explicit Json(array_t array);
+    explicit Json(std::vector<Json> const& array);
+    Json(std::initializer_list<Json> list);
+
+    explicit Json(object_t object);
 
     [[nodiscard]] auto is_null()   const noexcept -> bool;
     [[nodiscard]] auto is_bool()   const noexcept -> bool;
@@ -75,8 +130,18 @@ public:
     [[nodiscard]] auto boolean() const -> boolean_t;
     [[nodiscard]] auto number() const -> number_t;
 
+    // whether a number is stored as an integer, see Number
+    [[nodiscard]] auto is_integer() const noexcept -> bool;
+    [[nodiscard]] auto number_kind() const -> Number::Kind;
+    // Exact values of an integer, or of a double with an integral value.
+    // Throw a JsonException when the number does not fit
+    [[nodiscard]] auto integer() const -> integer_t;
+    [[nodiscard]] auto unsigned_integer() const -> unsigned_t;
+
+    // inline and borrowed strings are copied into an owned one, from the
+    // default resource, on mutable access
     [[nodiscard]] auto string() -> string_t&;
-    [[nodiscard]] auto string() const -> string_t const&;
+    [[nodiscard]] auto string() const -> std::string_view;
 
     [[nodiscard]] auto array() -> array_t&;
     [[nodiscard]] auto array() const -> array_t const&;
@@ -84,12 +149,50 @@ public:
     [[nodiscard]] auto object() -> object_t&;
     [[nodiscard]] auto object() const -> object_t const&;
 
+    // compact JSON, see serialize() for other layouts and outputs
     [[nodiscard]] auto to_string() const -> std::string;
 
 private:
 
-    Type type_;
-    value_t value_;
+    // the tags from OwnedString on own out of line storage
+    enum class Tag : std::uint8_t {
+        Null,
+        Boolean,
+        Double,
+        Integer,
+        Unsigned,
+        InlineString,
+        BorrowedString,
+        OwnedString,
+        Array,
+        Object,
+    };
+
+    [[nodiscard]] auto as_number() const -> Number;
+
+    // the first 8 bytes: a scalar, or a pointer to a string or a container
+    template <typename T>
+    void store(T value) noexcept {
+        static_assert(sizeof(T) <= 8 && std::is_trivially_copyable_v<T>);
+        std::memcpy(bytes_, &value, sizeof value);
+    }
+    template <typename T>
+    [[nodiscard]] auto load() const noexcept -> T {
+        auto value = T{};
+        std::memcpy(&value, bytes_, sizeof value);
+        return value;
+    }
+
+    void set_string(std::string_view string, std::pmr::memory_resource* resource);
+    // destroys and frees the out of line storage
+    void release() noexcept;
+
+private:
+
+    // the scalar or pointer, then the 32-bit size of a borrowed string.
+    // Inline strings take their bytes, then their size in the last byte
+    alignas(8) unsigned char bytes_[15];
+    Tag tag_;
 };
 
 } // namespace json
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "JsonKey.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+
+namespace json {
+
+/*
+Object keys stored once and shared by every document parsed with the
+dictionary: the member keys of those documents refer to the stored copy
+through an InternedKey instead of holding a copy of their own. Documents of
+one schema, NDJSON records or repeated requests, then allocate no key names
+of their own, and keys of one dictionary compare by pointer.
+
+Keys are never removed, so every handle stays valid as long as the
+dictionary lives; documents using it must not outlive it. A key longer than
+max_key_size, or any new key once max_keys are stored, is not interned and
+intern() returns a null handle: the caller then stores the key itself. That
+bounds the dictionary when keys are data rather than names.
+
+All member functions are thread-safe. The keys are spread over shards with
+a lock each so parallel parses rarely wait on one another.
+*/
+class KeyDictionary {
+public:
+
+    struct Stats {
+        std::size_t keys = 0;       // distinct keys stored
+        std::size_t bytes = 0;      // their total size
+        std::size_t lookups = 0;    // calls of intern()
+        std::size_t hits = 0;       // calls of intern() finding a stored key
+
+        [[nodiscard]] auto hit_rate() const noexcept -> double;
+    };
+
+    static constexpr std::size_t default_max_keys = 1u << 20;
+    static constexpr std::size_t default_max_key_size = 128;
+
+public:
+
+    explicit KeyDictionary(std::size_t max_keys = default_max_keys,
+                           std::size_t max_key_size = default_max_key_size);
+
+    KeyDictionary(KeyDictionary const&) = delete;
+    auto operator=(KeyDictionary const&) -> KeyDictionary& = delete;
+
+    // The stored copy of `key`, added when it is new. Null when the key is
+    // too long or the dictionary is full
+    [[nodiscard]] auto intern(std::string_view key) -> InternedKey;
+    // The stored copy of `key`, null when it is not stored. Not counted in stats()
+    [[nodiscard]] auto find(std::string_view key) const -> InternedKey;
+
+    [[nodiscard]] auto size() const -> std::size_t;
+    [[nodiscard]] auto stats() const -> Stats;
+
+    [[nodiscard]] auto max_keys() const noexcept -> std::size_t;
+    [[nodiscard]] auto max_key_size() const noexcept -> std::size_t;
+
+private:
+
+    static constexpr std::size_t shard_count = 16;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        // views of the bytes in `storage`
+        std::unordered_set<std::string_view> keys;
+        std::pmr::monotonic_buffer_resource storage;
+        std::size_t bytes = 0;
+        std::size_t lookups = 0;
+        std::size_t hits = 0;
+    };
+
+    [[nodiscard]] auto shard_of(std::size_t hash) noexcept -> Shard&;
+    [[nodiscard]] auto shard_of(std::size_t hash) const noexcept -> Shard const&;
+
+private:
+
+    std::size_t max_keys_;
+    std::size_t max_key_size_;
+    // keys of all shards, reserved before a key is added
+    std::atomic<std::size_t> key_count_;
+    std::array<Shard, shard_count> shards_;
+};
+
+} // namespace json
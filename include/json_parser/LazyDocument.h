@@ -0,0 +1,100 @@
+#pragma once
+
+#include "JsonValue.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace json {
+
+/*
+Cursor on one value of a LazyDocument: an offset into its source. Nothing is
+decoded until asked for, and looking up a member or element skips the values
+before it with a bracket-matching scan over the structural index instead of
+parsing them.
+
+Only what is accessed is checked. A syntax error met on the way is thrown
+as a parse error; errors inside skipped values go unnoticed unless
+LazyDocument::validate() is called.
+*/
+class LazyValue {
+public:
+
+    LazyValue(std::string_view source, std::size_t offset) noexcept;
+
+    // from the value's first byte only
+    [[nodiscard]] auto type() const -> Type;
+    [[nodiscard]] auto is_null() const -> bool;
+
+    // throw a JsonException on a value of another type
+    [[nodiscard]] auto get_bool()   const -> bool;
+    [[nodiscard]] auto get_number() const -> double;
+    [[nodiscard]] auto get_string() const -> std::string;
+
+    // the number as parse_string stores it, see Json::number_kind()
+    [[nodiscard]] auto number_kind() const -> Number::Kind;
+    // Exact values of an integer, or of a double with an integral value.
+    // Throw a JsonException when the number does not fit
+    [[nodiscard]] auto integer() const -> std::int64_t;
+    [[nodiscard]] auto unsigned_integer() const -> std::uint64_t;
+
+    // object members, operator[] throws when the key does not exist
+    [[nodiscard]] auto find(std::string_view key) const -> std::optional<LazyValue>;
+    [[nodiscard]] auto operator[](std::string_view key) const -> LazyValue;
+    [[nodiscard]] auto members() const -> std::vector<std::pair<std::string, LazyValue>>;
+
+    // array elements, operator[] throws when the index is out of range
+    [[nodiscard]] auto find(std::size_t index) const -> std::optional<LazyValue>;
+    [[nodiscard]] auto operator[](std::size_t index) const -> LazyValue;
+    [[nodiscard]] auto elements() const -> std::vector<LazyValue>;
+
+    // members of an object or elements of an array
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    [[nodiscard]] auto offset() const noexcept -> std::size_t;
+
+private:
+
+    // decoded from the value's token, throws on another type
+    [[nodiscard]] auto as_number() const -> Number;
+
+    // calls `visit(key, value)` for each member until it returns true,
+    // returns whether one did
+    template <typename Visit>
+    auto walk_members(Visit&& visit) const -> bool;
+    template <typename Visit>
+    auto walk_elements(Visit&& visit) const -> bool;
+
+    void access_error(std::string const& message) const;
+
+private:
+
+    std::string_view source_;
+    std::size_t offset_;
+};
+
+// On-demand counterpart of parse_string, see LazyValue. The source must
+// outlive the document and every value taken from it
+class LazyDocument {
+public:
+
+    explicit LazyDocument(std::string_view source) noexcept;
+
+    // throws a parse error for an empty source
+    [[nodiscard]] auto root() const -> LazyValue;
+    [[nodiscard]] auto operator[](std::string_view key) const -> LazyValue;
+
+    // Parses the whole source without building anything and throws its
+    // first syntax error, like parse_string would
+    void validate() const;
+
+private:
+
+    std::string_view source_;
+};
+
+} // namespace json
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "JsonValue.h"
+#include "KeyDictionary.h"
+#include "ParseStats.h"
+#include "ParserContext.h"
+#include "detail/ThreadPool.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+struct NdJsonOptions {
+    // worker threads, 0 for one per hardware thread
+    std::size_t threads = 0;
+    // lines are handed to the workers in batches of about this many bytes
+    std::size_t batch_bytes = 64 * 1024;
+    // deliver the lines in input order, or as soon as their batch is parsed
+    bool ordered = true;
+    // object keys of every line interned there, which must outlive the lines
+    KeyDictionary* keys = nullptr;
+    // When set, every line is parsed instrumented and its statistics passed
+    // here with its line number. Called on the worker threads, concurrently
+    std::function<void(std::size_t line, ParseStats const& stats)> observer;
+};
+
+// One non-blank line of the input, parsed on its own
+struct NdJsonLine {
+    std::size_t number;     // 1-based line number in the input
+    Json value;             // null when the line is invalid
+    std::string error;      // the parse error of an invalid line, empty otherwise
+};
+
+/*
+Parser for newline-delimited JSON (NDJSON, JSON Lines): one document per
+line, blank lines are skipped and a trailing '\r' is ignored. The input is
+split into batches at newlines which a pool of workers parses in parallel.
+Every busy worker holds a ParserContext, kept for the next batches, so once
+warm a line allocates its Json and nothing else.
+
+An invalid line does not stop the others, it is delivered with its error.
+Lines are delivered to the callback on the calling thread, one at a time,
+so the callback needs no synchronization. At most a few batches per worker
+are in flight, which bounds the memory held by parsed but undelivered lines.
+*/
+class NdJsonParser {
+public:
+
+    using callback_t = std::function<void(NdJsonLine&&)>;
+
+    explicit NdJsonParser(NdJsonOptions options = {});
+
+    // returns once every line has been delivered
+    void parse(std::string_view source, callback_t const& callback);
+    // parses a file mapped in memory, see MappedFile
+    void parse_file(std::string const& path, callback_t const& callback);
+
+    [[nodiscard]] auto threads() const noexcept -> std::size_t;
+
+private:
+
+    // a context of contexts_, or a new one when all are in use
+    [[nodiscard]] auto acquire_context() -> std::unique_ptr<ParserContext>;
+    void release_context(std::unique_ptr<ParserContext> context) noexcept;
+
+private:
+
+    NdJsonOptions options_;
+    std::mutex contexts_mutex_;
+    // the contexts not in use, at most one per worker
+    std::vector<std::unique_ptr<ParserContext>> contexts_;
+    ThreadPool pool_;
+};
+
+// Same as NdJsonParser(options).parse(source, callback)
+void parse_ndjson(std::string_view source,
+                  NdJsonParser::callback_t const& callback,
+                  NdJsonOptions options = {});
+
+} // namespace json
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "JsonValue.h"
+#include "detail/ThreadPool.h"
+#include <cstddef>
+#include <string_view>
+
+namespace json {
+
+struct ParallelOptions {
+    // worker threads, 0 for one per hardware thread
+    std::size_t threads = 0;
+    // elements are handed to the workers in ranges of about this many bytes,
+    // a smaller array is parsed sequentially. 0 counts as 1
+    std::size_t chunk_bytes = 256 * 1024;
+};
+
+/*
+Same result and errors as parse_string, but the elements of a top-level
+array are parsed in parallel. A structural pre-scan, which tracks strings
+and escapes, finds the commas at depth 1; ranges of elements are parsed by
+the workers and moved into the array in order.
+
+Any error found on the way, including a malformed array the pre-scan cannot
+split, makes the whole source be parsed again sequentially so it is reported
+exactly as parse_string reports it.
+*/
+[[nodiscard]] auto parse_string_parallel(std::string_view source, ParallelOptions options = {}) -> Json;
+[[nodiscard]] auto parse_string_parallel(std::string_view source, ThreadPool& pool,
+                                         std::size_t chunk_bytes = ParallelOptions{}.chunk_bytes) -> Json;
+
+} // namespace json
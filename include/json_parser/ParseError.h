@@ -0,0 +1,109 @@
+#pragma once
+
+#include "detail/SourceLocation.h"
+#include "detail/Token.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace json {
+
+// Why a parse failed, see ParseError::message for the text of each
+enum class ParseErrc : std::uint8_t {
+    None,
+
+    // scan errors, at the malformed lexeme
+    InvalidCharacter,
+    InvalidLiteral,         // letters other than null, true or false
+    InvalidNumber,
+    NumberOutOfRange,       // too large in magnitude for a double
+    UnterminatedString,
+    InvalidEscape,          // just after the escape character
+    InvalidHexDigit,        // just after the digit
+    UnpairedSurrogate,
+    InvalidUtf8,
+
+    // parse errors, at the unexpected token
+    EmptyInput,
+    TrailingContent,        // anything after the element
+    ExpectedValue,
+    ExpectedArrayComma,
+    UnterminatedArray,
+    ExpectedKey,
+    ExpectedColon,
+    ExpectedObjectComma,
+    UnterminatedObject,
+    DuplicateKey,
+    NestingTooDeep,         // at the array or object past max_nesting_depth
+};
+
+// Arrays and objects nested deeper are an error, which keeps the recursion
+// of Parser, and of the Json destructor on what it built, within the stack
+inline constexpr std::size_t max_nesting_depth = 1024;
+
+// How Scanner and Parser surface errors: thrown as a JsonException, or
+// recorded as a ParseError and the parse stopped
+enum class ErrorMode : std::uint8_t {
+    Throw,
+    Report,
+};
+
+/*
+A parse error as found: a code and the byte offset of the offending lexeme
+or token, built without allocating. Its line, column and text, the what()
+of the JsonException parse_string would throw, are only computed when asked
+for, from the source that was parsed.
+*/
+struct ParseError {
+    ParseErrc code = ParseErrc::None;
+    TokenType token = TokenType::Eof;   // of parse errors, the one at `offset`
+    std::size_t offset = 0;
+
+    explicit operator bool() const noexcept { return code != ParseErrc::None; }
+
+    [[nodiscard]] auto is_scan_error() const noexcept -> bool;
+    [[nodiscard]] auto location(std::string_view source) const -> SourceLocation;
+    [[nodiscard]] auto message(std::string_view source) const -> std::string;
+};
+
+/*
+Either a value or the ParseError that prevented it, like std::expected.
+value() and the dereference operators require has_value().
+*/
+template <typename T>
+class ParseResult {
+public:
+
+    static_assert(std::is_default_constructible_v<T>, "a failed result holds a default constructed T");
+
+    ParseResult(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : value_(std::move(value)), error_() { }
+
+    ParseResult(ParseError error) noexcept(std::is_nothrow_default_constructible_v<T>)
+        : value_(), error_(error) { }
+
+    [[nodiscard]] auto has_value() const noexcept -> bool { return not error_; }
+    explicit operator bool() const noexcept { return has_value(); }
+
+    [[nodiscard]] auto value() & noexcept -> T& { return value_; }
+    [[nodiscard]] auto value() const& noexcept -> T const& { return value_; }
+    [[nodiscard]] auto value() && noexcept -> T&& { return std::move(value_); }
+
+    [[nodiscard]] auto operator*() & noexcept -> T& { return value_; }
+    [[nodiscard]] auto operator*() const& noexcept -> T const& { return value_; }
+    [[nodiscard]] auto operator*() && noexcept -> T&& { return std::move(value_); }
+    [[nodiscard]] auto operator->() noexcept -> T* { return &value_; }
+    [[nodiscard]] auto operator->() const noexcept -> T const* { return &value_; }
+
+    [[nodiscard]] auto error() const noexcept -> ParseError const& { return error_; }
+
+private:
+
+    T value_;
+    ParseError error_;
+};
+
+} // namespace json
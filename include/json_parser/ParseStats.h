@@ -0,0 +1,55 @@
+#pragma once
+
+#include "detail/Token.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace json {
+
+/*
+What a parse did, filled by the overloads of parse_string, parse_document
+and parse_sax taking a ParseStats, or handed to NdJsonOptions::observer.
+
+Those parse once through a counting Scanner and handler, a few percent
+slower than an uninstrumented parse. The counts are exact, the three phase
+times are estimates: one token or event in about 32 is timed, at random,
+with the time stamp counter, and the sampled ticks are scaled to the wall
+time of the whole parse, which the phases add up to. The other entry points
+are compiled without any of this.
+*/
+struct ParseStats {
+    using duration = std::chrono::nanoseconds;
+
+    static constexpr std::size_t token_type_count = static_cast<std::size_t>(TokenType::Error) + 1;
+
+    std::size_t bytes = 0;          // size of the source
+
+    duration scan_time{};           // tokenizing, the Scanner
+    duration parse_time{};          // the grammar, the Parser: the rest of the parse
+    duration build_time{};          // the handler, building the Json for a DOM parse
+
+    // tokens by TokenType, the final Eof included. Error tokens only come
+    // from a parse reporting its errors instead of throwing them
+    std::array<std::size_t, token_type_count> tokens{};
+    std::size_t max_depth = 0;      // 0 for a scalar, 1 for a flat array or object
+    std::size_t strings = 0;        // string values, keys not included
+    std::size_t keys = 0;
+    std::size_t escaped_strings = 0;    // keys and values with escape sequences
+    std::size_t escapes = 0;            // escape sequences in them
+    std::size_t numbers = 0;
+    std::size_t integers = 0;           // numbers kept as exact integers
+
+    // requests made to the memory resource of the built Json, none for parse_sax
+    std::size_t allocations = 0;
+    std::size_t allocated_bytes = 0;
+
+    [[nodiscard]] auto token_count(TokenType type) const noexcept -> std::size_t {
+        return tokens[static_cast<std::size_t>(type)];
+    }
+    [[nodiscard]] auto total_time() const noexcept -> duration {
+        return scan_time + parse_time + build_time;
+    }
+};
+
+} // namespace json
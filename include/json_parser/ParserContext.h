@@ -0,0 +1,75 @@
+#pragma once
+
+#include "JsonValue.h"
+#include "detail/DomBuilder.h"
+#include "detail/Instrumentation.h"
+#include "detail/Scanner.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+
+namespace json {
+
+/*
+State kept between parses, for loops parsing many small documents on one
+thread: the scanner's scratch buffers, the builder's container stack and an
+arena. Once they have grown to the largest document seen, parsing into the
+arena makes no heap allocation at all.
+
+The arena is one buffer. A parse that does not fit spills over to the heap,
+and the buffer is grown by as much before the next parse. Starting over
+frees the arena in O(1): the previous tree is dropped without being walked.
+
+A context is used by one thread at a time.
+*/
+class ParserContext {
+public:
+
+    static constexpr std::size_t default_arena_bytes = 64 * 1024;
+
+public:
+
+    explicit ParserContext(std::size_t arena_bytes = default_arena_bytes);
+
+    ParserContext(ParserContext const&) = delete;
+    auto operator=(ParserContext const&) -> ParserContext& = delete;
+
+    // Parses `source` into the arena. The result is valid until the next
+    // parse or reset(); copy it into a Json to keep it longer
+    [[nodiscard]] auto parse(std::string_view source) -> Json const&;
+
+    // Parses `source` into a Json allocated from `resource`, only the
+    // scratch buffers and the stack are reused. With `keys`, object keys
+    // are interned there, see KeyDictionary.h
+    [[nodiscard]] auto parse(std::string_view source, std::pmr::memory_resource* resource,
+                             KeyDictionary* keys = nullptr) -> Json;
+
+    // Drops the result of the last parse into the arena
+    void reset();
+
+    [[nodiscard]] auto arena_capacity() const noexcept -> std::size_t;
+
+private:
+
+    [[nodiscard]] auto build(std::string_view source, std::pmr::memory_resource* resource,
+                             KeyDictionary* keys) -> Json;
+
+private:
+
+    Scanner::Scratch scratch_;
+    std::unique_ptr<std::byte[]> buffer_;
+    std::size_t buffer_size_;
+    // upstream of the arena, counts what it requests beyond buffer_
+    CountingResource spill_;
+    // bytes the arena requested beyond buffer_ during the last parse
+    std::size_t spilled_;
+    std::optional<std::pmr::monotonic_buffer_resource> arena_;
+    // constructed in the arena and never destroyed, like the root of a Document
+    Json* root_;
+    // after the arena, so it is destroyed while the arena still exists
+    DomBuilder builder_;
+};
+
+} // namespace json
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "JsonValue.h"
+#include "JsonException.h"
+#include "detail/PushScanner.h"
+#include "detail/DomBuilder.h"
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+// throws the parse error of a PushParser, out of line so that including
+// this header does not require exceptions
+[[noreturn]] void throw_parse_error(std::string const& message, Token const& token, SourceLocation location);
+
+/*
+Parser for input arriving in chunks, e.g. from a socket, which reports values
+to the same Handler interface as Parser (see detail/Parser.h). Chunks may be
+split anywhere; whatever they leave incomplete is kept until the next one.
+
+The grammar is walked as a state machine over a stack of open containers
+instead of by recursion, so parsing can stop at the end of any chunk and
+resume with the next. Errors and their messages are the ones of Parser, in
+the same order: Parser has scanned the token after a value it rejects, so
+the scan errors of that token come first, and those errors are only thrown
+once the next token is scanned.
+*/
+template <typename Handler>
+class PushParser {
+public:
+
+    explicit PushParser(Handler& handler);
+
+    // Parses as much as `chunk` completes, which may be released afterwards.
+    // Returns false once a handler callback stopped the parse, later calls
+    // do nothing
+    auto feed(std::string_view chunk) -> bool;
+
+    // Ends the input, throws when it does not hold a complete document
+    auto finish() -> bool;
+
+    // throws a parse error pointing at the last token, which may reference
+    // the last chunk: call it before that chunk is released
+    void fail(std::string const& message) const;
+
+private:
+
+    // what the next token may be
+    enum class State : std::uint8_t {
+        Start,          // the document's value
+        Value,          // an element or member value
+        FirstElement,   // an element or "]"
+        AfterElement,   // "," or "]"
+        FirstKey,       // a key or "}"
+        Key,
+        Colon,
+        AfterMember,    // "," or "}"
+        Done,           // only Eof
+    };
+
+    enum class Container : std::uint8_t {
+        Array,
+        Object,
+    };
+
+    [[nodiscard]] auto drain() -> bool;
+    [[nodiscard]] auto process(Token const& token) -> bool;
+    [[nodiscard]] auto process_value(Token const& token) -> bool;
+    void close_container();
+    void end_value() noexcept;
+
+    void error(std::string const& message, Token const& token, SourceLocation location) const;
+
+private:
+
+    PushScanner scanner_;
+    Handler& handler_;
+    std::vector<Container> open_;
+    State state_;
+    bool stopped_;
+    // kept to point errors at the token before an Eof
+    Token previous_;
+    SourceLocation previous_location_;
+    // an error at previous_, thrown with the next token
+    std::string pending_error_;
+};
+
+// Builds a Json from chunks, see PushParser and DomBuilder
+class JsonPushParser {
+public:
+
+    explicit JsonPushParser(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // the parser refers to the builder
+    JsonPushParser(JsonPushParser const&) = delete;
+    auto operator=(JsonPushParser const&) -> JsonPushParser& = delete;
+
+    void feed(std::string_view chunk);
+
+    // Ends the input and returns the parsed value
+    [[nodiscard]] auto finish() -> Json;
+
+private:
+
+    DomBuilder builder_;
+    PushParser<DomBuilder> parser_;
+};
+
+template <typename Handler>
+PushParser<Handler>::PushParser(Handler& handler)
+:
+    scanner_(),
+    handler_(handler),
+    open_(),
+    state_(State::Start),
+    stopped_(false),
+    previous_(),
+    previous_location_{ 0, 0 },
+    pending_error_()
+{
+}
+
+template <typename Handler>
+auto PushParser<Handler>::feed(std::string_view chunk) -> bool {
+    if (stopped_) { return false; }
+    scanner_.feed(chunk);
+    return drain();
+}
+
+template <typename Handler>
+auto PushParser<Handler>::finish() -> bool {
+    if (stopped_) { return false; }
+    scanner_.finish();
+    return drain();
+}
+
+template <typename Handler>
+void PushParser<Handler>::fail(std::string const& message) const {
+    error(message, scanner_.token(), scanner_.location());
+}
+
+template <typename Handler>
+auto PushParser<Handler>::drain() -> bool {
+    while (scanner_.next()) {
+        auto const& token = scanner_.token();
+        if (not process(token)) {
+            stopped_ = true;
+            return false;
+        }
+        previous_ = token;
+        previous_location_ = scanner_.location();
+    }
+    return true;
+}
+
+template <typename Handler>
+auto PushParser<Handler>::process(Token const& token) -> bool {
+    using TT = TokenType;
+
+    if (not pending_error_.empty()) { error(pending_error_, previous_, previous_location_); }
+    switch (state_) {
+
+    case State::Start: {
+        if (token.type == TT::Eof) { error("Empty string", token, scanner_.location()); }
+        return process_value(token);
+    }
+    case State::Value: return process_value(token);
+    case State::FirstElement: {
+        if (token.type != TT::RightBracket) { return process_value(token); }
+        close_container();
+        return handler_.on_end_array();
+    }
+    case State::AfterElement: {
+        switch (token.type) {
+        case TT::Comma: state_ = State::Value; return true;
+        case TT::RightBracket: close_container(); return handler_.on_end_array();
+        case TT::Eof: error("Need right bracket \"]\" to terminate an array", token, scanner_.location()); break;
+        default: error("Expected comma \",\" after element in array", token, scanner_.location()); break;
+        }
+        return false;
+    }
+    case State::FirstKey: {
+        if (token.type == TT::RightBrace) {
+            close_container();
+            return handler_.on_end_object();
+        }
+        [[fallthrough]];
+    }
+    case State::Key: {
+        if (token.type != TT::String) {
+            error("Key of object element must be a string", token, scanner_.location());
+        }
+        // the key is still the last token here, handlers may fail() on it
+        state_ = State::Colon;
+        return handler_.on_key(std::get<std::string_view>(token.literal));
+    }
+    case State::Colon: {
+        if (token.type != TT::Colon) {
+            error("Object must have a colon \":\" to separate a key-value pair", token, scanner_.location());
+        }
+        state_ = State::Value;
+        return true;
+    }
+    case State::AfterMember: {
+        switch (token.type) {
+        case TT::Comma: state_ = State::Key; return true;
+        case TT::RightBrace: close_container(); return handler_.on_end_object();
+        case TT::Eof: error("Need right brace \"}\" to terminate an object", token, scanner_.location()); break;
+        default: error("Expected comma \",\" after element in object", token, scanner_.location()); break;
+        }
+        return false;
+    }
+    case State::Done: {
+        if (token.type != TT::Eof) {
+            error("Unexpected token after parsing element", token, scanner_.location());
+        }
+        return true;
+    }
+
+    }
+    return false;
+}
+
+template <typename Handler>
+auto PushParser<Handler>::process_value(Token const& token) -> bool {
+    using TT = TokenType;
+
+    if ((token.type == TT::LeftBracket || token.type == TT::LeftBrace) && open_.size() == max_nesting_depth) {
+        pending_error_ = "Arrays and objects nest deeper than " + std::to_string(max_nesting_depth) + " levels";
+        return true;
+    }
+    switch (token.type) {
+    case TT::LeftBracket:
+        open_.push_back(Container::Array);
+        state_ = State::FirstElement;
+        return handler_.on_start_array();
+    case TT::LeftBrace:
+        open_.push_back(Container::Object);
+        state_ = State::FirstKey;
+        return handler_.on_start_object();
+    case TT::Null:   end_value(); return handler_.on_null();
+    case TT::True:   end_value(); return handler_.on_bool(true);
+    case TT::False:  end_value(); return handler_.on_bool(false);
+    case TT::Number: end_value(); return report_number(handler_, std::get<Number>(token.literal));
+    case TT::String: end_value(); return handler_.on_string(std::get<std::string_view>(token.literal));
+    // like Parser, a missing value is reported at the token before the end
+    case TT::Eof: error("Invalid literal", previous_, previous_location_); break;
+    default:      pending_error_ = "Invalid literal"; return true;
+    }
+    return false;
+}
+
+template <typename Handler>
+void PushParser<Handler>::close_container() {
+    open_.pop_back();
+    end_value();
+}
+
+template <typename Handler>
+void PushParser<Handler>::end_value() noexcept {
+    if      (open_.empty())                         { state_ = State::Done; }
+    else if (open_.back() == Container::Array)      { state_ = State::AfterElement; }
+    else                                            { state_ = State::AfterMember; }
+}
+
+template <typename Handler>
+void PushParser<Handler>::error(std::string const& message, Token const& token, SourceLocation location) const {
+    throw_parse_error(message, token, location);
+}
+
+} // namespace json
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "JsonValue.h"
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace json {
+
+/*
+Buffered output of the serializer. A string target is appended to directly;
+any other sink receives the output in blocks of about flush_threshold
+bytes, and whatever remains on flush() or destruction.
+Sink errors throw std::system_error.
+*/
+class Writer {
+public:
+
+    using sink_t = std::function<void(std::string_view)>;
+
+    static constexpr std::size_t flush_threshold = 64 * 1024;
+
+    explicit Writer(std::string& target);
+    explicit Writer(std::FILE* file);
+    // a POSIX file descriptor
+    explicit Writer(int fd);
+    explicit Writer(sink_t sink);
+
+    // flushes, errors are lost: call flush() to see them
+    ~Writer();
+
+    Writer(Writer const&) = delete;
+    auto operator=(Writer const&) -> Writer& = delete;
+
+    void put(char c) { target_->push_back(c); }
+    void write(std::string_view text) { target_->append(text); }
+
+    // hands a full buffer to the sink, called between values
+    void maybe_flush() {
+        if (sink_ && buffer_.size() >= flush_threshold) { flush(); }
+    }
+    void flush();
+
+private:
+
+    std::string buffer_;
+    std::string* target_;
+    sink_t sink_;
+};
+
+struct SerializeOptions {
+    // 0 writes compact output, anything else puts every element and member
+    // on its own line, indented by that many spaces per level
+    std::size_t indent = 0;
+};
+
+void serialize(Json const& json, Writer& writer, SerializeOptions options = {});
+[[nodiscard]] auto serialize(Json const& json, SerializeOptions options = {}) -> std::string;
+
+// The pieces serialize() is made of, for writers of other values such as
+// serialize_bound in Binding.h. `text` is quoted and escaped; non-finite
+// numbers are written as null
+void write_string(std::string_view text, Writer& writer);
+void write_number(Number const& number, Writer& writer);
+
+} // namespace json
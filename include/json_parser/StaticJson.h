@@ -0,0 +1,839 @@
+#pragma once
+
+#include "JsonValue.h"
+#include "detail/Number.h"
+#include "detail/Utf8.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+/*
+JSON parsed at compile time, for configuration and tables embedded in the
+program as string literals:
+
+    constexpr auto defaults = JSON_PARSER_STATIC(R"({"port": 8080, "hosts": ["a", "b"]})");
+    static_assert(defaults.root()["port"].integer() == 8080);
+
+The tree is a constant in the binary, nothing is parsed at startup. Invalid
+JSON fails the build: the compiler reports a call to the non-constexpr
+invalid_json_literal on the line stating the error, below the constexpr
+expansion notes leading to it. Called at run time, the same functions throw
+a JsonException.
+
+The grammar is the one of Parser.h with the checks of Scanner: the number
+grammar of Number.h, escape sequences decoded to UTF-8, valid UTF-8, and no
+duplicate keys. Integers are exact like Number. Doubles are correctly
+rounded like parse_string: within Clinger's fast path (at most 15 significant
+digits and a power of ten within +-22, which covers most configuration
+values) in one exact operation, beyond it by checking a long double estimate
+against the halfway points to its neighbours in big-integer arithmetic.
+
+Nesting is limited by the constexpr depth of the compiler, in the hundreds.
+*/
+
+namespace json {
+
+// Bytes of a string in a StaticJson: in the literal when it has no escape
+// sequence, in the decoded strings of the tree otherwise
+struct StaticString {
+    std::size_t offset = 0;
+    std::size_t size = 0;
+    bool decoded = false;
+};
+
+// One value of a StaticJson. Nodes are stored in document order, so the
+// first child of a node follows it and the next sibling starts at `end`
+struct StaticNode {
+    Type type = Type::Null;
+    bool boolean = false;
+    Number::Kind kind = Number::Kind::Int;
+    std::int64_t integer = 0;
+    std::uint64_t unsigned_integer = 0;
+    double number = 0;
+    StaticString string;
+    StaticString key;       // of an object member
+    std::size_t size = 0;   // elements or members
+    std::size_t end = 0;    // one past the last node of the subtree
+};
+
+namespace detail {
+
+// Throw a JsonException. Not constexpr: reaching one during constant
+// evaluation is what fails the build
+[[noreturn]] void invalid_json_literal(char const* message, std::size_t offset);
+[[noreturn]] void invalid_static_cast(Type from, Type to);
+[[noreturn]] void invalid_static_number(char const* message);
+// throws std::out_of_range
+[[noreturn]] void static_value_out_of_range(char const* message);
+
+} // namespace detail
+
+// Read-only view of one value of a StaticJson, with the accessors of Json.
+// Elements and members are reached by walking the siblings before them
+class StaticValue {
+public:
+
+    constexpr StaticValue(StaticNode const* nodes, std::size_t index,
+                          std::string_view source, char const* strings) noexcept
+        : nodes_(nodes), index_(index), source_(source), strings_(strings) { }
+
+    [[nodiscard]] constexpr auto type() const noexcept -> Type { return node().type; }
+    [[nodiscard]] constexpr auto is_null()   const noexcept -> bool { return type() == Type::Null; }
+    [[nodiscard]] constexpr auto is_bool()   const noexcept -> bool { return type() == Type::Boolean; }
+    [[nodiscard]] constexpr auto is_number() const noexcept -> bool { return type() == Type::Number; }
+    [[nodiscard]] constexpr auto is_string() const noexcept -> bool { return type() == Type::String; }
+    [[nodiscard]] constexpr auto is_array()  const noexcept -> bool { return type() == Type::Array; }
+    [[nodiscard]] constexpr auto is_object() const noexcept -> bool { return type() == Type::Object; }
+
+    [[nodiscard]] constexpr auto boolean() const -> bool {
+        expect(Type::Boolean);
+        return node().boolean;
+    }
+
+    [[nodiscard]] constexpr auto number_kind() const -> Number::Kind {
+        expect(Type::Number);
+        return node().kind;
+    }
+
+    [[nodiscard]] constexpr auto is_integer() const noexcept -> bool {
+        return is_number() && node().kind != Number::Kind::Double;
+    }
+
+    [[nodiscard]] constexpr auto number() const -> double {
+        switch (number_kind()) {
+        case Number::Kind::Int:    return static_cast<double>(node().integer);
+        case Number::Kind::UInt:   return static_cast<double>(node().unsigned_integer);
+        case Number::Kind::Double: return node().number;
+        }
+        return node().number;
+    }
+
+    // Exact values of an integer, or of a double with an integral value.
+    // Throw a JsonException when the number does not fit, like Json
+    [[nodiscard]] constexpr auto integer() const -> std::int64_t {
+        switch (number_kind()) {
+        case Number::Kind::Int:
+            return node().integer;
+        case Number::Kind::UInt:
+            break;
+        case Number::Kind::Double: {
+            // 2^63 is exact as a double, unlike the int64_t maximum
+            auto const d = node().number;
+            if (d >= -9223372036854775808.0 && d < 9223372036854775808.0
+                && static_cast<double>(static_cast<std::int64_t>(d)) == d) {
+                return static_cast<std::int64_t>(d);
+            }
+            break;
+        }
+        }
+        detail::invalid_static_number("does not fit in a 64-bit integer");
+    }
+
+    [[nodiscard]] constexpr auto unsigned_integer() const -> std::uint64_t {
+        switch (number_kind()) {
+        case Number::Kind::Int:
+            if (node().integer < 0) { break; }
+            return static_cast<std::uint64_t>(node().integer);
+        case Number::Kind::UInt:
+            return node().unsigned_integer;
+        case Number::Kind::Double: {
+            auto const d = node().number;
+            if (d >= 0 && d < 18446744073709551616.0
+                && static_cast<double>(static_cast<std::uint64_t>(d)) == d) {
+                return static_cast<std::uint64_t>(d);
+            }
+            break;
+        }
+        }
+        detail::invalid_static_number("does not fit in a 64-bit unsigned integer");
+    }
+
+    [[nodiscard]] constexpr auto string() const -> std::string_view {
+        expect(Type::String);
+        return view(node().string);
+    }
+
+    // elements of an array, members of an object
+    [[nodiscard]] constexpr auto size() const -> std::size_t {
+        if (not is_object()) { expect(Type::Array); }
+        return node().size;
+    }
+
+    // the element of an array, the value of the member of an object at `index`.
+    // Throws std::out_of_range past the end
+    [[nodiscard]] constexpr auto operator[](std::size_t index) const -> StaticValue {
+        return at(index);
+    }
+    [[nodiscard]] constexpr auto at(std::size_t index) const -> StaticValue {
+        if (index >= size()) { detail::static_value_out_of_range("Index out of the array"); }
+        return child(index);
+    }
+
+    // the key of the member at `index`
+    [[nodiscard]] constexpr auto key(std::size_t index) const -> std::string_view {
+        expect(Type::Object);
+        if (index >= size()) { detail::static_value_out_of_range("Index out of the object"); }
+        return view(child(index).node().key);
+    }
+
+    // Throws std::out_of_range when the key does not exist, like JsonObject
+    [[nodiscard]] constexpr auto operator[](std::string_view key) const -> StaticValue {
+        return at(key);
+    }
+    [[nodiscard]] constexpr auto at(std::string_view key) const -> StaticValue {
+        auto const position = find(key);
+        if (position == size()) { detail::static_value_out_of_range("Key not found in the object"); }
+        return child(position);
+    }
+
+    [[nodiscard]] constexpr auto contains(std::string_view key) const -> bool {
+        return find(key) != size();
+    }
+
+    // a heap allocated copy of the subtree
+    [[nodiscard]] auto to_json() const -> Json;
+
+private:
+
+    [[nodiscard]] constexpr auto node() const noexcept -> StaticNode const& { return nodes_[index_]; }
+
+    [[nodiscard]] constexpr auto view(StaticString const& string) const noexcept -> std::string_view {
+        if (string.decoded) { return { strings_ + string.offset, string.size }; }
+        return source_.substr(string.offset, string.size);
+    }
+
+    constexpr void expect(Type type) const {
+        if (node().type != type) { detail::invalid_static_cast(node().type, type); }
+    }
+
+    [[nodiscard]] constexpr auto child(std::size_t position) const noexcept -> StaticValue {
+        auto index = index_ + 1;
+        for (; position != 0; --position) { index = nodes_[index].end; }
+        return { nodes_, index, source_, strings_ };
+    }
+
+    // the position of the member, size() when there is none
+    [[nodiscard]] constexpr auto find(std::string_view key) const -> std::size_t {
+        expect(Type::Object);
+        auto index = index_ + 1;
+        for (std::size_t position = 0; position != node().size; ++position) {
+            if (view(nodes_[index].key) == key) { return position; }
+            index = nodes_[index].end;
+        }
+        return node().size;
+    }
+
+private:
+
+    StaticNode const* nodes_;
+    std::size_t index_;
+    std::string_view source_;
+    char const* strings_;
+};
+
+/*
+A JSON tree built at compile time with `Nodes` values and `Bytes` bytes of
+decoded escaped strings, see JSON_PARSER_STATIC which computes both. Strings
+without escape sequences reference the source, which must be a string
+literal or outlive the tree otherwise.
+*/
+template <std::size_t Nodes, std::size_t Bytes>
+class StaticJson {
+public:
+
+    constexpr StaticJson() noexcept = default;
+
+    [[nodiscard]] constexpr auto root() const noexcept -> StaticValue {
+        return { nodes_.data(), 0, source_, strings_.data() };
+    }
+
+    std::array<StaticNode, Nodes> nodes_{};
+    std::array<char, Bytes> strings_{};
+    std::string_view source_;
+};
+
+namespace detail {
+
+// An unsigned integer of up to 4096 bits: enough for the decimal digits a
+// StaticParser keeps, or a halfway point between doubles, scaled by the
+// powers of 2 and 5 that make them comparable
+class StaticBigInt {
+public:
+
+    constexpr explicit StaticBigInt(std::uint64_t value) noexcept
+        : limbs_(), size_(0) {
+        for (; value != 0; value >>= 32) { limbs_[size_++] = static_cast<std::uint32_t>(value); }
+    }
+
+    // *this * factor + addend
+    constexpr void multiply_add(std::uint32_t factor, std::uint32_t addend) noexcept {
+        auto carry = std::uint64_t{addend};
+        for (std::size_t i = 0; i < size_; ++i) {
+            carry += std::uint64_t{limbs_[i]} * factor;
+            limbs_[i] = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry != 0) { limbs_[size_++] = static_cast<std::uint32_t>(carry); }
+    }
+
+    constexpr void multiply_power_of_5(long exponent) noexcept {
+        constexpr std::uint32_t power_13 = 1'220'703'125;     // the largest power of 5 in 32 bits
+        for (; exponent >= 13; exponent -= 13) { multiply_add(power_13, 0); }
+        std::uint32_t rest = 1;
+        for (; exponent > 0; --exponent) { rest *= 5; }
+        multiply_add(rest, 0);
+    }
+
+    constexpr void shift_left(long bits) noexcept {
+        if (size_ == 0) { return; }
+        auto const whole = static_cast<std::size_t>(bits / 32);
+        auto const rest = static_cast<unsigned>(bits % 32);
+        if (rest != 0) {
+            limbs_[size_] = 0;
+            for (auto i = size_; i > 0; --i) { limbs_[i] = (limbs_[i] << rest) | (limbs_[i - 1] >> (32 - rest)); }
+            limbs_[0] <<= rest;
+            if (limbs_[size_] != 0) { ++size_; }
+        }
+        if (whole != 0) {
+            for (auto i = size_; i > 0; --i) { limbs_[i - 1 + whole] = limbs_[i - 1]; }
+            for (std::size_t i = 0; i < whole; ++i) { limbs_[i] = 0; }
+            size_ += whole;
+        }
+    }
+
+    // negative, zero or positive as *this is less than, equal to or greater than `other`
+    [[nodiscard]] constexpr auto compare(StaticBigInt const& other) const noexcept -> int {
+        if (size_ != other.size_) { return size_ < other.size_ ? -1 : 1; }
+        for (auto i = size_; i > 0; --i) {
+            if (limbs_[i - 1] != other.limbs_[i - 1]) { return limbs_[i - 1] < other.limbs_[i - 1] ? -1 : 1; }
+        }
+        return 0;
+    }
+
+private:
+
+    std::array<std::uint32_t, 128> limbs_;      // least significant first
+    std::size_t size_;                          // no leading zero limb
+};
+
+// Recursive descent over the grammar of Parser.h. Without storage it only
+// validates and counts what a StaticJson needs
+class StaticParser {
+public:
+
+    constexpr StaticParser(std::string_view source, StaticNode* nodes, char* strings) noexcept
+        : source_(source), nodes_(nodes), strings_(strings), current_(0), node_count_(0), string_bytes_(0) { }
+
+    constexpr void parse() {
+        skip_whitespace();
+        if (current_ == source_.size()) { invalid_json_literal("Empty string", current_); }
+        parse_element();
+        skip_whitespace();
+        if (current_ != source_.size()) { invalid_json_literal("Unexpected token after parsing element", current_); }
+    }
+
+    [[nodiscard]] constexpr auto node_count() const noexcept -> std::size_t { return node_count_; }
+    [[nodiscard]] constexpr auto string_bytes() const noexcept -> std::size_t { return string_bytes_; }
+
+private:
+
+    constexpr void skip_whitespace() noexcept {
+        while (current_ != source_.size()) {
+            auto const c = source_[current_];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') { break; }
+            ++current_;
+        }
+    }
+
+    [[nodiscard]] constexpr auto at_end() const noexcept -> bool { return current_ == source_.size(); }
+
+    // the next non-whitespace character, consumed when it is `c`
+    [[nodiscard]] constexpr auto match(char c) noexcept -> bool {
+        skip_whitespace();
+        if (at_end() || source_[current_] != c) { return false; }
+        ++current_;
+        return true;
+    }
+
+    [[nodiscard]] constexpr auto building() const noexcept -> bool { return nodes_ != nullptr; }
+
+    constexpr auto add_node(Type type) noexcept -> std::size_t {
+        auto const index = node_count_++;
+        if (building()) { nodes_[index].type = type; }
+        return index;
+    }
+
+    constexpr void parse_element() {
+        skip_whitespace();
+        if (at_end()) { invalid_json_literal("Expected a value", current_); }
+        auto const index = node_count_;
+        auto const c = source_[current_];
+        if      (c == '[') { parse_array(); }
+        else if (c == '{') { parse_object(); }
+        else if (c == '"') {
+            add_node(Type::String);
+            auto const string = parse_string();
+            if (building()) { nodes_[index].string = string; }
+        }
+        else if (c == '-' || ('0' <= c && c <= '9')) { parse_number(); }
+        else                                         { parse_literal(); }
+        if (building()) { nodes_[index].end = node_count_; }
+    }
+
+    constexpr void parse_literal() {
+        auto const rest = source_.substr(current_);
+        auto const index = add_node(Type::Null);
+        if (rest.substr(0, 4) == "null") {
+            current_ += 4;
+        } else if (rest.substr(0, 4) == "true" || rest.substr(0, 5) == "false") {
+            auto const value = rest[0] == 't';
+            current_ += value ? 4 : 5;
+            if (building()) {
+                nodes_[index].type = Type::Boolean;
+                nodes_[index].boolean = value;
+            }
+        } else {
+            invalid_json_literal("Invalid literal", current_);
+        }
+        // "nullx" is one invalid identifier for Scanner
+        if (not at_end() && is_identifier(source_[current_])) { invalid_json_literal("Invalid literal", current_); }
+    }
+
+    [[nodiscard]] static constexpr auto is_identifier(char c) noexcept -> bool {
+        return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || ('0' <= c && c <= '9') || c == '_';
+    }
+
+    constexpr void parse_array() {
+        auto const index = add_node(Type::Array);
+        ++current_;
+        std::size_t size = 0;
+        if (not match(']')) {
+            do {
+                parse_element();
+                ++size;
+            } while (match(','));
+            if (not match(']')) {
+                invalid_json_literal(at_end() ? "Need right bracket \"]\" to terminate an array"
+                                              : "Expected comma \",\" after element in array", current_);
+            }
+        }
+        if (building()) { nodes_[index].size = size; }
+    }
+
+    constexpr void parse_object() {
+        auto const index = add_node(Type::Object);
+        ++current_;
+        std::size_t size = 0;
+        if (not match('}')) {
+            do {
+                skip_whitespace();
+                if (at_end() || source_[current_] != '"') {
+                    invalid_json_literal("Key of object element must be a string", current_);
+                }
+                auto const key_offset = current_;
+                auto const key = parse_string();
+                if (building()) { check_duplicate(index, size, key, key_offset); }
+                if (not match(':')) {
+                    invalid_json_literal("Object must have a colon \":\" to separate a key-value pair", current_);
+                }
+                auto const member = node_count_;
+                parse_element();
+                if (building()) { nodes_[member].key = key; }
+                ++size;
+            } while (match(','));
+            if (not match('}')) {
+                invalid_json_literal(at_end() ? "Need right brace \"}\" to terminate an object"
+                                              : "Expected comma \",\" after element in object", current_);
+            }
+        }
+        if (building()) { nodes_[index].size = size; }
+    }
+
+    constexpr void check_duplicate(std::size_t object, std::size_t size, StaticString key, std::size_t offset) {
+        auto const text = [&](StaticString const& string) {
+            return string.decoded ? std::string_view(strings_ + string.offset, string.size)
+                                  : source_.substr(string.offset, string.size);
+        };
+        auto member = object + 1;
+        for (std::size_t position = 0; position != size; ++position) {
+            if (text(nodes_[member].key) == text(key)) {
+                current_ = offset;
+                invalid_json_literal("Duplicate key in object", current_);
+            }
+            member = nodes_[member].end;
+        }
+    }
+
+    // the string at current_, decoded into strings_ when it has escapes
+    [[nodiscard]] constexpr auto parse_string() -> StaticString {
+        auto const start = ++current_;
+        auto string = StaticString{ start, 0, false };
+        while (not at_end() && source_[current_] != '"' && source_[current_] != '\\') { ++current_; }
+        if (at_end()) {
+            current_ = start - 1;
+            invalid_json_literal("Unterminated string", current_);
+        }
+        if (source_[current_] == '"') {
+            string.size = current_ - start;
+            check_utf8(start, current_);
+            ++current_;
+            return string;
+        }
+
+        // escaped: the plain prefix, then runs and escape sequences
+        string = StaticString{ string_bytes_, 0, true };
+        append(source_.substr(start, current_ - start));
+        check_utf8(start, current_);
+        while (not at_end() && source_[current_] != '"') {
+            auto const run_start = current_;
+            if (source_[current_] == '\\') {
+                ++current_;
+                parse_escape();
+                continue;
+            }
+            while (not at_end() && source_[current_] != '"' && source_[current_] != '\\') { ++current_; }
+            append(source_.substr(run_start, current_ - run_start));
+            check_utf8(run_start, current_);
+        }
+        if (at_end()) {
+            current_ = start - 1;
+            invalid_json_literal("Unterminated string", current_);
+        }
+        ++current_;
+        string.size = string_bytes_ - string.offset;
+        return string;
+    }
+
+    constexpr void append(std::string_view text) noexcept {
+        if (building()) {
+            for (std::size_t i = 0; i != text.size(); ++i) { strings_[string_bytes_ + i] = text[i]; }
+        }
+        string_bytes_ += text.size();
+    }
+
+    constexpr void check_utf8(std::size_t begin, std::size_t end) {
+        for (auto i = begin; i < end; ) {
+            if (static_cast<unsigned char>(source_[i]) < 0x80) {
+                ++i;
+                continue;
+            }
+            auto const length = utf8_sequence_length(source_.substr(0, end), i);
+            if (length == 0) {
+                current_ = i;
+                invalid_json_literal("Invalid UTF-8 in string", current_);
+            }
+            i += length;
+        }
+    }
+
+    constexpr void parse_escape() {
+        if (at_end()) { invalid_json_literal("Unterminated string", current_); }
+        char decoded[4] = {};
+        auto const c = source_[current_++];
+        switch (c) {
+        case '\\': append("\\"); return;
+        case '"':  append("\"");  return;
+        case '/':  append("/");  return;
+        case 'b':  append("\b"); return;
+        case 'f':  append("\f"); return;
+        case 'n':  append("\n"); return;
+        case 'r':  append("\r"); return;
+        case 't':  append("\t"); return;
+        case 'u': {
+            auto code_point = parse_hex_digits();
+            if (is_high_surrogate(code_point)) {
+                if (source_.substr(current_, 2) != "\\u") {
+                    invalid_json_literal("Unpaired surrogate in \\u escape", current_);
+                }
+                current_ += 2;
+                auto const low = parse_hex_digits();
+                if (not is_low_surrogate(low)) { invalid_json_literal("Unpaired surrogate in \\u escape", current_); }
+                code_point = combine_surrogates(code_point, low);
+            } else if (is_low_surrogate(code_point)) {
+                invalid_json_literal("Unpaired surrogate in \\u escape", current_);
+            }
+            append({ decoded, encode_utf8(code_point, decoded) });
+            return;
+        }
+        default:
+            --current_;
+            invalid_json_literal("Invalid escape character", current_);
+        }
+    }
+
+    [[nodiscard]] constexpr auto parse_hex_digits() -> char32_t {
+        char32_t value = 0;
+        for (auto i = 0; i < 4; ++i) {
+            if (at_end()) { invalid_json_literal("Unterminated string", current_); }
+            auto const digit = hex_digit_value(source_[current_]);
+            if (digit < 0) {
+                invalid_json_literal("Escape hex-code character can only be in [0, 9] or [a, f] or [A, F]", current_);
+            }
+            value = (value << 4) | static_cast<char32_t>(digit);
+            ++current_;
+        }
+        return value;
+    }
+
+    // The number grammar of Number.h, integers kept exact like parse_number
+    constexpr void parse_number() {
+        constexpr long exponent_limit = 100'000;
+        auto const index = add_node(Type::Number);
+        auto const start = current_;
+        auto const digit_at = [&](std::size_t i) {
+            return i < source_.size() && '0' <= source_[i] && source_[i] <= '9';
+        };
+
+        auto const negative = source_[current_] == '-';
+        if (negative) { ++current_; }
+        if (not digit_at(current_)) { invalid_json_literal("Invalid number", current_); }
+
+        // the digits as an integer while it fits, the power of ten scaling it
+        // and the position of the decimal point relative to the first digit
+        std::uint64_t mantissa = 0;
+        bool truncated = false;
+        long exponent = 0;
+        long magnitude = 0;
+        auto const add_digit = [&](char c) {
+            auto const digit = static_cast<std::uint64_t>(c - '0');
+            if (mantissa >= 1'000'000'000'000'000'000u
+                && mantissa > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+                truncated = true;
+                return false;
+            }
+            mantissa = mantissa * 10 + digit;
+            return true;
+        };
+
+        if (source_[current_] == '0') {
+            ++current_;
+            if (digit_at(current_)) { invalid_json_literal("Invalid number", current_); }
+        } else {
+            for (; digit_at(current_); ++current_) {
+                if (truncated || not add_digit(source_[current_])) { ++exponent; }
+                ++magnitude;
+            }
+        }
+
+        auto is_integer = true;
+        if (current_ < source_.size() && source_[current_] == '.') {
+            is_integer = false;
+            ++current_;
+            if (not digit_at(current_)) { invalid_json_literal("Invalid number", current_); }
+            for (; digit_at(current_); ++current_) {
+                if (not truncated && add_digit(source_[current_])) { --exponent; }
+                if (mantissa == 0) { --magnitude; }
+            }
+        }
+
+        if (current_ < source_.size() && (source_[current_] == 'e' || source_[current_] == 'E')) {
+            is_integer = false;
+            ++current_;
+            auto const negative_exponent = current_ < source_.size() && source_[current_] == '-';
+            if (current_ < source_.size() && (source_[current_] == '-' || source_[current_] == '+')) { ++current_; }
+            if (not digit_at(current_)) { invalid_json_literal("Invalid number", current_); }
+            long written = 0;
+            for (; digit_at(current_); ++current_) {
+                if (written < exponent_limit) { written = written * 10 + (source_[current_] - '0'); }
+            }
+            exponent += negative_exponent ? -written : written;
+            magnitude += negative_exponent ? -written : written;
+        }
+        // "1x" or "1-2" are one invalid number for Scanner
+        if (current_ < source_.size() && (is_identifier(source_[current_]) || source_[current_] == '.'
+                                          || source_[current_] == '+' || source_[current_] == '-')) {
+            invalid_json_literal("Invalid number", current_);
+        }
+
+        auto node = StaticNode{};
+        node.type = Type::Number;
+        constexpr auto int_max = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+        if (is_integer && not truncated && not negative && mantissa <= int_max) {
+            node.integer = static_cast<std::int64_t>(mantissa);
+        } else if (is_integer && not truncated && not negative) {
+            node.kind = Number::Kind::UInt;
+            node.unsigned_integer = mantissa;
+        } else if (is_integer && not truncated && mantissa != 0 && mantissa <= int_max + 1) {
+            // -(int_max + 1) does not fit in an int64_t before the negation
+            node.integer = -static_cast<std::int64_t>(mantissa - 1) - 1;
+        } else {
+            // also "-0", a Double to keep its sign. Out of range is checked when counting too
+            node.kind = Number::Kind::Double;
+            auto const value = to_double(mantissa, magnitude, exponent, start);
+            node.number = negative ? -value : value;
+        }
+        if (building()) { nodes_[index] = node; }
+    }
+
+    // mantissa * 10^exponent, `magnitude` being the position of the decimal
+    // point relative to the first significant digit
+    [[nodiscard]] constexpr auto to_double(std::uint64_t mantissa, long magnitude, long exponent,
+                                           std::size_t start) -> double {
+        if (mantissa == 0 || magnitude < -330) { return 0.0; }
+        if (magnitude > 310) {
+            current_ = start;
+            invalid_json_literal("Number is out of the range of a double", current_);
+        }
+        // Clinger's fast path, exact like parse_number
+        if (mantissa <= (std::uint64_t{1} << 53) && -22 <= exponent && exponent <= 22) {
+            auto const value = static_cast<double>(mantissa);
+            return exponent < 0 ? value / exact_powers[-exponent] : value * exact_powers[exponent];
+        }
+
+        // The estimate as m * 2^q, m of 53 bits unless subnormal, moved to a
+        // neighbour while the number is past the halfway point to it, ties
+        // going to the even m
+        constexpr auto hidden_bit = std::uint64_t{1} << 52;
+        constexpr auto max_mantissa = 2 * hidden_bit - 1;
+        constexpr long min_exponent = -1074;
+        constexpr long max_exponent = 971;
+        auto count = 0L;
+        auto const digits = significant_digits(start, count);
+        auto const scale = magnitude - count;
+        std::uint64_t m = 0;
+        long q = 0;
+        estimate(mantissa, exponent, m, q);
+        for (;;) {
+            auto const up_m = m == max_mantissa ? hidden_bit : m + 1;
+            auto const up_q = m == max_mantissa ? q + 1 : q;
+            auto const above = compare_exact(digits, scale, m + (up_m << (up_q - q)), q - 1);
+            if (above > 0 || (above == 0 && up_m % 2 == 0)) {
+                if (up_q > max_exponent) {
+                    current_ = start;
+                    invalid_json_literal("Number is out of the range of a double", current_);
+                }
+                m = up_m;
+                q = up_q;
+                continue;
+            }
+            if (m == 0) { break; }
+            auto const down_m = m == hidden_bit && q > min_exponent ? max_mantissa : m - 1;
+            auto const down_q = m == hidden_bit && q > min_exponent ? q - 1 : q;
+            auto const below = compare_exact(digits, scale, (m << (q - down_q)) + down_m, down_q - 1);
+            if (below < 0 || (below == 0 && down_m % 2 == 0)) {
+                m = down_m;
+                q = down_q;
+                continue;
+            }
+            break;
+        }
+        // exact in every step, m * 2^q being a double
+        auto value = static_cast<double>(m);
+        for (; q > 0; --q) { value *= 2; }
+        for (; q < 0; ++q) { value /= 2; }
+        return value;
+    }
+
+    // mantissa * 10^exponent scaled in long double, as m * 2^q within a few
+    // units in the last place. Clamped to the largest double when beyond
+    static constexpr void estimate(std::uint64_t mantissa, long exponent, std::uint64_t& m, long& q) {
+        auto scaled = static_cast<long double>(mantissa);
+        for (; exponent > 0; exponent -= exponent < 22 ? exponent : 22) {
+            scaled *= exact_powers[exponent < 22 ? exponent : 22];
+        }
+        for (; exponent < 0; exponent += -exponent < 22 ? -exponent : 22) {
+            scaled /= exact_powers[-exponent < 22 ? -exponent : 22];
+        }
+        // also where long double is double and the product overflowed
+        if (not (scaled <= static_cast<long double>(std::numeric_limits<double>::max()))) {
+            m = (std::uint64_t{1} << 53) - 1;
+            q = 971;
+            return;
+        }
+        q = 0;
+        for (; scaled >= 0x1p53L; scaled /= 2) { ++q; }
+        for (; scaled < 0x1p52L && q > -1074; scaled *= 2) { --q; }
+        m = static_cast<std::uint64_t>(scaled);
+    }
+
+    // The significant digits of the number at `start` and their count, at
+    // most max_digits of them and then a 1 for any non-zero digit dropped.
+    // A halfway point between doubles has at most 767 significant digits,
+    // so one between the kept digits and the number would be a kept one
+    [[nodiscard]] constexpr auto significant_digits(std::size_t start, long& count) const -> StaticBigInt {
+        constexpr long max_digits = 780;
+        auto digits = StaticBigInt(0);
+        auto dropped = false;
+        for (auto i = start; i < source_.size(); ++i) {
+            auto const c = source_[i];
+            if (c == '-' || c == '.') { continue; }
+            if (c < '0' || '9' < c) { break; }
+            if (count == 0 && c == '0') { continue; }
+            if (count < max_digits) {
+                digits.multiply_add(10, static_cast<std::uint32_t>(c - '0'));
+                ++count;
+            } else if (c != '0') {
+                dropped = true;
+            }
+        }
+        if (dropped) {
+            digits.multiply_add(10, 1);
+            ++count;
+        }
+        return digits;
+    }
+
+    // the sign of digits * 10^scale - halfway * 2^binary_exponent
+    [[nodiscard]] static constexpr auto compare_exact(StaticBigInt digits, long scale, std::uint64_t halfway,
+                                                      long binary_exponent) -> int {
+        auto other = StaticBigInt(halfway);
+        if (scale >= 0) { digits.multiply_power_of_5(scale); }
+        else            { other.multiply_power_of_5(-scale); }
+        auto const shift = scale - binary_exponent;
+        if (shift > 0) { digits.shift_left(shift); }
+        else           { other.shift_left(-shift); }
+        return digits.compare(other);
+    }
+
+    static constexpr double exact_powers[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+private:
+
+    std::string_view source_;
+    StaticNode* nodes_;
+    char* strings_;
+    std::size_t current_;
+    std::size_t node_count_;
+    std::size_t string_bytes_;
+};
+
+} // namespace detail
+
+// The number of values of the JSON text `source`, a compile-time error when
+// it is not valid JSON
+[[nodiscard]] constexpr auto static_node_count(std::string_view source) -> std::size_t {
+    auto parser = detail::StaticParser(source, nullptr, nullptr);
+    parser.parse();
+    return parser.node_count();
+}
+
+// The bytes the escaped strings of `source` take decoded
+[[nodiscard]] constexpr auto static_string_bytes(std::string_view source) -> std::size_t {
+    auto parser = detail::StaticParser(source, nullptr, nullptr);
+    parser.parse();
+    return parser.string_bytes();
+}
+
+// Parses `source` into a StaticJson, whose sizes must be those computed by
+// static_node_count and static_string_bytes
+template <std::size_t Nodes, std::size_t Bytes>
+[[nodiscard]] constexpr auto parse_static(std::string_view source) -> StaticJson<Nodes, Bytes> {
+    auto json = StaticJson<Nodes, Bytes>();
+    json.source_ = source;
+    auto parser = detail::StaticParser(source, json.nodes_.data(), json.strings_.data());
+    parser.parse();
+    return json;
+}
+
+} // namespace json
+
+// The StaticJson of a string literal, parsed at compile time when used to
+// initialize a constexpr variable
+#define JSON_PARSER_STATIC(literal)                                                 \
+    ::json::parse_static<::json::static_node_count(literal),                        \
+                         ::json::static_string_bytes(literal)>(literal)
@@ -0,0 +1,226 @@
+#pragma once
+
+#include "JsonValue.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace json {
+
+/*
+Binary form of a Json tree that is read in place, without deserializing.
+The encoding is one buffer:
+    header  magic, version, byte order, tape size in words, pool size in bytes
+    tape    64-bit words, the root node first
+    pool    string bytes, short strings (most keys) stored once
+A node starts with a tag word: its Type in the top 8 bits and a payload below.
+    null, boolean   [tag | value]
+    number          [tag | Number::Kind] [bits of the int64, uint64 or double]
+    string          [tag | length] [pool offset]
+    array           [tag | count] [tape index of each element] elements...
+    object          [tag | count] [tape index of each member]
+                    [member positions sorted by key, above JsonObject::index_threshold]
+                    members, each a key string node followed by its value
+Tables of child positions make an element or a member O(1) to reach, and a
+large object is searched by binary search instead of a scan. Numbers and
+words are in the byte order of the writer; loading a tape written with
+another byte order throws.
+
+Loading a tape file maps it, so only the pages that are accessed are ever
+read from disk.
+*/
+struct TapeStorage;
+
+class TapeArray;
+class TapeObject;
+
+// Read-only view of one node, with the accessors of Json.
+// Valid as long as a TapeDocument holding its storage is alive
+class TapeValue {
+public:
+
+    [[nodiscard]] auto type() const -> Type;
+    [[nodiscard]] auto is_null()   const -> bool;
+    [[nodiscard]] auto is_bool()   const -> bool;
+    [[nodiscard]] auto is_number() const -> bool;
+    [[nodiscard]] auto is_string() const -> bool;
+    [[nodiscard]] auto is_array()  const -> bool;
+    [[nodiscard]] auto is_object() const -> bool;
+
+    // throw a JsonException on a value of another type, like Json
+    [[nodiscard]] auto boolean() const -> bool;
+    [[nodiscard]] auto number()  const -> double;
+    [[nodiscard]] auto is_integer() const -> bool;
+    [[nodiscard]] auto number_kind() const -> Number::Kind;
+    [[nodiscard]] auto integer() const -> std::int64_t;
+    [[nodiscard]] auto unsigned_integer() const -> std::uint64_t;
+    [[nodiscard]] auto string()  const -> std::string_view;
+    [[nodiscard]] auto array()   const -> TapeArray;
+    [[nodiscard]] auto object()  const -> TapeObject;
+
+    // a heap allocated copy of the subtree
+    [[nodiscard]] auto to_json() const -> Json;
+
+private:
+
+    friend class TapeArray;
+    friend class TapeObject;
+    friend class TapeDocument;
+
+    TapeValue(TapeStorage const* storage, std::size_t index) noexcept;
+
+    [[nodiscard]] auto tag() const -> std::uint64_t;
+    [[nodiscard]] auto as_number() const -> Number;
+    void expect(Type type) const;
+
+private:
+
+    TapeStorage const* storage_;
+    std::size_t index_;
+};
+
+// Position based iterator of TapeArray and TapeObject, dereferences by value.
+// It holds a copy of the view, so like a TapeValue it is valid as long as
+// the document is, not only as long as the view it came from
+template <typename Container>
+class TapeIterator {
+public:
+
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = typename Container::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = value_type;
+
+    TapeIterator(Container container, std::size_t position) noexcept
+        : container_(container), position_(position) { }
+
+    auto operator*() const -> value_type { return container_.value_at(position_); }
+
+    auto operator++() -> TapeIterator& {
+        ++position_;
+        return *this;
+    }
+    auto operator++(int) -> TapeIterator {
+        auto const copy = *this;
+        ++position_;
+        return copy;
+    }
+
+    auto operator==(TapeIterator const& other) const noexcept -> bool { return position_ == other.position_; }
+    auto operator!=(TapeIterator const& other) const noexcept -> bool { return position_ != other.position_; }
+
+    [[nodiscard]] auto position() const noexcept -> std::size_t { return position_; }
+
+private:
+
+    Container container_;
+    std::size_t position_;
+};
+
+class TapeArray {
+public:
+
+    using value_type     = TapeValue;
+    using const_iterator = TapeIterator<TapeArray>;
+
+    [[nodiscard]] auto size()  const noexcept -> std::size_t;
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    [[nodiscard]] auto operator[](std::size_t index) const -> TapeValue;
+    // throws std::out_of_range, like std::vector
+    [[nodiscard]] auto at(std::size_t index) const -> TapeValue;
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator;
+    [[nodiscard]] auto end()   const noexcept -> const_iterator;
+
+private:
+
+    friend class TapeValue;
+    friend class TapeIterator<TapeArray>;
+
+    TapeArray(TapeStorage const* storage, std::size_t index, std::size_t size) noexcept;
+
+    [[nodiscard]] auto value_at(std::size_t position) const -> TapeValue;
+
+private:
+
+    TapeStorage const* storage_;
+    std::size_t index_;
+    std::size_t size_;
+};
+
+class TapeObject {
+public:
+
+    using value_type     = std::pair<std::string_view, TapeValue>;
+    using const_iterator = TapeIterator<TapeObject>;
+
+    [[nodiscard]] auto size()  const noexcept -> std::size_t;
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    // members in insertion order
+    [[nodiscard]] auto begin() const noexcept -> const_iterator;
+    [[nodiscard]] auto end()   const noexcept -> const_iterator;
+
+    [[nodiscard]] auto find(std::string_view key) const -> const_iterator;
+    [[nodiscard]] auto count(std::string_view key) const -> std::size_t;
+
+    // throws std::out_of_range when the key does not exist, like JsonObject
+    [[nodiscard]] auto at(std::string_view key) const -> TapeValue;
+
+private:
+
+    friend class TapeValue;
+    friend class TapeIterator<TapeObject>;
+
+    TapeObject(TapeStorage const* storage, std::size_t index, std::size_t size) noexcept;
+
+    [[nodiscard]] auto value_at(std::size_t position) const -> value_type;
+    [[nodiscard]] auto key_at(std::size_t member) const -> std::string_view;
+    [[nodiscard]] auto find_position(std::string_view key) const -> std::size_t;
+
+private:
+
+    TapeStorage const* storage_;
+    std::size_t index_;
+    std::size_t size_;
+};
+
+// An encoded tape and its owner, see encode_tape and load_tape
+class TapeDocument {
+public:
+
+    // throws a JsonException when `tape` is not an encoded tape
+    explicit TapeDocument(std::string tape);
+
+    [[nodiscard]] auto root() const -> TapeValue;
+    [[nodiscard]] auto size_bytes() const noexcept -> std::size_t;
+
+private:
+
+    friend auto load_tape(std::string const& path) -> TapeDocument;
+
+    explicit TapeDocument(std::shared_ptr<TapeStorage const> storage) noexcept;
+
+private:
+
+    // shared so values stay valid across moves of the document
+    std::shared_ptr<TapeStorage const> storage_;
+};
+
+[[nodiscard]] auto encode_tape(Json const& json) -> std::string;
+
+// Writes the encoding of `json` to `path`. Throws std::system_error
+void save_tape(Json const& json, std::string const& path);
+
+// Maps the tape file at `path`; only its header is read up front. Throws
+// std::system_error when the file cannot be read and a JsonException when
+// it is not a tape
+[[nodiscard]] auto load_tape(std::string const& path) -> TapeDocument;
+
+} // namespace json
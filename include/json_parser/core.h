@@ -1,10 +1,88 @@
 #pragma once
 
 #include "JsonValue.h" // Json struct and JsonException
+#include "Document.h"
+#include "ParseError.h"
+#include "PushParser.h"
+#include "NdJson.h"
+#include "ParallelParser.h"
+#include "Serializer.h"
+#include "Binding.h"
+#include "StaticJson.h"
+#include "JsonSchema.h"
+#include "LazyDocument.h"
+#include "JsonPath.h"
+#include "Tape.h"
+#include "KeyDictionary.h"
+#include "ParseStats.h"
+#include "ParserContext.h"
+#include "detail/Parser.h"
+#include "detail/Instrumentation.h"
 #include <string>
+#include <string_view>
 
 namespace json {
 
 auto parse_string(std::string const& source) -> Json;
 
-} // namespace json
\ No newline at end of file
+// Same as parse_string without exceptions: a syntax error or a duplicate key
+// is returned as a ParseError, a code and an offset whose message is only
+// built on request. Running out of memory still throws std::bad_alloc, here
+// terminating. Usable from code built with -fno-exceptions
+[[nodiscard]] auto try_parse(std::string_view source) noexcept -> ParseResult<Json>;
+
+// Same as parse_string but the whole tree is allocated in the document's arena
+auto parse_document(std::string const& source) -> Document;
+
+// Same as parse_string and parse_document with the object keys interned in
+// `keys`, see KeyDictionary. The dictionary must outlive the result
+auto parse_string(std::string const& source, KeyDictionary& keys) -> Json;
+auto parse_document(std::string const& source, KeyDictionary& keys) -> Document;
+
+// Same as parse_string and parse_document, instrumented: `stats` receives
+// the timings and counts of the parse, see ParseStats. parse_string allocates
+// the tree from the heap, through a resource counting the allocations
+auto parse_string(std::string const& source, ParseStats& stats) -> Json;
+auto parse_document(std::string const& source, ParseStats& stats) -> Document;
+
+// Same as parse_document but string values without escape sequences reference
+// `source` instead of being copied; escaped ones and keys are stored in the
+// arena. `source` must stay alive and unmodified for the document's lifetime,
+// either by the caller or by passing its owner, which the document keeps:
+//     auto owned = std::make_shared<std::string const>(std::move(text));
+//     auto doc   = parse_document_in_situ(*owned, owned);
+auto parse_document_in_situ(std::string_view source,
+                            std::shared_ptr<void const> owner = nullptr) -> Document;
+
+// Parses the file at `path` in situ. Regular files are memory mapped and the
+// document keeps the mapping alive, so unescaped strings reference the file's
+// pages instead of being copied; other files such as pipes are read into
+// memory first. Throws std::system_error when the file cannot be read
+auto parse_file(std::string const& path) -> Document;
+
+// Reports the values of `source` to `handler` as they are parsed instead of
+// building a Json, see Parser in detail/Parser.h for the handler interface.
+// Returns false when a handler callback stopped the parse
+template <typename Handler>
+auto parse_sax(std::string_view source, Handler& handler) -> bool {
+    return Parser<Handler>(Scanner(source), handler).parse();
+}
+
+// Same as parse_sax with syntax errors returned instead of thrown, the value
+// being false when a handler callback stopped the parse
+template <typename Handler>
+auto try_parse_sax(std::string_view source, Handler& handler) -> ParseResult<bool> {
+    auto parser = Parser<Handler>(Scanner(source), handler, ErrorMode::Report);
+    auto const completed = parser.parse();
+    if (parser.error()) { return parser.error(); }
+    return completed;
+}
+
+// Same as parse_sax, instrumented: `stats` receives the timings and counts of
+// the parse, build_time being the time spent in `handler`
+template <typename Handler>
+auto parse_sax(std::string_view source, Handler& handler, ParseStats& stats) -> bool {
+    return parse_with_stats(source, handler, stats, [](auto const&) { });
+}
+
+} // namespace json
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "json_parser/JsonValue.h"
+#include "json_parser/ParseError.h"
+#include "json_parser/KeyDictionary.h"
+#include "json_parser/ParseStats.h"
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace json {
+
+// How string values reach the built Json
+enum class StringMode : std::uint8_t {
+    Copy,       // allocated from the builder's resource
+    Borrow,     // referenced when they are a slice of the source, which must outlive the Json
+};
+
+// Parser handler building a Json whose containers and strings are allocated from `resource`.
+// With a KeyDictionary, object keys are interned there instead, see KeyDictionary.h
+class DomBuilder {
+public:
+
+    DomBuilder(std::string_view source,
+               std::pmr::memory_resource* resource,
+               StringMode string_mode = StringMode::Copy,
+               KeyDictionary* keys = nullptr);
+
+    auto on_null() -> bool;
+    auto on_bool(bool value) -> bool;
+    auto on_number(double value) -> bool;
+    auto on_integer(std::int64_t value) -> bool;
+    auto on_unsigned(std::uint64_t value) -> bool;
+    auto on_string(std::string_view value) -> bool;
+    // returns false on a duplicate key, see duplicate_key()
+    auto on_key(std::string_view key) -> bool;
+    auto on_start_object() -> bool;
+    auto on_end_object() -> bool;
+    auto on_start_array() -> bool;
+    auto on_end_array() -> bool;
+
+    // Starts over on `source` like a new builder, keeping the capacity of
+    // the container stack. The previous result must have been taken
+    void reset(std::string_view source,
+               std::pmr::memory_resource* resource,
+               StringMode string_mode = StringMode::Copy,
+               KeyDictionary* keys = nullptr) noexcept;
+
+    // Drops the partial result of a failed parse without destroying it, for
+    // an arena about to release its memory at once. reset() would destroy
+    // containers whose memory is gone
+    void abandon() noexcept;
+
+    [[nodiscard]] auto duplicate_key() const noexcept -> std::string_view;
+    [[nodiscard]] auto result() && -> Json;
+
+private:
+
+    // adds a complete value to the innermost open container
+    auto add(Json value) -> bool;
+
+private:
+
+    std::string_view source_;
+    std::pmr::memory_resource* resource_;
+    StringMode string_mode_;
+    KeyDictionary* keys_;
+    // containers being built, innermost last. An open object always ends
+    // with the member whose key was seen last, its value still null
+    std::vector<Json> open_;
+    std::string_view duplicate_key_;
+    Json result_;
+};
+
+// Parses `source` into a Json, see DomBuilder. With `stats` the parse is
+// instrumented, see ParseStats.h, and allocations through `resource` are
+// counted when it is a CountingResource
+[[nodiscard]] auto build_dom(std::string_view source,
+                             std::pmr::memory_resource* resource,
+                             StringMode string_mode = StringMode::Copy,
+                             KeyDictionary* keys = nullptr,
+                             ParseStats* stats = nullptr) -> Json;
+
+// Same as build_dom in ErrorMode::Report: errors, a duplicate key included,
+// are returned instead of thrown
+[[nodiscard]] auto try_build_dom(std::string_view source,
+                                 std::pmr::memory_resource* resource) -> ParseResult<Json>;
+
+} // namespace json
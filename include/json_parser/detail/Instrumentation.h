@@ -0,0 +1,264 @@
+#pragma once
+
+#include "json_parser/ParseStats.h"
+#include "Number.h"
+#include "Parser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+
+namespace json {
+
+struct AllocationCounts {
+    std::size_t allocations = 0;
+    std::size_t bytes = 0;
+};
+
+// Totals of every CountingResource on the calling thread
+[[nodiscard]] auto thread_allocation_counts() noexcept -> AllocationCounts;
+
+// Forwards to `upstream`, counting allocations in thread_allocation_counts()
+class CountingResource final : public std::pmr::memory_resource {
+public:
+
+    explicit CountingResource(std::pmr::memory_resource* upstream) noexcept;
+
+    // wraps the heap, it lives as long as the program so trees built with it may too
+    [[nodiscard]] static auto heap() -> CountingResource*;
+
+private:
+
+    auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override;
+
+private:
+
+    std::pmr::memory_resource* upstream_;
+};
+
+/*
+Adds up the time calls take, in ticks of ticks(). Reading a clock around
+every token would take longer than scanning it, so past the first
+exact_calls one call in about `period` is timed, at random so that the
+samples do not follow the structure of the document, and counts for
+`period` calls. The time reading the ticks takes is taken off each sample.
+*/
+class PhaseTimer {
+public:
+
+    static constexpr std::size_t exact_calls = 64;
+    static constexpr std::uint32_t period = 32;
+
+    // The time stamp counter where there is one: unlike steady_clock, which
+    // waits for the work before it, it leaves the calls overlapping as they
+    // do untimed. Elsewhere the nanoseconds of steady_clock
+    [[nodiscard]] static auto ticks() noexcept -> std::uint64_t {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        return __builtin_ia32_rdtsc();
+#else
+        auto const now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+#endif
+    }
+
+    template <typename Call>
+    auto operator()(Call const& call) -> decltype(call()) {
+        static auto const overhead = ticks_overhead();
+        auto weight = std::uint64_t{1};
+        if (calls_ < exact_calls) {
+            ++calls_;
+        } else {
+            // xorshift32
+            state_ ^= state_ << 13;
+            state_ ^= state_ >> 17;
+            state_ ^= state_ << 5;
+            if (state_ % period != 0) { return call(); }
+            weight = period;
+        }
+        auto const start = ticks();
+        auto result = call();
+        auto const elapsed = ticks() - start;
+        total_ += (elapsed > overhead ? elapsed - overhead : 0) * weight;
+        return result;
+    }
+
+    // the ticks of every call so far, estimated
+    [[nodiscard]] auto total() const noexcept -> std::uint64_t {
+        return total_;
+    }
+
+private:
+
+    // the least ticks measured around nothing
+    [[nodiscard]] static auto ticks_overhead() noexcept -> std::uint64_t;
+
+    std::size_t calls_ = 0;
+    std::uint32_t state_ = 0x9E3779B9;
+    std::uint64_t total_ = 0;
+};
+
+// What a CountingScanner counts tokens and escapes into
+struct ScanStatistics {
+    ParseStats& stats;
+    PhaseTimer timer;   // of Scanner::next_token()
+
+    // `token` was scanned from `source`
+    void count(Token const& token, std::string_view source);
+};
+
+// The token source of parse_with_stats: a Scanner whose tokens are timed and
+// counted into `statistics`. Parsers over a plain Scanner are compiled
+// without any of this
+class CountingScanner {
+public:
+
+    CountingScanner(Scanner scanner, ScanStatistics& statistics) noexcept
+        : scanner_(std::move(scanner)), statistics_(statistics) { }
+
+    [[nodiscard]] auto next_token() -> Token {
+        auto token = statistics_.timer([this] { return scanner_.next_token(); });
+        statistics_.count(token, scanner_.source());
+        return token;
+    }
+
+    [[nodiscard]] auto source() const -> std::string_view {
+        return scanner_.source();
+    }
+    void set_error_mode(ErrorMode mode) noexcept {
+        scanner_.set_error_mode(mode);
+    }
+    [[nodiscard]] auto error() const noexcept -> ParseError const& {
+        return scanner_.error();
+    }
+    [[nodiscard]] auto release_scratch() noexcept -> Scanner::Scratch {
+        return scanner_.release_scratch();
+    }
+
+private:
+
+    Scanner scanner_;
+    ScanStatistics& statistics_;
+};
+
+// defined in Parser.cpp
+extern template class BasicParserBase<CountingScanner>;
+
+// Forwards every event to `handler`, counting values and depth into `stats`
+// and timing the handler
+template <typename Handler>
+class StatsHandler {
+public:
+
+    StatsHandler(Handler& handler, ParseStats& stats) noexcept
+        : handler_(handler), stats_(stats), timer_(), depth_(0) { }
+
+    auto on_null() -> bool           { return timed([&] { return handler_.on_null(); }); }
+    auto on_bool(bool value) -> bool { return timed([&] { return handler_.on_bool(value); }); }
+    auto on_number(double value) -> bool {
+        ++stats_.numbers;
+        return timed([&] { return handler_.on_number(value); });
+    }
+    auto on_integer(std::int64_t value) -> bool {
+        ++stats_.numbers;
+        ++stats_.integers;
+        return timed([&] { return report_number(handler_, Number::from(value)); });
+    }
+    auto on_unsigned(std::uint64_t value) -> bool {
+        ++stats_.numbers;
+        ++stats_.integers;
+        return timed([&] { return report_number(handler_, Number::from(value)); });
+    }
+    auto on_string(std::string_view value) -> bool {
+        ++stats_.strings;
+        return timed([&] { return handler_.on_string(value); });
+    }
+    auto on_key(std::string_view key) -> bool {
+        ++stats_.keys;
+        return timed([&] { return handler_.on_key(key); });
+    }
+    auto on_start_object() -> bool {
+        enter();
+        return timed([&] { return handler_.on_start_object(); });
+    }
+    auto on_end_object() -> bool {
+        --depth_;
+        return timed([&] { return handler_.on_end_object(); });
+    }
+    auto on_start_array() -> bool {
+        enter();
+        return timed([&] { return handler_.on_start_array(); });
+    }
+    auto on_end_array() -> bool {
+        --depth_;
+        return timed([&] { return handler_.on_end_array(); });
+    }
+
+    [[nodiscard]] auto timer() const noexcept -> PhaseTimer const& {
+        return timer_;
+    }
+
+private:
+
+    void enter() noexcept {
+        ++depth_;
+        stats_.max_depth = std::max(stats_.max_depth, depth_);
+    }
+
+    template <typename Event>
+    auto timed(Event const& event) -> bool {
+        return timer_(event);
+    }
+
+private:
+
+    Handler& handler_;
+    ParseStats& stats_;
+    PhaseTimer timer_;
+    std::size_t depth_;
+};
+
+/*
+Parses `source` into `handler` in one pass and fills `stats`, see
+ParseStats.h. When the handler stops the parse, `stopped` is called with
+the parser before returning false, so it can fail() on the last token
+*/
+template <typename Handler, typename Stopped>
+auto parse_with_stats(std::string_view source, Handler& handler, ParseStats& stats, Stopped&& stopped) -> bool {
+    using clock = std::chrono::steady_clock;
+    using duration = ParseStats::duration;
+
+    stats = ParseStats{};
+    stats.bytes = source.size();
+
+    auto const start = clock::now();
+    auto const start_ticks = PhaseTimer::ticks();
+    auto statistics = ScanStatistics{ stats, PhaseTimer() };
+    auto counting = StatsHandler<Handler>(handler, stats);
+    auto parser = Parser<StatsHandler<Handler>, CountingScanner>(CountingScanner(Scanner(source), statistics), counting);
+    auto const before = thread_allocation_counts();
+    auto const parsed = parser.parse();
+    auto const after = thread_allocation_counts();
+    auto const total = std::chrono::duration_cast<duration>(clock::now() - start);
+    auto const total_ticks = PhaseTimer::ticks() - start_ticks;
+
+    stats.allocations = after.allocations - before.allocations;
+    stats.allocated_bytes = after.bytes - before.bytes;
+
+    // the scanner and the handler are timed, the grammar is the rest
+    auto const to_duration = [&](std::uint64_t ticks) {
+        auto const share = total_ticks == 0 ? 0.0 : static_cast<double>(ticks) / static_cast<double>(total_ticks);
+        return std::min(duration(static_cast<duration::rep>(share * static_cast<double>(total.count()))), total);
+    };
+    stats.scan_time = to_duration(statistics.timer.total());
+    stats.build_time = std::min(to_duration(counting.timer().total()), total - stats.scan_time);
+    stats.parse_time = total - stats.scan_time - stats.build_time;
+
+    if (not parsed) { stopped(static_cast<BasicParserBase<CountingScanner> const&>(parser)); }
+    return parsed;
+}
+
+} // namespace json
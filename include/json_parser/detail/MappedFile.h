@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace json {
+
+/*
+Read-only contents of a file. Regular files are memory mapped, so the pages
+are only read in as the parser reaches them and are never copied; the kernel
+is told how the mapping will be read, see Access.
+Anything that cannot be mapped (pipes, character devices, files reporting
+no size like most of /proc) is read into memory instead.
+*/
+class MappedFile {
+public:
+
+    enum class Access : std::uint8_t {
+        Sequential, // front to back, read ahead aggressively
+        Random,     // scattered lookups, read only the pages touched
+    };
+
+    // throws std::system_error when the file cannot be opened or read
+    explicit MappedFile(std::string const& path, Access access = Access::Sequential);
+    ~MappedFile();
+
+    // contents() would dangle in a copy or a moved-from object
+    MappedFile(MappedFile const&) = delete;
+    auto operator=(MappedFile const&) -> MappedFile& = delete;
+
+    [[nodiscard]] auto contents() const noexcept -> std::string_view;
+    [[nodiscard]] auto is_mapped() const noexcept -> bool;
+
+private:
+
+    void read_all(int fd, std::string const& path);
+
+private:
+
+    void* mapping_;
+    std::size_t size_;
+    // the fallback copy when the file is not mapped
+    std::string buffer_;
+};
+
+} // namespace json
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace json {
+
+/*
+A decoded JSON number. Integers, numbers without a fraction or an exponent,
+are kept exact when they fit in 64 bits: as Int when they fit in an int64_t,
+as UInt when only an uint64_t holds them. Anything else is a Double, the
+nearest one to the text. "-0" is the Double -0.0 so it keeps its sign.
+*/
+struct Number {
+    enum class Kind : std::uint8_t {
+        Int,
+        UInt,
+        Double,
+    };
+
+    Kind kind;
+    union {
+        std::int64_t  i;
+        std::uint64_t u;
+        double        d;
+    };
+
+    [[nodiscard]] static auto from(std::int64_t value)  noexcept -> Number;
+    [[nodiscard]] static auto from(std::uint64_t value) noexcept -> Number;
+    [[nodiscard]] static auto from(double value)        noexcept -> Number;
+
+    // exact for Double, the nearest double for the integers
+    [[nodiscard]] auto to_double() const noexcept -> double;
+    // false when the value is not an integer or does not fit
+    [[nodiscard]] auto to_int64(std::int64_t& value) const noexcept -> bool;
+    [[nodiscard]] auto to_uint64(std::uint64_t& value) const noexcept -> bool;
+};
+
+enum class NumberError : std::uint8_t {
+    None,
+    Invalid,        // not the JSON number grammar
+    OutOfRange,     // too large in magnitude for a double
+};
+
+/*
+Decodes `text`, which must be a whole number of the JSON grammar
+    number = [ "-" ] int [ frac ] [ exp ]
+    int    = "0" / ( digit1-9 *digit )
+    frac   = "." 1*digit
+    exp    = ( "e" / "E" ) [ "-" / "+" ] 1*digit
+Integers too large for 64 bits become the nearest Double; a magnitude below
+the smallest double rounds to zero. Only a magnitude above the largest
+double is an error.
+*/
+[[nodiscard]] auto parse_number(std::string_view text, Number& number) noexcept -> NumberError;
+
+// Same as parse_number on the longest prefix of `text` the grammar accepts,
+// whose size is stored in `length`. The caller decides what may follow it
+[[nodiscard]] auto parse_number_prefix(std::string_view text, Number& number,
+                                       std::size_t& length) noexcept -> NumberError;
+
+template <typename Handler, typename = void>
+struct has_integer_callbacks : std::false_type { };
+
+template <typename Handler>
+struct has_integer_callbacks<Handler, std::void_t<
+    decltype(std::declval<Handler&>().on_integer(std::int64_t{})),
+    decltype(std::declval<Handler&>().on_unsigned(std::uint64_t{}))>> : std::true_type { };
+
+// Hands `number` to a parser handler: exact integers go to on_integer and
+// on_unsigned when the handler has both, everything else to on_number
+template <typename Handler>
+auto report_number(Handler& handler, Number const& number) -> bool {
+    if constexpr (has_integer_callbacks<Handler>::value) {
+        switch (number.kind) {
+        case Number::Kind::Int:    return handler.on_integer(number.i);
+        case Number::Kind::UInt:   return handler.on_unsigned(number.u);
+        case Number::Kind::Double: return handler.on_number(number.d);
+        }
+    }
+    return handler.on_number(number.to_double());
+}
+
+} // namespace json
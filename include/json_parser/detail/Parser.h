@@ -1,8 +1,9 @@
 #pragma once
 
 #include "Token.h"
-#include "json_parser/JsonValue.h"
-#include <vector>
+#include "Scanner.h"
+#include <string>
+#include <string_view>
 
 /*
 json        = element
@@ -15,31 +16,30 @@ object_elem = STRING ":" element
 
 namespace json {
 
-class Parser {
+// Token handling shared by every Parser instantiation. Tokens are pulled from
+// a Source with the interface of Scanner: Scanner itself, or for an
+// instrumented parse the CountingScanner of Instrumentation.h
+template <typename Source>
+class BasicParserBase {
 public:
 
-    Parser(std::vector<Token>);
+    // throws a parse error pointing at the last consumed token
+    void fail(std::string const& message) const;
+    // Same for a ParseErrc, kept instead in ErrorMode::Report. A handler
+    // stopping the parse this way returns false afterwards
+    void fail(ParseErrc code);
 
-    auto parse() -> Json;
+    // the error met in ErrorMode::Report, if any. The first one is kept
+    [[nodiscard]] auto error() const noexcept -> ParseError const&;
 
-private:
-
-    struct ObjectElemParsingResult {
-        Json::object_elem_t kv;
-        Token const& key_token;
-    };
-
-private:
-
-    // returning an additional key token for error handling
-    [[nodiscard]] auto parse_object_elem() -> ObjectElemParsingResult;
+    // see Scanner::release_scratch, the parser may only be destroyed afterwards
+    [[nodiscard]] auto release_scratch() noexcept -> Scanner::Scratch;
 
-    [[nodiscard]] auto parse_element() -> Json;
-    [[nodiscard]] auto parse_literal() -> Json;
-    [[nodiscard]] auto parse_array()   -> Json;
-    [[nodiscard]] auto parse_object()  -> Json;
+protected:
 
-    void insert_object_elem(Json::object_t& object);
+    // Tokens are pulled from the scanner one at a time, so beyond what the
+    // handler keeps only the current and previous token are kept alive
+    explicit BasicParserBase(Source scanner, ErrorMode mode = ErrorMode::Throw);
 
     [[nodiscard]] auto is_not_end() const noexcept -> bool;
     [[nodiscard]] auto match(TokenType type) -> bool;
@@ -48,13 +48,174 @@ private:
     [[nodiscard]] auto peek() const -> const Token&;
     [[nodiscard]] auto previous() const -> const Token&;
     auto advance() -> Token&;
-    auto consume(TokenType type, std::string const& message) -> Token&;
+    // `message` is only turned into a std::string on error, the common path does not allocate
+    auto consume(TokenType type, char const* message) -> Token&;
+    // null on an error, which is thrown or kept like error(ParseErrc, Token const&)
+    [[nodiscard]] auto consume(TokenType type, ParseErrc code) -> Token const*;
+
+    void error(std::string const& message, Token const& token) const;
+    // throws, or keeps the error unless one is kept already; false either way
+    auto error(ParseErrc code, Token const& token) -> bool;
+
+    // An array or object was opened by the previous token, or closed. Past
+    // max_nesting_depth, enter() fails with ParseErrc::NestingTooDeep
+    [[nodiscard]] auto enter() -> bool;
+    void leave() noexcept;
+
+private:
+
+    // the next token becomes current, Error tokens pass the Scanner's error on
+    void pull();
+
+private:
+
+    Source scanner_;
+    Token previous_;
+    Token current_;
+    ErrorMode mode_;
+    ParseError error_;
+    std::size_t depth_;
+};
+
+using ParserBase = BasicParserBase<Scanner>;
+
+// defined in Parser.cpp
+extern template class BasicParserBase<Scanner>;
+
+/*
+Walks the grammar above and reports every value to a Handler with
+    bool on_null();
+    bool on_bool(bool value);
+    bool on_number(double value);
+    bool on_string(std::string_view value);
+    bool on_key(std::string_view key);
+    bool on_start_object();
+    bool on_end_object();
+    bool on_start_array();
+    bool on_end_array();
+and optionally, to receive integers exactly instead of as doubles,
+    bool on_integer(std::int64_t value);
+    bool on_unsigned(std::uint64_t value);  // above the int64_t range
+Returning false from any of them stops the parse, and parse() returns false.
+String views are only valid during the call, copy what has to outlive it.
+
+Errors throw a JsonException, or in ErrorMode::Report stop the parse like a
+handler does and are kept, see error(): then the handler may have received
+the value just before the error.
+*/
+template <typename Handler, typename Source = Scanner>
+class Parser : public BasicParserBase<Source> {
+public:
+
+    Parser(Source scanner, Handler& handler, ErrorMode mode = ErrorMode::Throw)
+        : BasicParserBase<Source>(std::move(scanner), mode), handler_(handler) { }
+
+    [[nodiscard]] auto parse() -> bool;
 
 private:
 
-    std::vector<Token> source_;
-    std::size_t current_;
+    using Base = BasicParserBase<Source>;
+    using Base::is_not_end;
+    using Base::match;
+    using Base::check;
+    using Base::peek;
+    using Base::previous;
+    using Base::advance;
+    using Base::consume;
+    using Base::enter;
+    using Base::leave;
+
+    [[nodiscard]] auto parse_element()     -> bool;
+    [[nodiscard]] auto parse_literal()     -> bool;
+    [[nodiscard]] auto parse_array()       -> bool;
+    [[nodiscard]] auto parse_object()      -> bool;
+    [[nodiscard]] auto parse_object_elem() -> bool;
+
+private:
 
+    Handler& handler_;
 };
 
-} // namespace json
\ No newline at end of file
+template <typename Handler, typename Source>
+auto Parser<Handler, Source>::parse() -> bool {
+    if (not is_not_end()) { return this->error(ParseErrc::EmptyInput, peek()); }
+    if (not parse_element()) { return false; }
+    if (is_not_end()) { return this->error(ParseErrc::TrailingContent, peek()); }
+    return true;
+}
+
+template <typename Handler, typename Source>
+auto Parser<Handler, Source>::parse_element() -> bool {
+    if      (match(TokenType::LeftBracket)) { return parse_array(); }
+    else if (match(TokenType::LeftBrace))   { return parse_object(); }
+    else                                    { return parse_literal(); }
+}
+
+template <typename Handler, typename Source>
+auto Parser<Handler, Source>::parse_literal() -> bool {
+    auto const& token = advance();
+    switch (token.type) {
+    case TokenType::Null:   return handler_.on_null();
+    case TokenType::True:   return handler_.on_bool(true);
+    case TokenType::False:  return handler_.on_bool(false);
+    case TokenType::Number: return report_number(handler_, std::get<Number>(token.literal));
+    case TokenType::String: return handler_.on_string(std::get<std::string_view>(token.literal));
+    default:                return this->error(ParseErrc::ExpectedValue, previous());
+    }
+}
+
+template <typename Handler, typename Source>
+auto Parser<Handler, Source>::parse_array() -> bool {
+    if (not enter()) { return false; }
+    if (not handler_.on_start_array()) { return false; }
+
+    if (match(TokenType::RightBracket)) {
+        leave();
+        return handler_.on_end_array();
+    }
+
+    if (not parse_element()) { return false; }
+
+    while (is_not_end() && not check(TokenType::RightBracket)) {
+        if (not consume(TokenType::Comma, ParseErrc::ExpectedArrayComma)) { return false; }
+        if (not parse_element()) { return false; }
+    }
+    if (not consume(TokenType::RightBracket, ParseErrc::UnterminatedArray)) { return false; }
+
+    leave();
+    return handler_.on_end_array();
+}
+
+template <typename Handler, typename Source>
+auto Parser<Handler, Source>::parse_object() -> bool {
+    if (not enter()) { return false; }
+    if (not handler_.on_start_object()) { return false; }
+
+    if (match(TokenType::RightBrace)) {
+        leave();
+        return handler_.on_end_object();
+    }
+
+    if (not parse_object_elem()) { return false; }
+
+    while (is_not_end() && not check(TokenType::RightBrace)) {
+        if (not consume(TokenType::Comma, ParseErrc::ExpectedObjectComma)) { return false; }
+        if (not parse_object_elem()) { return false; }
+    }
+    if (not consume(TokenType::RightBrace, ParseErrc::UnterminatedObject)) { return false; }
+
+    leave();
+    return handler_.on_end_object();
+}
+
+template <typename Handler, typename Source>
+auto Parser<Handler, Source>::parse_object_elem() -> bool {
+    auto const* key_token = consume(TokenType::String, ParseErrc::ExpectedKey);
+    if (key_token == nullptr) { return false; }
+    // the key token is still previous() here, handlers may fail() on it
+    if (not handler_.on_key(std::get<std::string_view>(key_token->literal))) { return false; }
+    if (not consume(TokenType::Colon, ParseErrc::ExpectedColon)) { return false; }
+    return parse_element();
+}
+
+} // namespace json
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Token.h"
+#include "SourceLocation.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace json {
+
+/*
+Scanner for input arriving in chunks. Every lexeme may be split anywhere,
+including inside a string, an escape sequence or a number: the part seen so
+far and the lexer state are kept until the next chunk completes it.
+
+Offsets of tokens count from the start of the whole stream and their
+locations are counted incrementally, newlines are never searched twice.
+
+String tokens reference the current chunk when the string is contained in it
+without escape sequences, otherwise the scanner's buffer. Either way they
+are only valid until the next call to next().
+*/
+class PushScanner {
+public:
+
+    PushScanner();
+
+    // Makes `chunk` the input of next(), which must have returned false for
+    // the previous chunk. `chunk` must stay alive until it does again
+    void feed(std::string_view chunk);
+
+    // Marks the end of the stream: pending lexemes are completed by next(),
+    // which then yields Eof once
+    void finish();
+
+    // Scans the next token of the current chunk. Returns false when the
+    // chunk is exhausted, a lexeme cut by the chunk's end is kept pending
+    [[nodiscard]] auto next() -> bool;
+
+    // The token scanned by the last successful next() and where it starts
+    [[nodiscard]] auto token() const noexcept -> Token const&;
+    [[nodiscard]] auto location() const noexcept -> SourceLocation;
+
+private:
+
+    enum class State : std::uint8_t {
+        Between,        // outside of any lexeme
+        String,
+        Escape,         // after a backslash in a string
+        Unicode,        // inside the hex digits of a \u escape
+        Number,
+        Identifier,
+        Done,           // Eof was scanned
+    };
+
+    void scan_between();
+    void scan_string();
+    void scan_escape();
+    void scan_unicode();
+    void scan_number();
+    void scan_identifier();
+
+    // buffers what the current chunk holds of a pending lexeme before it goes away
+    void release_chunk();
+
+    [[nodiscard]] auto chunk_end() const noexcept -> bool;
+    [[nodiscard]] auto offset() const noexcept -> std::size_t;
+    // `offset` must not be before the last located offset nor past the current chunk
+    [[nodiscard]] auto locate(std::size_t offset) -> SourceLocation;
+
+    void add_token(TokenType type, Token::literal_t literal = Token::NullLiteral{});
+
+    // throws at the start of the string when `text` is not valid UTF-8
+    void check_utf8(std::string_view text) const;
+    void error(std::string const& message, SourceLocation location) const;
+
+private:
+
+    State state_;
+    bool finished_;
+    bool has_token_;
+    Token token_;
+    SourceLocation token_location_;
+
+    std::string_view chunk_;
+    std::size_t chunk_offset_;  // stream offset of chunk_[0]
+    std::size_t current_;       // position in chunk_
+
+    // the lexeme being scanned. Its text starts at run_start_ in the current
+    // chunk, preceded by buffer_ when buffered_: it began in an earlier chunk
+    // or needed decoding
+    std::size_t lexeme_start_;
+    SourceLocation lexeme_location_;
+    std::size_t run_start_;
+    std::string buffer_;
+    bool buffered_;
+    unsigned int hex_digits_;
+    char32_t hex_value_;
+    char32_t high_surrogate_;   // of a \u escape waiting for its low half, or 0
+
+    // where Eof points: the last lexeme, or the last byte if it is whitespace
+    std::size_t last_offset_;
+    SourceLocation last_location_;
+
+    // incremental line counting, every newline before located_offset_ is counted
+    std::size_t located_offset_;
+    std::size_t line_;
+    std::size_t line_start_;
+};
+
+} // namespace json
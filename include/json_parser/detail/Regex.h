@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace json {
+
+/*
+A regular expression in ECMAScript syntax, of the subset JSON Schema
+recommends for portable patterns:
+    characters and escapes          a \. \n \t \xFF \uFFFF
+    any character but line breaks   .
+    classes                         [abc] [a-z] [^a-z] \d \w \s \D \W \S
+    anchors and word boundaries     ^ $ \b \B
+    groups and alternation          (a|b) (?:a|b) (?<name>a|b)
+    quantifiers, greedy or lazy     * + ? {n} {n,} {n,m}
+Backreferences, lookarounds and Unicode property escapes are rejected.
+
+Matching runs the expression's automaton over the text once, following
+every possible match together (Thompson's construction). The time is the
+length of the text times the size of the expression, and nothing recurses,
+however long the text. A backtracking engine such as std::regex recurses
+per character and can exhaust the stack on one long string.
+*/
+class Regex {
+public:
+
+    // the largest expression, in instructions, once quantifiers are expanded
+    static constexpr std::size_t max_size = 10'000;
+
+    // throws a JsonException when `pattern` is malformed or not in the subset
+    explicit Regex(std::string_view pattern);
+
+    // whether the expression matches anywhere in `text`, code point by code
+    // point; bytes that are not UTF-8 match as U+FFFD
+    [[nodiscard]] auto search(std::string_view text) const -> bool;
+
+private:
+
+    class Compiler;
+
+    enum class Op : std::uint8_t {
+        Class,              // consumes a code point in classes_[arg]
+        Split,              // continues both at the next instruction and at arg
+        Jump,               // continues at arg
+        Begin,              // ^
+        End,                // $
+        WordBoundary,       // \b
+        NotWordBoundary,    // \B
+        Match,
+    };
+
+    struct Instruction {
+        Op op;
+        std::uint32_t arg;
+    };
+
+    // sorted, disjoint and not adjacent ranges of code points
+    using CharClass = std::vector<std::pair<char32_t, char32_t>>;
+
+private:
+
+    std::vector<Instruction> program_;
+    std::vector<CharClass> classes_;
+    // the program starts with ^, so no match starts past the first code point
+    bool anchored_;
+};
+
+} // namespace json
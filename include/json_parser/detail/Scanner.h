@@ -1,27 +1,73 @@
 #pragma once
 
 #include "Token.h"
+#include "StructuralIndexer.h"
+#include "../ParseError.h"
+#include <array>
 #include <vector>
+#include <string>
 #include <string_view>
 
 namespace json {
 
+/*
+String tokens are views: strings without escape sequences reference the
+source, escaped ones are decoded into one of two scratch buffers used in
+turn. A String token therefore stays valid until the second next escaped
+string is scanned, which covers the previous and current token of Parser.
+
+Errors throw a JsonException unless the error mode is ErrorMode::Report:
+then the error is kept, see error(), and every token from there on is an
+Error token.
+*/
 class Scanner {
 public:
 
-    Scanner(std::string const& source);
+    // the buffers escaped strings are decoded into
+    using Scratch = std::array<std::string, 2>;
+
+    Scanner(std::string_view source, InstructionSet set = best_instruction_set());
+
+    // Same as above, decoding into `scratch` whose capacity is kept, see
+    // release_scratch() and ParserContext
+    Scanner(std::string_view source, Scratch scratch,
+            InstructionSet set = best_instruction_set());
+
+    // Scans source from offset `from` on. Token offsets and error locations
+    // still refer to the whole source
+    Scanner(std::string_view source, std::size_t from,
+            InstructionSet set = best_instruction_set());
 
     auto scan() && -> std::vector<Token>;
 
+    // Scans and returns the next token, Eof once the source is exhausted.
+    // This lets Parser pull tokens on demand instead of materializing them all
+    [[nodiscard]] auto next_token() -> Token;
+
+    [[nodiscard]] auto source() const -> std::string_view;
+
+    void set_error_mode(ErrorMode mode) noexcept;
+    // the error met in ErrorMode::Report, if any
+    [[nodiscard]] auto error() const noexcept -> ParseError const&;
+
+    // Hands the scratch buffers over for the next scanner. Tokens scanned
+    // so far may reference them; no token may be scanned afterwards
+    [[nodiscard]] auto release_scratch() noexcept -> Scratch;
+
 private:
 
     void scan_token();
+    void skip_whitespace();
 
     void scan_number();
     void scan_string();
     void scan_identifier();
-    [[nodiscard]] auto scan_escape_sequence() -> char;
-    [[nodiscard]] auto scan_hex_digit() -> char;
+    // Decode into `out`, the backslash already consumed. These and
+    // check_utf8 return false on an error, reported
+    [[nodiscard]] auto scan_escape_sequence(std::string& out) -> bool;
+    [[nodiscard]] auto scan_unicode_escape(std::string& out) -> bool;
+    [[nodiscard]] auto scan_hex_digits(char32_t& value) -> bool;
+    [[nodiscard]] auto check_utf8(std::string_view text) -> bool;
 
     [[nodiscard]] auto is_on_digit(char c) const -> bool;
     [[nodiscard]] auto is_not_end() const -> bool;
@@ -32,18 +78,23 @@ private:
     void update_start_position();
     void add_token(TokenType type, Token::literal_t literal = Token::NullLiteral{});
 
-    void error(std::string const& message) const;
+    // at the current lexeme, throws or keeps the error and ends the scan
+    void error(ParseErrc code);
 
 private:
 
-    std::vector<Token> tokens_;
+    StructuralIndexer indexer_;
+    Scratch scratch_;
+    std::size_t scratch_index_;
+    Token token_;
+    bool has_token_;
+    std::string_view document_;
+    std::size_t base_;          // offset of source_ in document_
     std::string_view source_;
     std::size_t start_;
-    std::size_t start_line_;
-    std::size_t start_column_;
     std::size_t current_;
-    std::size_t current_line_;
-    std::size_t current_column_;
+    ErrorMode mode_;
+    ParseError error_;
 };
 
-} // namespace json
\ No newline at end of file
+} // namespace json
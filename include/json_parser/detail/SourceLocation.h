@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace json {
+
+struct SourceLocation {
+    std::size_t line;
+    std::size_t column;
+};
+
+// Lines and columns are only needed to report errors, so they are computed
+// from a byte offset on demand rather than tracked on every scanned byte
+[[nodiscard]] auto locate(std::string_view source, std::size_t offset) -> SourceLocation;
+
+} // namespace json
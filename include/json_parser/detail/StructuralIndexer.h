@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+namespace json {
+
+enum class InstructionSet : std::uint8_t {
+    Scalar,
+    Sse42,
+    Avx2,
+};
+
+[[nodiscard]] auto best_instruction_set() noexcept -> InstructionSet;
+[[nodiscard]] auto is_supported(InstructionSet set) noexcept -> bool;
+[[nodiscard]] auto to_string(InstructionSet set) noexcept -> char const*;
+
+/*
+Stage-1 of the scanner: the source is classified in blocks of 64 bytes and
+every block yields a bit mask of its structural positions, which are
+- the six structural characters "{}[]:," outside of strings
+- the opening quote of every string
+- the first byte of every other lexeme (numbers, literals, invalid characters)
+Whitespace and string contents never appear in the index, so the Scanner can
+jump over them instead of walking byte by byte.
+
+Blocks are classified lazily, one at a time, so memory use does not depend on
+the size of the source.
+*/
+class StructuralIndexer {
+public:
+
+    explicit StructuralIndexer(std::string_view source,
+                               InstructionSet set = best_instruction_set());
+
+    // Returns the next structural position, or the source size once exhausted
+    [[nodiscard]] auto next() -> std::size_t;
+
+    // Returns the first structural position at or after `from`.
+    // `from` must not decrease between calls
+    [[nodiscard]] auto next_from(std::size_t from) -> std::size_t;
+
+    static constexpr std::size_t block_size = 64;
+
+    // classifier of one block_size bytes block, selected once at construction
+    struct BlockMasks {
+        std::uint64_t quote;
+        std::uint64_t backslash;
+        std::uint64_t whitespace;
+        std::uint64_t op;
+    };
+    using classifier_t = auto (*)(char const* block) -> BlockMasks;
+
+private:
+
+    void index_next_block();
+
+private:
+
+    std::string_view source_;
+    classifier_t classify_;
+    std::size_t block_start_;
+    std::size_t next_block_;
+    std::uint64_t structurals_;
+    // state carried from one block to the next
+    bool prev_escaped_;
+    std::uint64_t prev_in_string_;
+    std::uint64_t prev_scalar_;
+};
+
+} // namespace json
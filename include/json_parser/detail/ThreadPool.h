@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace json {
+
+// Fixed set of worker threads running submitted tasks in submission order
+class ThreadPool {
+public:
+
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(std::size_t threads = 0);
+
+    // runs the tasks still queued, then joins the workers
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+
+    // Tasks must not throw, they run outside of any caller
+    void submit(std::function<void()> task);
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+private:
+
+    void work();
+
+private:
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace json
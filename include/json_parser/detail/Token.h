@@ -1,6 +1,9 @@
 #pragma once
 
+#include "Number.h"
+#include "SourceLocation.h"
 #include <string>
+#include <string_view>
 #include <variant>
 
 namespace json {
@@ -20,21 +23,24 @@ enum class TokenType : std::uint8_t {
     RightBracket,   // "]"
 
     Eof,
+    Error,          // in ErrorMode::Report, once the Scanner met an error
 };
 
 struct Token {
     struct NullLiteral { };
-    using literal_t = std::variant<std::string, double, NullLiteral>;
+    // strings reference the source or a scratch buffer of the Scanner
+    using literal_t = std::variant<std::string_view, Number, NullLiteral>;
 
-    int line;
-    int column;
+    // byte offset into the source, see SourceLocation.h for line and column
+    std::size_t offset;
     TokenType type;
     literal_t literal = NullLiteral{};
 
     Token() =  default;
-    Token(int _line, int _column, TokenType _type, literal_t _literal);
+    Token(std::size_t _offset, TokenType _type, literal_t _literal);
 
-    [[nodiscard]] auto to_string() const -> std::string;
+    [[nodiscard]] auto to_string(std::string_view source) const -> std::string;
+    [[nodiscard]] auto to_string(SourceLocation location) const -> std::string;
 
 };
 
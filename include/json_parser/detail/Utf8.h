@@ -0,0 +1,99 @@
+#pragma once
+
+#include "StructuralIndexer.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace json {
+
+/*
+Offset of the first byte of `text` that does not belong to a well-formed
+UTF-8 sequence (RFC 3629: no overlong forms, no surrogates, nothing above
+U+10FFFF), std::string_view::npos when all of it is valid. A sequence cut
+by the end of `text` is invalid.
+
+ASCII, most of any JSON text, is skipped 16 or 32 bytes at a time with
+SSE4.2 or AVX2 and 8 at a time otherwise; only multi-byte sequences are
+decoded byte by byte. A `set` the CPU does not support falls back to the
+scalar code.
+*/
+[[nodiscard]] auto find_invalid_utf8(std::string_view text,
+                                     InstructionSet set = best_instruction_set()) noexcept -> std::size_t;
+
+// Position of the first '"' or '\\' of `text` at or after `from`, text.size() when there is none
+[[nodiscard]] auto find_quote_or_backslash(std::string_view text, std::size_t from) noexcept -> std::size_t;
+
+// The value of a hex digit, -1 when `c` is not one
+[[nodiscard]] constexpr auto hex_digit_value(char c) noexcept -> int {
+    if ('0' <= c && c <= '9') { return c - '0'; }
+    if ('a' <= c && c <= 'f') { return c - 'a' + 10; }
+    if ('A' <= c && c <= 'F') { return c - 'A' + 10; }
+    return -1;
+}
+
+[[nodiscard]] constexpr auto is_high_surrogate(char32_t c) noexcept -> bool { return 0xD800 <= c && c <= 0xDBFF; }
+[[nodiscard]] constexpr auto is_low_surrogate(char32_t c) noexcept -> bool  { return 0xDC00 <= c && c <= 0xDFFF; }
+
+// The code point of a surrogate pair of \u escapes
+[[nodiscard]] constexpr auto combine_surrogates(char32_t high, char32_t low) noexcept -> char32_t {
+    return 0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00);
+}
+
+// Length of the well-formed sequence starting with the non-ASCII byte at
+// `i`, 0 when it is not one. The ranges are those of RFC 3629, table 3-7
+// of the Unicode standard
+[[nodiscard]] constexpr auto utf8_sequence_length(std::string_view text, std::size_t i) noexcept -> std::size_t {
+    auto const byte = [&](std::size_t k) { return static_cast<unsigned char>(text[i + k]); };
+    auto const lead = byte(0);
+
+    std::size_t length = 0;
+    unsigned char second_min = 0x80;
+    unsigned char second_max = 0xBF;
+    if      (0xC2 <= lead && lead <= 0xDF) { length = 2; }
+    else if (lead == 0xE0)                 { length = 3; second_min = 0xA0; }
+    else if (lead == 0xED)                 { length = 3; second_max = 0x9F; }   // no surrogates
+    else if (0xE1 <= lead && lead <= 0xEF) { length = 3; }
+    else if (lead == 0xF0)                 { length = 4; second_min = 0x90; }
+    else if (0xF1 <= lead && lead <= 0xF3) { length = 4; }
+    else if (lead == 0xF4)                 { length = 4; second_max = 0x8F; }   // up to U+10FFFF
+    else                                   { return 0; }
+
+    if (text.size() - i < length) { return 0; }
+    if (byte(1) < second_min || byte(1) > second_max) { return 0; }
+    for (std::size_t k = 2; k < length; ++k) {
+        if ((byte(k) & 0xC0) != 0x80) { return 0; }
+    }
+    return length;
+}
+
+// Writes the UTF-8 encoding of `code_point`, a Unicode scalar value, to
+// `out` and returns its length
+constexpr auto encode_utf8(char32_t code_point, char (&out)[4]) noexcept -> std::size_t {
+    auto const byte = [](char32_t value) { return static_cast<char>(static_cast<unsigned char>(value)); };
+    if (code_point < 0x80) {
+        out[0] = byte(code_point);
+        return 1;
+    }
+    if (code_point < 0x800) {
+        out[0] = byte(0xC0 | (code_point >> 6));
+        out[1] = byte(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+    if (code_point < 0x10000) {
+        out[0] = byte(0xE0 | (code_point >> 12));
+        out[1] = byte(0x80 | ((code_point >> 6) & 0x3F));
+        out[2] = byte(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    out[0] = byte(0xF0 | (code_point >> 18));
+    out[1] = byte(0x80 | ((code_point >> 12) & 0x3F));
+    out[2] = byte(0x80 | ((code_point >> 6) & 0x3F));
+    out[3] = byte(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+// Appends the UTF-8 encoding of `code_point`, a Unicode scalar value
+void append_utf8(std::string& out, char32_t code_point);
+
+} // namespace json
@@ -0,0 +1,125 @@
+#include "json_parser/Binding.h"
+#include <unordered_set>
+
+namespace json {
+
+// BindingReader member functions
+
+BindingReader::BindingReader(std::string_view source)
+    : ParserBase(Scanner(source)), key_(0, TokenType::String, std::string_view{}) {
+    if (not is_not_end()) { error("Empty string", peek()); }
+}
+
+void BindingReader::finish() {
+    if (is_not_end()) { error("Unexpected token after parsing element", peek()); }
+}
+
+auto BindingReader::read_null() -> bool {
+    return match(TokenType::Null);
+}
+
+auto BindingReader::read_bool() -> bool {
+    if (match(TokenType::True))  { return true; }
+    if (match(TokenType::False)) { return false; }
+    advance();
+    fail("Expected a boolean");
+    return false;
+}
+
+auto BindingReader::read_number() -> Number {
+    auto const& token = advance();
+    if (token.type != TokenType::Number) { fail("Expected a number"); }
+    return std::get<Number>(token.literal);
+}
+
+auto BindingReader::read_string() -> std::string_view {
+    auto const& token = advance();
+    if (token.type != TokenType::String) { fail("Expected a string"); }
+    return std::get<std::string_view>(token.literal);
+}
+
+void BindingReader::begin_array() {
+    if (advance().type != TokenType::LeftBracket) { fail("Expected an array"); }
+    static_cast<void>(enter());
+}
+
+auto BindingReader::end_array() -> bool {
+    if (not match(TokenType::RightBracket)) { return false; }
+    leave();
+    return true;
+}
+
+auto BindingReader::next_element() -> bool {
+    if (match(TokenType::Comma)) { return true; }
+    if (is_not_end() && not check(TokenType::RightBracket)) {
+        error("Expected comma \",\" after element in array", peek());
+    }
+    consume(TokenType::RightBracket, "Need right bracket \"]\" to terminate an array");
+    leave();
+    return false;
+}
+
+void BindingReader::begin_object() {
+    if (advance().type != TokenType::LeftBrace) { fail("Expected an object"); }
+    static_cast<void>(enter());
+}
+
+auto BindingReader::end_object() -> bool {
+    if (not match(TokenType::RightBrace)) { return false; }
+    leave();
+    return true;
+}
+
+auto BindingReader::read_key() -> std::string_view {
+    key_ = consume(TokenType::String, "Key of object element must be a string");
+    consume(TokenType::Colon, "Object must have a colon \":\" to separate a key-value pair");
+    return std::get<std::string_view>(key_.literal);
+}
+
+auto BindingReader::next_member() -> bool {
+    if (match(TokenType::Comma)) { return true; }
+    if (is_not_end() && not check(TokenType::RightBrace)) {
+        error("Expected comma \",\" after element in object", peek());
+    }
+    consume(TokenType::RightBrace, "Need right brace \"}\" to terminate an object");
+    leave();
+    return false;
+}
+
+void BindingReader::duplicate_key(std::string_view key) const {
+    error("Key \"" + std::string(key) + "\" already exist", key_);
+}
+
+void BindingReader::skip_value() {
+    auto const& token = advance();
+    switch (token.type) {
+    case TokenType::Null:
+    case TokenType::True:
+    case TokenType::False:
+    case TokenType::Number:
+    case TokenType::String:
+        return;
+    case TokenType::LeftBracket: {
+        static_cast<void>(enter());
+        if (end_array()) { return; }
+        do { skip_value(); } while (next_element());
+        return;
+    }
+    case TokenType::LeftBrace: {
+        static_cast<void>(enter());
+        if (end_object()) { return; }
+        auto keys = std::unordered_set<std::string>{};
+        do {
+            auto const key = read_key();
+            if (not keys.emplace(key).second) { duplicate_key(key); }
+            skip_value();
+        } while (next_member());
+        return;
+    }
+    default:
+        fail("Invalid literal");
+        return;
+    }
+}
+
+} // namespace json
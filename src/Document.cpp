@@ -0,0 +1,31 @@
+#include "json_parser/Document.h"
+#include <new>
+
+namespace json {
+
+Document::Document()
+:
+    Document(std::make_unique<arena_t>(), Json{})
+{
+}
+
+Document::Document(std::unique_ptr<arena_t> arena, Json root,
+                   std::shared_ptr<void const> input)
+:
+    input_(std::move(input)),
+    arena_(std::move(arena)),
+    root_(nullptr)
+{
+    // moving keeps the allocators of root's containers, so the tree stays in the arena
+    root_ = new (arena_->allocate(sizeof(Json), alignof(Json))) Json(std::move(root));
+}
+
+auto Document::root() const noexcept -> Json const& {
+    return *root_;
+}
+
+auto Document::resource() const noexcept -> std::pmr::memory_resource* {
+    return arena_.get();
+}
+
+} // namespace json
@@ -0,0 +1,171 @@
+#include "json_parser/detail/DomBuilder.h"
+#include "json_parser/detail/Instrumentation.h"
+#include "json_parser/detail/Parser.h"
+#include <functional>
+#include <iterator>
+#include <new>
+
+namespace json {
+
+// instantiated here so the handler calls inline into the grammar
+template class Parser<DomBuilder>;
+
+// helpers
+
+inline static auto is_slice_of(std::string_view view, std::string_view source) -> bool {
+    auto const less_equal = std::less_equal<char const*>{};
+    return less_equal(source.data(), view.data()) &&
+           less_equal(view.data() + view.size(), source.data() + source.size());
+}
+
+// DomBuilder member functions
+
+DomBuilder::DomBuilder(std::string_view source,
+                       std::pmr::memory_resource* resource,
+                       StringMode string_mode,
+                       KeyDictionary* keys)
+:
+    source_(source),
+    resource_(resource),
+    string_mode_(string_mode),
+    keys_(keys),
+    open_(),
+    duplicate_key_(),
+    result_()
+{
+}
+
+auto DomBuilder::on_null() -> bool {
+    return add(Json{});
+}
+
+auto DomBuilder::on_bool(bool value) -> bool {
+    return add(Json{value});
+}
+
+auto DomBuilder::on_number(double value) -> bool {
+    return add(Json{value});
+}
+
+auto DomBuilder::on_integer(std::int64_t value) -> bool {
+    return add(Json(value));
+}
+
+auto DomBuilder::on_unsigned(std::uint64_t value) -> bool {
+    return add(Json(value));
+}
+
+auto DomBuilder::on_string(std::string_view value) -> bool {
+    // escaped strings live in a scanner scratch buffer and are always copied
+    if (string_mode_ == StringMode::Borrow && is_slice_of(value, source_)) {
+        return add(Json{Json::borrowed_string_t{value}});
+    }
+    return add(Json(value, resource_));
+}
+
+auto DomBuilder::on_key(std::string_view key) -> bool {
+    // inserting right away reports a duplicate while the key is the last token
+    auto& object = open_.back().object();
+    auto const interned = keys_ != nullptr ? keys_->intern(key) : InternedKey{};
+    auto member_key = interned ? Json::object_t::key_type(interned) : Json::object_t::key_type(key, resource_);
+    if (not object.try_emplace(std::move(member_key), Json{}).second) {
+        duplicate_key_ = key;
+        return false;
+    }
+    return true;
+}
+
+auto DomBuilder::on_start_object() -> bool {
+    open_.emplace_back(Json::object_t{ resource_ });
+    return true;
+}
+
+auto DomBuilder::on_end_object() -> bool {
+    auto object = std::move(open_.back());
+    open_.pop_back();
+    return add(std::move(object));
+}
+
+auto DomBuilder::on_start_array() -> bool {
+    open_.emplace_back(Json::array_t{ resource_ });
+    return true;
+}
+
+auto DomBuilder::on_end_array() -> bool {
+    auto array = std::move(open_.back());
+    open_.pop_back();
+    return add(std::move(array));
+}
+
+void DomBuilder::reset(std::string_view source,
+                       std::pmr::memory_resource* resource,
+                       StringMode string_mode,
+                       KeyDictionary* keys) noexcept {
+    source_ = source;
+    resource_ = resource;
+    string_mode_ = string_mode;
+    keys_ = keys;
+    open_.clear();
+    duplicate_key_ = {};
+    result_ = Json{};
+}
+
+void DomBuilder::abandon() noexcept {
+    // overwritten by nulls, ending the values without running their destructors
+    for (auto& json : open_) { new (&json) Json(); }
+    open_.clear();
+    new (&result_) Json();
+    duplicate_key_ = {};
+}
+
+auto DomBuilder::duplicate_key() const noexcept -> std::string_view {
+    return duplicate_key_;
+}
+
+auto DomBuilder::result() && -> Json {
+    return std::move(result_);
+}
+
+auto DomBuilder::add(Json value) -> bool {
+    if (open_.empty()) {
+        result_ = std::move(value);
+    } else if (auto& parent = open_.back(); parent.is_array()) {
+        parent.array().push_back(std::move(value));
+    } else {
+        std::prev(parent.object().end())->second = std::move(value);
+    }
+    return true;
+}
+
+// free functions
+
+auto build_dom(std::string_view source,
+               std::pmr::memory_resource* resource,
+               StringMode string_mode,
+               KeyDictionary* keys,
+               ParseStats* stats) -> Json {
+    auto builder = DomBuilder(source, resource, string_mode, keys);
+    // the builder only stops on a duplicate key, which is the last consumed token
+    auto const fail_on_duplicate = [&builder](auto const& parser) {
+        parser.fail("Key \"" + std::string(builder.duplicate_key()) + "\" already exist");
+    };
+    if (stats != nullptr) {
+        static_cast<void>(parse_with_stats(source, builder, *stats, fail_on_duplicate));
+        return std::move(builder).result();
+    }
+
+    auto parser = Parser<DomBuilder>(Scanner(source), builder);
+    if (not parser.parse()) { fail_on_duplicate(parser); }
+    return std::move(builder).result();
+}
+
+auto try_build_dom(std::string_view source, std::pmr::memory_resource* resource) -> ParseResult<Json> {
+    auto builder = DomBuilder(source, resource);
+    auto parser = Parser<DomBuilder>(Scanner(source), builder, ErrorMode::Report);
+    if (parser.parse()) { return std::move(builder).result(); }
+    // without an error the builder stopped, on a duplicate key
+    if (not parser.error()) { parser.fail(ParseErrc::DuplicateKey); }
+    return parser.error();
+}
+
+} // namespace json
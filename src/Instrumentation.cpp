@@ -0,0 +1,87 @@
+#include "json_parser/detail/Instrumentation.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace json {
+
+// helpers
+
+// counters of the calling thread, a CountingResource may be used by several
+static thread_local AllocationCounts thread_counts;
+
+inline static auto is_slice_of(std::string_view view, std::string_view source) -> bool {
+    auto const less_equal = std::less_equal<char const*>{};
+    return less_equal(source.data(), view.data()) &&
+           less_equal(view.data() + view.size(), source.data() + source.size());
+}
+
+// escape sequences of the string token starting at `offset`, its opening quote
+static auto count_escapes(std::string_view source, std::size_t offset) -> std::size_t {
+    std::size_t escapes = 0;
+    for (auto i = offset + 1; i < source.size() && source[i] != '"'; ++i) {
+        // the escaped character is skipped, so "\\" and "\"" are one each
+        if (source[i] == '\\') {
+            ++escapes;
+            ++i;
+        }
+    }
+    return escapes;
+}
+
+// CountingResource member functions
+
+CountingResource::CountingResource(std::pmr::memory_resource* upstream) noexcept
+    : upstream_(upstream) { }
+
+auto CountingResource::heap() -> CountingResource* {
+    // never destroyed, trees allocated through it may outlive static destruction
+    static auto* const resource = new CountingResource(std::pmr::new_delete_resource());
+    return resource;
+}
+
+auto CountingResource::do_allocate(std::size_t bytes, std::size_t alignment) -> void* {
+    auto* const p = upstream_->allocate(bytes, alignment);
+    ++thread_counts.allocations;
+    thread_counts.bytes += bytes;
+    return p;
+}
+
+void CountingResource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    upstream_->deallocate(p, bytes, alignment);
+}
+
+auto CountingResource::do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool {
+    return this == &other;
+}
+
+// PhaseTimer member functions
+
+auto PhaseTimer::ticks_overhead() noexcept -> std::uint64_t {
+    auto overhead = std::numeric_limits<std::uint64_t>::max();
+    for (auto i = 0; i < 100; ++i) {
+        auto const start = ticks();
+        overhead = std::min(overhead, ticks() - start);
+    }
+    return overhead;
+}
+
+// ScanStatistics member functions
+
+void ScanStatistics::count(Token const& token, std::string_view source) {
+    ++stats.tokens[static_cast<std::size_t>(token.type)];
+    // unescaped strings are views of the source, escaped ones are decoded elsewhere
+    if (token.type == TokenType::String
+        && not is_slice_of(std::get<std::string_view>(token.literal), source)) {
+        ++stats.escaped_strings;
+        stats.escapes += count_escapes(source, token.offset);
+    }
+}
+
+// free functions
+
+auto thread_allocation_counts() noexcept -> AllocationCounts {
+    return thread_counts;
+}
+
+} // namespace json
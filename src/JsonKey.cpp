@@ -0,0 +1,182 @@
+#include "json_parser/JsonKey.h"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace json {
+
+// helpers
+
+static constexpr std::size_t tag_byte = 15;
+static constexpr unsigned storage_shift = 4;
+static constexpr unsigned char inline_size_mask = 0x0F;
+static_assert(JsonKey::inline_capacity < tag_byte + 1 && JsonKey::inline_capacity <= inline_size_mask,
+              "inline keys must leave the tag byte free");
+
+// JsonKey member functions
+
+JsonKey::JsonKey() noexcept
+    : bytes_(), owner_{ std::pmr::get_default_resource() } { }
+
+JsonKey::JsonKey(std::string_view text, allocator_type allocator)
+    : bytes_(), owner_{ allocator.resource() } {
+    assign(text);
+}
+
+JsonKey::JsonKey(InternedKey key) noexcept
+    : bytes_(), owner_() {
+    owner_.dictionary = key.dictionary_;
+    set_external(key.data_, key.size_, Storage::Interned);
+}
+
+JsonKey::JsonKey(JsonKey const& other)
+    : JsonKey(other, allocator_type{}) { }
+
+JsonKey::JsonKey(JsonKey const& other, allocator_type allocator)
+    : bytes_(), owner_{ allocator.resource() } {
+    copy_from(other);
+}
+
+JsonKey::JsonKey(JsonKey&& other) noexcept
+    : bytes_(), owner_(other.owner_) {
+    std::memcpy(bytes_, other.bytes_, sizeof bytes_);
+    other.reset();
+}
+
+JsonKey::JsonKey(JsonKey&& other, allocator_type allocator)
+    : bytes_(), owner_{ allocator.resource() } {
+    // an owned buffer may only be taken over from the same resource
+    if (other.storage() == Storage::Owned && other.owner_.resource != allocator.resource()) {
+        assign(other.view());
+        return;
+    }
+    std::memcpy(bytes_, other.bytes_, sizeof bytes_);
+    if (other.storage() != Storage::Inline) { owner_ = other.owner_; }
+    other.reset();
+}
+
+auto JsonKey::operator=(JsonKey const& other) -> JsonKey& {
+    if (this == &other) { return *this; }
+    // like std::pmr::string, the resource stays the one of this key
+    auto* const kept = resource();
+    release();
+    owner_.resource = kept;
+    copy_from(other);
+    return *this;
+}
+
+auto JsonKey::operator=(JsonKey&& other) -> JsonKey& {
+    if (this == &other) { return *this; }
+    auto* const kept = resource();
+    if (other.storage() == Storage::Owned && other.owner_.resource != kept) {
+        return *this = static_cast<JsonKey const&>(other);
+    }
+    release();
+    std::memcpy(bytes_, other.bytes_, sizeof bytes_);
+    if (other.storage() != Storage::Inline) { owner_ = other.owner_; }
+    else                                    { owner_.resource = kept; }
+    other.reset();
+    return *this;
+}
+
+JsonKey::~JsonKey() {
+    release();
+}
+
+auto JsonKey::view() const noexcept -> std::string_view {
+    return { data(), size() };
+}
+
+auto JsonKey::data() const noexcept -> char const* {
+    if (storage() == Storage::Inline) { return reinterpret_cast<char const*>(bytes_); }
+    auto data = static_cast<char const*>(nullptr);
+    std::memcpy(&data, bytes_, sizeof data);
+    return data;
+}
+
+auto JsonKey::size() const noexcept -> std::size_t {
+    if (storage() == Storage::Inline) { return bytes_[tag_byte] & inline_size_mask; }
+    auto size = std::uint32_t{};
+    std::memcpy(&size, bytes_ + sizeof(char const*), sizeof size);
+    return size;
+}
+
+auto JsonKey::empty() const noexcept -> bool {
+    return size() == 0;
+}
+
+auto JsonKey::get_allocator() const noexcept -> allocator_type {
+    return resource();
+}
+
+auto JsonKey::is_interned() const noexcept -> bool {
+    return storage() == Storage::Interned;
+}
+
+auto JsonKey::handle() const noexcept -> InternedKey {
+    if (not is_interned()) { return {}; }
+    return { data(), size(), owner_.dictionary };
+}
+
+void JsonKey::copy_from(JsonKey const& other) {
+    if (other.storage() == Storage::Interned) {
+        std::memcpy(bytes_, other.bytes_, sizeof bytes_);
+        owner_ = other.owner_;
+        return;
+    }
+    assign(other.view());
+}
+
+void JsonKey::assign(std::string_view text) {
+    if (text.size() <= inline_capacity) {
+        std::memcpy(bytes_, text.data(), text.size());
+        bytes_[tag_byte] = static_cast<unsigned char>(text.size());
+        return;
+    }
+    if (text.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("Object keys are limited to 4 GiB");
+    }
+    auto* const data = static_cast<char*>(owner_.resource->allocate(text.size(), 1));
+    std::memcpy(data, text.data(), text.size());
+    set_external(data, text.size(), Storage::Owned);
+}
+
+void JsonKey::release() noexcept {
+    if (storage() == Storage::Owned) {
+        owner_.resource->deallocate(const_cast<char*>(data()), size(), 1);
+    }
+    std::memset(bytes_, 0, sizeof bytes_);
+}
+
+void JsonKey::reset() noexcept {
+    if (storage() == Storage::Interned) { owner_.resource = std::pmr::get_default_resource(); }
+    std::memset(bytes_, 0, sizeof bytes_);
+}
+
+auto JsonKey::storage() const noexcept -> Storage {
+    return static_cast<Storage>(bytes_[tag_byte] >> storage_shift);
+}
+
+auto JsonKey::resource() const noexcept -> std::pmr::memory_resource* {
+    return storage() == Storage::Interned ? std::pmr::get_default_resource() : owner_.resource;
+}
+
+void JsonKey::set_external(char const* data, std::size_t size, Storage storage) noexcept {
+    auto const size32 = static_cast<std::uint32_t>(size);
+    std::memset(bytes_, 0, sizeof bytes_);
+    std::memcpy(bytes_, &data, sizeof data);
+    std::memcpy(bytes_ + sizeof data, &size32, sizeof size32);
+    bytes_[tag_byte] = static_cast<unsigned char>(static_cast<unsigned>(storage) << storage_shift);
+}
+
+// free functions
+
+auto operator==(JsonKey const& a, JsonKey const& b) noexcept -> bool {
+    // one copy of every key in a dictionary: the pointers tell
+    if (a.is_interned() && b.is_interned() && a.owner_.dictionary == b.owner_.dictionary) {
+        return a.data() == b.data();
+    }
+    return a.view() == b.view();
+}
+
+} // namespace json
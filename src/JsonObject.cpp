@@ -0,0 +1,160 @@
+#include "json_parser/JsonObject.h"
+#include "json_parser/JsonValue.h"
+#include <functional>
+#include <stdexcept>
+
+namespace json {
+
+// helpers
+
+inline static auto hash_of(std::string_view key) -> std::size_t {
+    return std::hash<std::string_view>{}(key);
+}
+
+// JsonObject member functions
+
+JsonObject::JsonObject()
+    : JsonObject(allocator_type{}) { }
+
+JsonObject::JsonObject(allocator_type allocator)
+    : members_(allocator), index_(allocator) { }
+
+JsonObject::JsonObject(std::initializer_list<value_type> list, allocator_type allocator)
+    : JsonObject(allocator) {
+    reserve(list.size());
+    for (auto const& member : list) {
+        insert(member);
+    }
+}
+
+auto JsonObject::size() const noexcept -> size_type {
+    return members_.size();
+}
+
+auto JsonObject::empty() const noexcept -> bool {
+    return members_.empty();
+}
+
+void JsonObject::reserve(size_type capacity) {
+    members_.reserve(capacity);
+}
+
+void JsonObject::clear() noexcept {
+    members_.clear();
+    index_.clear();
+}
+
+auto JsonObject::begin() noexcept -> iterator { return members_.begin(); }
+auto JsonObject::end()   noexcept -> iterator { return members_.end(); }
+auto JsonObject::begin() const noexcept -> const_iterator { return members_.begin(); }
+auto JsonObject::end()   const noexcept -> const_iterator { return members_.end(); }
+auto JsonObject::cbegin() const noexcept -> const_iterator { return members_.cbegin(); }
+auto JsonObject::cend()   const noexcept -> const_iterator { return members_.cend(); }
+
+auto JsonObject::find(std::string_view key) -> iterator {
+    return members_.begin() + static_cast<std::ptrdiff_t>(find_position(key));
+}
+
+auto JsonObject::find(std::string_view key) const -> const_iterator {
+    return members_.begin() + static_cast<std::ptrdiff_t>(find_position(key));
+}
+
+auto JsonObject::count(std::string_view key) const -> size_type {
+    return find_position(key) == members_.size() ? 0 : 1;
+}
+
+auto JsonObject::at(std::string_view key) -> Json& {
+    auto const it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("Key \"" + std::string(key) + "\" does not exist");
+    }
+    return it->second;
+}
+
+auto JsonObject::at(std::string_view key) const -> Json const& {
+    auto const it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("Key \"" + std::string(key) + "\" does not exist");
+    }
+    return it->second;
+}
+
+auto JsonObject::operator[](std::string_view key) -> Json& {
+    auto const it = find(key);
+    if (it != end()) { return it->second; }
+    return try_emplace(key_type(key, members_.get_allocator()), Json{}).first->second;
+}
+
+auto JsonObject::try_emplace(key_type&& key, Json&& value) -> std::pair<iterator, bool> {
+    auto const position = find_position(key);
+    if (position != members_.size()) { return { members_.begin() + static_cast<std::ptrdiff_t>(position), false }; }
+
+    members_.emplace_back(std::move(key), std::move(value));
+    if      (not index_.empty())                { index_member(members_.size() - 1); }
+    else if (members_.size() > index_threshold) { rebuild_index(); }
+    return { std::prev(members_.end()), true };
+}
+
+auto JsonObject::insert(value_type member) -> std::pair<iterator, bool> {
+    return try_emplace(std::move(member.first), std::move(member.second));
+}
+
+auto JsonObject::erase(std::string_view key) -> size_type {
+    auto const it = find(key);
+    if (it == end()) { return 0; }
+
+    members_.erase(it);
+    // positions after the erased member shifted, a rebuild is simpler than patching
+    if (members_.size() > index_threshold) { rebuild_index(); }
+    else                                   { index_.clear(); }
+    return 1;
+}
+
+auto JsonObject::get_allocator() const noexcept -> allocator_type {
+    return members_.get_allocator();
+}
+
+template <typename Key>
+auto JsonObject::find_position(Key const& key) const -> size_type {
+    if (index_.empty()) {
+        for (size_type i = 0; i < members_.size(); ++i) {
+            if (members_[i].first == key) { return i; }
+        }
+        return members_.size();
+    }
+
+    auto const mask = index_.size() - 1;
+    for (auto slot = hash_of(std::string_view{ key }) & mask; index_[slot] != 0; slot = (slot + 1) & mask) {
+        auto const position = size_type{index_[slot]} - 1;
+        if (members_[position].first == key) { return position; }
+    }
+    return members_.size();
+}
+
+void JsonObject::index_member(size_type position) {
+    // keep the load factor at or below one half
+    if (2 * members_.size() > index_.size()) {
+        rebuild_index();
+        return;
+    }
+
+    auto const mask = index_.size() - 1;
+    auto slot = hash_of(members_[position].first) & mask;
+    while (index_[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    index_[slot] = static_cast<std::uint32_t>(position + 1);
+}
+
+void JsonObject::rebuild_index() {
+    size_type capacity = 1;
+    while (capacity < 4 * members_.size()) {
+        capacity *= 2;
+    }
+    index_.assign(capacity, 0);
+    for (size_type i = 0; i < members_.size(); ++i) {
+        index_member(i);
+    }
+}
+
+} // namespace json
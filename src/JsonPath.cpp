@@ -0,0 +1,346 @@
+#include "json_parser/JsonPath.h"
+#include "json_parser/JsonException.h"
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+
+namespace json {
+
+// helpers
+
+// The array index an RFC 6901 reference token denotes: decimal digits
+// without leading zeros. npos for anything else, "-" included
+static auto to_index(std::string_view token) -> std::size_t {
+    if (token.empty() || (token.size() > 1 && token.front() == '0')) { return std::string_view::npos; }
+    std::size_t index = 0;
+    auto const [end, err] = std::from_chars(token.data(), token.data() + token.size(), index);
+    if (err != std::errc{} || end != token.data() + token.size()) { return std::string_view::npos; }
+    return index;
+}
+
+static auto member_step(std::string key) -> PathStep {
+    auto step = PathStep{ PathStep::Kind::Member, std::move(key), 0, 0, std::nullopt, std::nullopt, 1 };
+    step.key_index = to_index(step.key);
+    return step;
+}
+
+// Positions a slice selects in an array of `size` elements
+static auto slice_range(PathStep const& step, std::size_t size) -> std::pair<std::size_t, std::size_t> {
+    auto const length = static_cast<std::ptrdiff_t>(size);
+    auto const clamp = [length](std::ptrdiff_t bound) {
+        if (bound < 0) { bound += length; }
+        return static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(bound, 0, length));
+    };
+    return { clamp(step.start.value_or(0)), clamp(step.stop.value_or(length)) };
+}
+
+namespace {
+
+// Compiles the path language, see JsonPath
+class PathCompiler {
+public:
+
+    explicit PathCompiler(std::string_view expression)
+        : expression_(expression), current_(0) { }
+
+    auto compile() -> std::vector<PathStep> {
+        if (not match('$')) { error("A path starts with \"$\""); }
+
+        auto steps = std::vector<PathStep>{};
+        while (is_not_end()) {
+            if (match('.')) {
+                if (match('*')) { steps.push_back(wildcard_step()); }
+                else            { steps.push_back(member_step(std::string(name()))); }
+            } else if (match('[')) {
+                steps.push_back(selector());
+                if (not match(']')) { error("Expected \"]\""); }
+            } else {
+                error("Expected \".\" or \"[\"");
+            }
+        }
+        return steps;
+    }
+
+private:
+
+    static auto wildcard_step() -> PathStep {
+        return { PathStep::Kind::Wildcard, {}, std::string_view::npos, 0, std::nullopt, std::nullopt, 1 };
+    }
+
+    auto name() -> std::string_view {
+        auto const begin = current_;
+        while (is_not_end() && peek() != '.' && peek() != '[') {
+            ++current_;
+        }
+        if (current_ == begin) { error("Expected a member name"); }
+        return expression_.substr(begin, current_ - begin);
+    }
+
+    auto selector() -> PathStep {
+        if (match('*')) { return wildcard_step(); }
+        if (peek() == '\'' || peek() == '"') { return member_step(quoted()); }
+
+        auto const start = integer();
+        if (not match(':')) {
+            if (not start) { error("Expected an index, a slice, a quoted key or \"*\""); }
+            return { PathStep::Kind::Index, {}, std::string_view::npos, *start, std::nullopt, std::nullopt, 1 };
+        }
+        auto const stop = integer();
+        auto step = std::ptrdiff_t{1};
+        if (match(':')) {
+            auto const at = current_;
+            auto const given = integer();
+            if (not given || *given <= 0) {
+                current_ = at;
+                error("A slice step must be a positive integer");
+            }
+            step = *given;
+        }
+        return { PathStep::Kind::Slice, {}, std::string_view::npos, 0, start, stop, step };
+    }
+
+    auto integer() -> std::optional<std::ptrdiff_t> {
+        auto value = std::ptrdiff_t{0};
+        auto const rest = expression_.substr(current_);
+        auto const [end, err] = std::from_chars(rest.data(), rest.data() + rest.size(), value);
+        if (err == std::errc::invalid_argument) { return std::nullopt; }
+        if (err != std::errc{}) { error("Integer out of range"); }
+        current_ += static_cast<std::size_t>(end - rest.data());
+        return value;
+    }
+
+    // a key in single or double quotes, a backslash escapes the next character
+    auto quoted() -> std::string {
+        auto const quote = expression_[current_++];
+        auto key = std::string{};
+        while (is_not_end() && peek() != quote) {
+            if (peek() == '\\') { ++current_; }
+            if (not is_not_end()) { break; }
+            key += expression_[current_++];
+        }
+        if (not match(quote)) { error("Unterminated quoted key"); }
+        return key;
+    }
+
+    auto match(char const c) -> bool {
+        if (is_not_end() && expression_[current_] == c) {
+            ++current_;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] auto peek() const -> char {
+        return is_not_end() ? expression_[current_] : '\0';
+    }
+
+    [[nodiscard]] auto is_not_end() const -> bool {
+        return current_ < expression_.size();
+    }
+
+    [[noreturn]] void error(std::string const& message) const {
+        std::stringstream ss;
+        ss << "Path error at column " << current_ + 1 << " of \"" << expression_ << "\": " << message;
+        throw JsonException(ss.str());
+    }
+
+private:
+
+    std::string_view expression_;
+    std::size_t current_;
+};
+
+// how the evaluator moves through a built Json
+struct JsonAccess {
+    using node_t = Json const*;
+
+    static auto member(node_t node, PathStep const& step) -> std::optional<node_t> {
+        if (node->is_object()) {
+            auto const& object = node->object();
+            auto const it = object.find(step.key);
+            if (it != object.end()) { return &it->second; }
+        } else if (node->is_array() && step.key_index < node->array().size()) {
+            return &node->array()[step.key_index];
+        }
+        return std::nullopt;
+    }
+
+    static auto element(node_t node, std::ptrdiff_t index) -> std::optional<node_t> {
+        if (not node->is_array()) { return std::nullopt; }
+        auto const& array = node->array();
+        if (index < 0) { index += static_cast<std::ptrdiff_t>(array.size()); }
+        if (index < 0 || static_cast<std::size_t>(index) >= array.size()) { return std::nullopt; }
+        return &array[static_cast<std::size_t>(index)];
+    }
+
+    static auto elements(node_t node) -> std::vector<node_t> {
+        auto elements = std::vector<node_t>{};
+        if (not node->is_array()) { return elements; }
+        for (auto const& element : node->array()) {
+            elements.push_back(&element);
+        }
+        return elements;
+    }
+
+    static auto children(node_t node) -> std::vector<node_t> {
+        if (not node->is_object()) { return elements(node); }
+        auto children = std::vector<node_t>{};
+        for (auto const& [_, value] : node->object()) {
+            children.push_back(&value);
+        }
+        return children;
+    }
+};
+
+// how the evaluator moves through raw input, skipping what is off the path
+struct LazyAccess {
+    using node_t = LazyValue;
+
+    static auto member(node_t node, PathStep const& step) -> std::optional<node_t> {
+        switch (node.type()) {
+        case Type::Object: return node.find(step.key);
+        case Type::Array: {
+            if (step.key_index == std::string_view::npos) { return std::nullopt; }
+            return node.find(step.key_index);
+        }
+        default: return std::nullopt;
+        }
+    }
+
+    static auto element(node_t node, std::ptrdiff_t index) -> std::optional<node_t> {
+        if (node.type() != Type::Array) { return std::nullopt; }
+        if (index >= 0) { return node.find(static_cast<std::size_t>(index)); }
+
+        // counting from the end needs the size first
+        auto const all = node.elements();
+        index += static_cast<std::ptrdiff_t>(all.size());
+        if (index < 0) { return std::nullopt; }
+        return all[static_cast<std::size_t>(index)];
+    }
+
+    static auto elements(node_t node) -> std::vector<node_t> {
+        if (node.type() != Type::Array) { return {}; }
+        return node.elements();
+    }
+
+    static auto children(node_t node) -> std::vector<node_t> {
+        if (node.type() != Type::Object) { return elements(node); }
+        auto children = std::vector<node_t>{};
+        for (auto const& [_, value] : node.members()) {
+            children.push_back(value);
+        }
+        return children;
+    }
+};
+
+// Depth first, so matches come in document order. Returns true once
+// `first_only` has its match
+template <typename Access>
+auto evaluate(std::vector<PathStep> const& steps, std::size_t i,
+              typename Access::node_t node,
+              std::vector<typename Access::node_t>& matches, bool first_only) -> bool {
+    if (i == steps.size()) {
+        matches.push_back(node);
+        return first_only;
+    }
+
+    auto const& step = steps[i];
+    switch (step.kind) {
+
+    case PathStep::Kind::Member: {
+        auto const child = Access::member(node, step);
+        return child && evaluate<Access>(steps, i + 1, *child, matches, first_only);
+    }
+    case PathStep::Kind::Index: {
+        auto const child = Access::element(node, step.index);
+        return child && evaluate<Access>(steps, i + 1, *child, matches, first_only);
+    }
+    case PathStep::Kind::Wildcard: {
+        for (auto const& child : Access::children(node)) {
+            if (evaluate<Access>(steps, i + 1, child, matches, first_only)) { return true; }
+        }
+        return false;
+    }
+    case PathStep::Kind::Slice: {
+        auto const elements = Access::elements(node);
+        auto const [begin, end] = slice_range(step, elements.size());
+        for (auto at = begin; at < end; at += static_cast<std::size_t>(step.step)) {
+            if (evaluate<Access>(steps, i + 1, elements[at], matches, first_only)) { return true; }
+        }
+        return false;
+    }
+
+    }
+    return false;
+}
+
+} // namespace
+
+// JsonPath member functions
+
+JsonPath::JsonPath(std::vector<PathStep> steps)
+    : steps_(std::move(steps)) { }
+
+auto JsonPath::pointer(std::string_view pointer) -> JsonPath {
+    auto steps = std::vector<PathStep>{};
+    if (pointer.empty()) { return JsonPath(std::move(steps)); }
+    if (pointer.front() != '/') {
+        throw JsonException("Path error at column 1 of \"" + std::string(pointer) + "\": A JSON Pointer starts with \"/\"");
+    }
+
+    for (std::size_t i = 1; i <= pointer.size();) {
+        auto key = std::string{};
+        for (; i < pointer.size() && pointer[i] != '/'; ++i) {
+            if (pointer[i] != '~') {
+                key += pointer[i];
+                continue;
+            }
+            auto const next = i + 1 < pointer.size() ? pointer[i + 1] : '\0';
+            if (next != '0' && next != '1') {
+                std::stringstream ss;
+                ss << "Path error at column " << i + 1 << " of \"" << pointer << "\": \"~\" must be followed by 0 or 1";
+                throw JsonException(ss.str());
+            }
+            key += next == '0' ? '~' : '/';
+            ++i;
+        }
+        steps.push_back(member_step(std::move(key)));
+        ++i;
+    }
+    return JsonPath(std::move(steps));
+}
+
+auto JsonPath::compile(std::string_view expression) -> JsonPath {
+    return JsonPath(PathCompiler(expression).compile());
+}
+
+auto JsonPath::find(Json const& root) const -> Json const* {
+    auto matches = std::vector<Json const*>{};
+    evaluate<JsonAccess>(steps_, 0, &root, matches, true);
+    return matches.empty() ? nullptr : matches.front();
+}
+
+auto JsonPath::find(LazyValue root) const -> std::optional<LazyValue> {
+    auto matches = std::vector<LazyValue>{};
+    evaluate<LazyAccess>(steps_, 0, root, matches, true);
+    if (matches.empty()) { return std::nullopt; }
+    return matches.front();
+}
+
+auto JsonPath::select(Json const& root) const -> std::vector<Json const*> {
+    auto matches = std::vector<Json const*>{};
+    evaluate<JsonAccess>(steps_, 0, &root, matches, false);
+    return matches;
+}
+
+auto JsonPath::select(LazyValue root) const -> std::vector<LazyValue> {
+    auto matches = std::vector<LazyValue>{};
+    evaluate<LazyAccess>(steps_, 0, root, matches, false);
+    return matches;
+}
+
+auto JsonPath::steps() const noexcept -> std::vector<PathStep> const& {
+    return steps_;
+}
+
+} // namespace json
@@ -0,0 +1,755 @@
+#include "json_parser/JsonSchema.h"
+#include "json_parser/JsonException.h"
+#include "json_parser/Serializer.h"
+#include "json_parser/detail/Parser.h"
+#include "json_parser/detail/Regex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+
+namespace json {
+
+// helpers
+
+namespace {
+
+constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+// the types a schema accepts, "integer" apart from "number"
+enum TypeBits : unsigned {
+    null_bit    = 1u << 0,
+    boolean_bit = 1u << 1,
+    number_bit  = 1u << 2,
+    string_bit  = 1u << 3,
+    array_bit   = 1u << 4,
+    object_bit  = 1u << 5,
+    integer_bit = 1u << 6,
+    all_types   = (1u << 7) - 1,
+};
+
+auto type_bit(Type const type) -> unsigned {
+    switch (type) {
+    case Type::Null:    return null_bit;
+    case Type::Boolean: return boolean_bit;
+    case Type::Number:  return number_bit;
+    case Type::String:  return string_bit;
+    case Type::Array:   return array_bit;
+    case Type::Object:  return object_bit;
+    }
+    return 0;
+}
+
+struct Property {
+    std::string name;
+    std::size_t node;       // none when only required
+    std::size_t required;   // index in SchemaNode::required, none when optional
+    bool declared;          // in "properties", so not an additional property
+};
+
+// A compiled schema. Child schemas are indices into SchemaProgram::nodes
+struct SchemaNode {
+    bool reject_all = false;    // the false schema
+    unsigned types = all_types;
+    std::vector<Property> properties;   // sorted by name
+    std::vector<std::string> required;
+    std::size_t additional = none;
+    std::size_t items = none;
+    bool has_enum = false;
+    std::vector<Json> enum_values;
+    // exact, like the numbers of the instances
+    std::optional<Number> minimum;
+    std::optional<Number> maximum;
+    std::optional<Number> exclusive_minimum;
+    std::optional<Number> exclusive_maximum;
+    std::size_t min_length = 0;
+    std::size_t max_length = none;
+    std::optional<Regex> pattern;
+    std::string pattern_text;
+    std::size_t min_items = 0;
+    std::size_t max_items = none;
+    std::size_t min_properties = 0;
+    std::size_t max_properties = none;
+
+    [[nodiscard]] auto find_property(std::string_view name) const -> Property const* {
+        auto const it = std::lower_bound(properties.begin(), properties.end(), name,
+            [](Property const& property, std::string_view key) { return property.name < key; });
+        return it != properties.end() && it->name == name ? &*it : nullptr;
+    }
+};
+
+auto number_of(Json const& json) -> Number {
+    switch (json.number_kind()) {
+    case Number::Kind::Int:    return Number::from(json.integer());
+    case Number::Kind::UInt:   return Number::from(json.unsigned_integer());
+    case Number::Kind::Double: break;
+    }
+    return Number::from(json.number());
+}
+
+auto is_integral(Number const& number) -> bool {
+    return number.kind != Number::Kind::Double || (std::isfinite(number.d) && std::floor(number.d) == number.d);
+}
+
+auto to_text(Number const& number) -> std::string {
+    auto text = std::string{};
+    {
+        auto writer = Writer(text);
+        write_number(number, writer);
+    }
+    return text;
+}
+
+auto numbers_equal(Number const& a, Number const& b) -> bool {
+    if (a.kind == Number::Kind::Double || b.kind == Number::Kind::Double) { return a.to_double() == b.to_double(); }
+    if (a.kind != b.kind) { return false; }     // an Int is never above the int64_t range
+    return a.kind == Number::Kind::Int ? a.i == b.i : a.u == b.u;
+}
+
+// -1, 0 or 1 as `a` is below, equal to or above `b`. Two integers compare
+// exactly, as doubles only when one of them is a double
+auto compare_numbers(Number const& a, Number const& b) -> int {
+    if (a.kind == Number::Kind::Double || b.kind == Number::Kind::Double) {
+        auto const x = a.to_double();
+        auto const y = b.to_double();
+        return x < y ? -1 : (x > y ? 1 : 0);
+    }
+    if (a.kind == Number::Kind::Int && b.kind == Number::Kind::Int) { return a.i < b.i ? -1 : (a.i > b.i ? 1 : 0); }
+    // a negative Int is below every UInt, the others compare as unsigned
+    if (a.kind == Number::Kind::Int && a.i < 0) { return -1; }
+    if (b.kind == Number::Kind::Int && b.i < 0) { return 1; }
+    auto const x = a.kind == Number::Kind::Int ? static_cast<std::uint64_t>(a.i) : a.u;
+    auto const y = b.kind == Number::Kind::Int ? static_cast<std::uint64_t>(b.i) : b.u;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// equality of JSON Schema: numbers by value, objects regardless of member order
+auto json_equal(Json const& a, Json const& b) -> bool {
+    if (a.type() != b.type()) { return false; }
+    switch (a.type()) {
+    case Type::Null:    return true;
+    case Type::Boolean: return a.boolean() == b.boolean();
+    case Type::Number:  return numbers_equal(number_of(a), number_of(b));
+    case Type::String:  return a.string() == b.string();
+    case Type::Array: {
+        auto const& x = a.array();
+        auto const& y = b.array();
+        return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin(), json_equal);
+    }
+    case Type::Object: {
+        auto const& x = a.object();
+        auto const& y = b.object();
+        if (x.size() != y.size()) { return false; }
+        return std::all_of(x.begin(), x.end(), [&](auto const& member) {
+            auto const it = y.find(member.first);
+            return it != y.end() && json_equal(member.second, it->second);
+        });
+    }
+    }
+    return false;
+}
+
+// appends a JSON Pointer reference token, "~" and "/" escaped
+void append_token(std::string& path, std::string_view token) {
+    path += '/';
+    for (auto const c : token) {
+        if      (c == '~') { path += "~0"; }
+        else if (c == '/') { path += "~1"; }
+        else               { path += c; }
+    }
+}
+
+void append_token(std::string& path, std::size_t index) {
+    path += '/';
+    path += std::to_string(index);
+}
+
+auto code_points(std::string_view text) -> std::size_t {
+    return static_cast<std::size_t>(std::count_if(text.begin(), text.end(),
+        [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+}
+
+// Turns schema Json into SchemaNodes, depth first
+class SchemaCompiler {
+public:
+
+    explicit SchemaCompiler(std::vector<SchemaNode>& nodes)
+        : nodes_(nodes), path_() { }
+
+    auto compile(Json const& schema) -> std::size_t {
+        auto const index = nodes_.size();
+        nodes_.emplace_back();
+        if (schema.is_bool()) {
+            nodes_[index].reject_all = not schema.boolean();
+            return index;
+        }
+        if (not schema.is_object()) { fail("A schema is an object or a boolean"); }
+
+        // nodes_ grows while children compile, the node is filled in afterwards
+        auto node = SchemaNode{};
+        auto const& object = schema.object();
+        for (auto const& [key, value] : object) {
+            auto const size = path_.size();
+            append_token(path_, key.view());
+            compile_keyword(node, key.view(), value);
+            path_.resize(size);
+        }
+        link_required(node);
+        nodes_[index] = std::move(node);
+        return index;
+    }
+
+private:
+
+    void compile_keyword(SchemaNode& node, std::string_view keyword, Json const& value) {
+        if (keyword == "type") {
+            node.types = 0;
+            if (value.is_string()) {
+                node.types = type_named(value.string());
+            } else if (value.is_array() && not value.array().empty()) {
+                for (auto const& name : value.array()) {
+                    if (not name.is_string()) { fail("Type names are strings"); }
+                    node.types |= type_named(name.string());
+                }
+            } else {
+                fail("\"type\" is a type name or a non-empty array of them");
+            }
+        } else if (keyword == "properties") {
+            if (not value.is_object()) { fail("\"properties\" is an object of schemas"); }
+            for (auto const& [name, schema] : value.object()) {
+                auto const size = path_.size();
+                append_token(path_, name.view());
+                node.properties.push_back({ std::string(name.view()), compile(schema), none, true });
+                path_.resize(size);
+            }
+        } else if (keyword == "required") {
+            if (not value.is_array()) { fail("\"required\" is an array of property names"); }
+            for (auto const& name : value.array()) {
+                if (not name.is_string()) { fail("\"required\" is an array of property names"); }
+                node.required.emplace_back(name.string());
+            }
+        } else if (keyword == "additionalProperties") {
+            node.additional = compile(value);
+        } else if (keyword == "items") {
+            node.items = compile(value);
+        } else if (keyword == "enum") {
+            if (not value.is_array()) { fail("\"enum\" is an array of values"); }
+            node.has_enum = true;
+            node.enum_values.assign(value.array().begin(), value.array().end());
+        } else if (keyword == "minimum") {
+            node.minimum = bound(value);
+        } else if (keyword == "maximum") {
+            node.maximum = bound(value);
+        } else if (keyword == "exclusiveMinimum") {
+            node.exclusive_minimum = bound(value);
+        } else if (keyword == "exclusiveMaximum") {
+            node.exclusive_maximum = bound(value);
+        } else if (keyword == "minLength") {
+            node.min_length = count(value);
+        } else if (keyword == "maxLength") {
+            node.max_length = count(value);
+        } else if (keyword == "minItems") {
+            node.min_items = count(value);
+        } else if (keyword == "maxItems") {
+            node.max_items = count(value);
+        } else if (keyword == "minProperties") {
+            node.min_properties = count(value);
+        } else if (keyword == "maxProperties") {
+            node.max_properties = count(value);
+        } else if (keyword == "pattern") {
+            if (not value.is_string()) { fail("\"pattern\" is a regular expression string"); }
+            node.pattern_text = value.string();
+            try {
+                node.pattern.emplace(node.pattern_text);
+            } catch (JsonException const& e) {
+                fail(e.what());
+            }
+        }
+        // anything else is an annotation or unsupported, and ignored
+    }
+
+    // required names get an entry in the sorted properties, so one lookup
+    // per member finds both its schema and whether it is required
+    static void link_required(SchemaNode& node) {
+        auto const by_name = [](Property const& a, Property const& b) { return a.name < b.name; };
+        std::sort(node.properties.begin(), node.properties.end(), by_name);
+        for (std::size_t i = 0; i < node.required.size(); ++i) {
+            auto const& name = node.required[i];
+            auto const it = std::lower_bound(node.properties.begin(), node.properties.end(), Property{ name, none, none, false },
+                                             by_name);
+            if (it != node.properties.end() && it->name == name) {
+                it->required = i;
+            } else {
+                node.properties.insert(it, { name, none, i, false });
+            }
+        }
+    }
+
+    auto type_named(std::string_view name) -> unsigned {
+        if (name == "null")    { return null_bit; }
+        if (name == "boolean") { return boolean_bit; }
+        if (name == "number")  { return number_bit; }
+        if (name == "integer") { return integer_bit; }
+        if (name == "string")  { return string_bit; }
+        if (name == "array")   { return array_bit; }
+        if (name == "object")  { return object_bit; }
+        fail("Unknown type \"" + std::string(name) + "\"");
+        return 0;
+    }
+
+    auto bound(Json const& value) -> Number {
+        if (not value.is_number()) { fail("Expected a number"); }
+        return number_of(value);
+    }
+
+    auto count(Json const& value) -> std::size_t {
+        if (not value.is_number() || not is_integral(number_of(value)) || value.number() < 0) {
+            fail("Expected a non-negative integer");
+        }
+        // 1e300 is integral too
+        auto integer = std::uint64_t{0};
+        if (not number_of(value).to_uint64(integer) || integer > std::numeric_limits<std::size_t>::max()) {
+            fail("Expected an integer no larger than " + std::to_string(std::numeric_limits<std::size_t>::max()));
+        }
+        return integer;
+    }
+
+    void fail(std::string const& message) const {
+        throw JsonException("Schema error at \"" + path_ + "\": " + message);
+    }
+
+private:
+
+    std::vector<SchemaNode>& nodes_;
+    std::string path_;
+};
+
+// The checks of one validation, shared by the Json and the streaming validators
+class Checker {
+public:
+
+    Checker(std::vector<SchemaNode> const& nodes, ValidateOptions options)
+        : nodes_(nodes), options_(options), violations_() { }
+
+    [[nodiscard]] auto full() const noexcept -> bool { return violations_.size() >= options_.max_violations; }
+    [[nodiscard]] auto node(std::size_t index) const -> SchemaNode const& { return nodes_[index]; }
+    [[nodiscard]] auto result() && -> std::vector<SchemaViolation> { return std::move(violations_); }
+
+    // The node a value with `type` is further checked against, none when
+    // the false schema or the type check fails
+    auto check_type(std::size_t index, Type type, bool integral, std::string const& path) -> std::size_t {
+        if (index == none) { return none; }
+        auto const& schema = nodes_[index];
+        if (schema.reject_all) {
+            report(path, "false", "No value is allowed here");
+            return none;
+        }
+        auto const accepted = (schema.types & type_bit(type)) != 0
+                           || (type == Type::Number && integral && (schema.types & integer_bit) != 0);
+        if (not accepted) {
+            report(path, "type", "Expected " + type_names(schema.types) + ", found " + describe(type, integral));
+            return none;
+        }
+        return index;
+    }
+
+    void check_number(SchemaNode const& schema, Number const& number, std::string const& path) {
+        if (schema.minimum && compare_numbers(number, *schema.minimum) < 0) {
+            report(path, "minimum", "Value " + to_text(number) + " is below the minimum " + to_text(*schema.minimum));
+        }
+        if (schema.maximum && compare_numbers(number, *schema.maximum) > 0) {
+            report(path, "maximum", "Value " + to_text(number) + " is above the maximum " + to_text(*schema.maximum));
+        }
+        if (schema.exclusive_minimum && compare_numbers(number, *schema.exclusive_minimum) <= 0) {
+            report(path, "exclusiveMinimum", "Value " + to_text(number) + " is not above "
+                                             + to_text(*schema.exclusive_minimum));
+        }
+        if (schema.exclusive_maximum && compare_numbers(number, *schema.exclusive_maximum) >= 0) {
+            report(path, "exclusiveMaximum", "Value " + to_text(number) + " is not below "
+                                             + to_text(*schema.exclusive_maximum));
+        }
+    }
+
+    void check_string(SchemaNode const& schema, std::string_view text, std::string const& path) {
+        if (schema.min_length != 0 || schema.max_length != none) {
+            auto const length = code_points(text);
+            if (length < schema.min_length) {
+                report(path, "minLength", "String is shorter than " + std::to_string(schema.min_length) + " characters");
+            }
+            if (length > schema.max_length) {
+                report(path, "maxLength", "String is longer than " + std::to_string(schema.max_length) + " characters");
+            }
+        }
+        if (schema.pattern && not schema.pattern->search(text)) {
+            report(path, "pattern", "String does not match the pattern \"" + schema.pattern_text + "\"");
+        }
+    }
+
+    void check_items(SchemaNode const& schema, std::size_t size, std::string const& path) {
+        if (size < schema.min_items) {
+            report(path, "minItems", "Array has fewer than " + std::to_string(schema.min_items) + " items");
+        }
+        if (size > schema.max_items) {
+            report(path, "maxItems", "Array has more than " + std::to_string(schema.max_items) + " items");
+        }
+    }
+
+    void check_properties(SchemaNode const& schema, std::size_t size, std::string const& path) {
+        if (size < schema.min_properties) {
+            report(path, "minProperties",
+                   "Object has fewer than " + std::to_string(schema.min_properties) + " properties");
+        }
+        if (size > schema.max_properties) {
+            report(path, "maxProperties",
+                   "Object has more than " + std::to_string(schema.max_properties) + " properties");
+        }
+    }
+
+    void missing_property(std::string_view name, std::string const& path) {
+        report(path, "required", "Missing required property \"" + std::string(name) + "\"");
+    }
+
+    void check_enum(SchemaNode const& schema, Json const& value, std::string const& path) {
+        auto const found = std::any_of(schema.enum_values.begin(), schema.enum_values.end(),
+                                       [&](Json const& allowed) { return json_equal(allowed, value); });
+        if (not found) { report(path, "enum", "Value is not one of the enum values"); }
+    }
+
+    // The node of the member `name` of an object checked against `index`,
+    // `path` being the one of the member
+    auto member_node(std::size_t index, std::string_view name, std::string const& path) -> std::size_t {
+        if (index == none) { return none; }
+        auto const& schema = nodes_[index];
+        if (auto const* property = schema.find_property(name); property != nullptr && property->declared) {
+            return property->node;
+        }
+        if (schema.additional != none && nodes_[schema.additional].reject_all) {
+            report(path, "additionalProperties", "Property \"" + std::string(name) + "\" is not allowed");
+            return none;
+        }
+        return schema.additional;
+    }
+
+private:
+
+    void report(std::string const& path, char const* keyword, std::string message) {
+        if (full()) { return; }
+        violations_.push_back({ path, keyword, std::move(message) });
+    }
+
+    static auto describe(Type type, bool integral) -> std::string {
+        if (type == Type::Number && integral) { return "integer"; }
+        return to_string(type);
+    }
+
+    static auto type_names(unsigned types) -> std::string {
+        constexpr std::pair<unsigned, char const*> names[] = {
+            { null_bit, "null" }, { boolean_bit, "boolean" }, { number_bit, "number" }, { integer_bit, "integer" },
+            { string_bit, "string" }, { array_bit, "array" }, { object_bit, "object" },
+        };
+        auto text = std::string{};
+        for (auto const& [bit, name] : names) {
+            if ((types & bit) == 0) { continue; }
+            if (not text.empty()) { text += " or "; }
+            text += name;
+        }
+        return text;
+    }
+
+private:
+
+    std::vector<SchemaNode> const& nodes_;
+    ValidateOptions options_;
+    std::vector<SchemaViolation> violations_;
+};
+
+// Validates a built Json
+class TreeValidator {
+public:
+
+    explicit TreeValidator(Checker& checker)
+        : checker_(checker), path_() { }
+
+    void validate(Json const& value, std::size_t index) {
+        if (index == none || checker_.full()) { return; }
+        auto const type = value.type();
+        auto const number = type == Type::Number ? number_of(value) : Number::from(std::int64_t{0});
+        index = checker_.check_type(index, type, type == Type::Number && is_integral(number), path_);
+        if (index == none) { return; }
+        auto const& schema = checker_.node(index);
+
+        switch (type) {
+        case Type::Null:
+        case Type::Boolean:
+            break;
+        case Type::Number:
+            checker_.check_number(schema, number, path_);
+            break;
+        case Type::String:
+            checker_.check_string(schema, value.string(), path_);
+            break;
+        case Type::Array: {
+            auto const& array = value.array();
+            auto const size = path_.size();
+            for (std::size_t i = 0; i < array.size() && schema.items != none; ++i) {
+                append_token(path_, i);
+                validate(array[i], schema.items);
+                path_.resize(size);
+            }
+            checker_.check_items(schema, array.size(), path_);
+            break;
+        }
+        case Type::Object: {
+            auto const& object = value.object();
+            auto const size = path_.size();
+            for (auto const& [key, member] : object) {
+                append_token(path_, key.view());
+                validate(member, checker_.member_node(index, key.view(), path_));
+                path_.resize(size);
+            }
+            checker_.check_properties(schema, object.size(), path_);
+            for (auto const& name : schema.required) {
+                if (object.find(name) == object.end()) { checker_.missing_property(name, path_); }
+            }
+            break;
+        }
+        }
+        if (schema.has_enum) { checker_.check_enum(schema, value, path_); }
+    }
+
+private:
+
+    Checker& checker_;
+    std::string path_;
+};
+
+/*
+Parser handler validating values as they are reported. Values checked
+against an enum are built as a Json, together with everything inside them,
+and compared once complete; nothing else is built.
+*/
+class StreamValidator {
+public:
+
+    explicit StreamValidator(Checker& checker)
+        : checker_(checker), frames_(), path_(), pending_(0), seen_(), keys_(), open_objects_(0), duplicate_key_(),
+          building_() { }
+
+    auto on_null() -> bool                      { return scalar(Type::Null, false, {}, {}); }
+    auto on_bool(bool value) -> bool            { return scalar(Type::Boolean, value, {}, {}); }
+    auto on_number(double value) -> bool        { return scalar(Type::Number, false, Number::from(value), {}); }
+    auto on_integer(std::int64_t value) -> bool { return scalar(Type::Number, false, Number::from(value), {}); }
+    auto on_unsigned(std::uint64_t value) -> bool {
+        return scalar(Type::Number, false, Number::from(value), {});
+    }
+    auto on_string(std::string_view value) -> bool {
+        return scalar(Type::String, false, Number::from(std::int64_t{0}), value);
+    }
+
+    auto on_start_array() -> bool  { return start(Type::Array); }
+    auto on_start_object() -> bool { return start(Type::Object); }
+
+    // returns false on a duplicate key, see duplicate_key()
+    auto on_key(std::string_view key) -> bool {
+        if (not keys_[open_objects_ - 1].emplace(key).second) {
+            duplicate_key_.emplace(key);
+            return false;
+        }
+        auto& frame = frames_.back();
+        ++frame.count;
+        append_token(path_, key);
+        pending_ = checker_.member_node(frame.node, key, path_);
+        if (frame.node != none) {
+            auto const* property = checker_.node(frame.node).find_property(key);
+            if (property != nullptr && property->required != none) { seen_[frame.seen + property->required] = 1; }
+        }
+        if (frame.built) { building_.back().key.assign(key); }
+        return not checker_.full();
+    }
+
+    auto on_end_array() -> bool {
+        auto const frame = frames_.back();
+        frames_.pop_back();
+        if (frame.node != none) { checker_.check_items(checker_.node(frame.node), frame.count, path_); }
+        return end(frame);
+    }
+
+    auto on_end_object() -> bool {
+        auto const frame = frames_.back();
+        frames_.pop_back();
+        if (frame.node != none) {
+            auto const& schema = checker_.node(frame.node);
+            checker_.check_properties(schema, frame.count, path_);
+            for (std::size_t i = 0; i < schema.required.size(); ++i) {
+                if (seen_[frame.seen + i] == 0) { checker_.missing_property(schema.required[i], path_); }
+            }
+        }
+        seen_.resize(frame.seen);
+        --open_objects_;
+        return end(frame);
+    }
+
+    // the key the validator stopped on, if any
+    [[nodiscard]] auto duplicate_key() const noexcept -> std::optional<std::string> const& {
+        return duplicate_key_;
+    }
+
+private:
+
+    struct Frame {
+        Type type;
+        std::size_t node;       // none when unchecked
+        std::size_t path_size;  // of the container's own path
+        std::size_t count;      // elements or members so far
+        std::size_t seen;       // where the required flags start in seen_
+        bool built;             // pushed on building_
+    };
+
+    struct Built {
+        Json value;
+        std::string key;        // of the member being built, in an object
+    };
+
+    // the node of the value starting now, whose path is pushed
+    auto begin_value() -> std::size_t {
+        if (frames_.empty()) { return 0; }
+        auto& frame = frames_.back();
+        if (frame.type == Type::Object) { return pending_; }    // on_key pushed the path
+        append_token(path_, frame.count++);
+        return frame.node == none ? none : checker_.node(frame.node).items;
+    }
+
+    // back to the path of the enclosing container
+    void end_value() {
+        if (not frames_.empty()) { path_.resize(frames_.back().path_size); }
+    }
+
+    auto scalar(Type type, bool boolean, Number number, std::string_view string) -> bool {
+        auto const index = checker_.check_type(begin_value(), type, type == Type::Number && is_integral(number), path_);
+        auto const* schema = index == none ? nullptr : &checker_.node(index);
+        if (schema != nullptr) {
+            if (type == Type::Number) { checker_.check_number(*schema, number, path_); }
+            if (type == Type::String) { checker_.check_string(*schema, string, path_); }
+        }
+        auto const has_enum = schema != nullptr && schema->has_enum;
+        if (has_enum || not building_.empty()) {
+            auto value = to_json(type, boolean, number, string);
+            if (has_enum) { checker_.check_enum(*schema, value, path_); }
+            if (not building_.empty()) { attach(std::move(value)); }
+        }
+        end_value();
+        return not checker_.full();
+    }
+
+    auto start(Type type) -> bool {
+        auto index = begin_value();
+        index = checker_.check_type(index, type, false, path_);
+        auto const build = not building_.empty() || (index != none && checker_.node(index).has_enum);
+        if (build) { building_.push_back({ Json(type), {} }); }
+
+        auto frame = Frame{ type, index, path_.size(), 0, seen_.size(), build };
+        if (type == Type::Object) {
+            seen_.resize(seen_.size() + (index == none ? 0 : checker_.node(index).required.size()), 0);
+            // the key sets of closed objects are kept for their buckets
+            if (keys_.size() == open_objects_) { keys_.emplace_back(); }
+            keys_[open_objects_++].clear();
+        }
+        frames_.push_back(frame);
+        return not checker_.full();
+    }
+
+    auto end(Frame const& frame) -> bool {
+        if (frame.built) {
+            auto value = std::move(building_.back().value);
+            building_.pop_back();
+            if (frame.node != none && checker_.node(frame.node).has_enum) {
+                checker_.check_enum(checker_.node(frame.node), value, path_);
+            }
+            if (not building_.empty()) { attach(std::move(value)); }
+        }
+        end_value();
+        return not checker_.full();
+    }
+
+    void attach(Json value) {
+        auto& parent = building_.back();
+        if (parent.value.is_array()) { parent.value.array().push_back(std::move(value)); }
+        else                         { parent.value.object()[parent.key] = std::move(value); }
+    }
+
+    static auto to_json(Type type, bool boolean, Number const& number, std::string_view string) -> Json {
+        switch (type) {
+        case Type::Boolean: return Json(boolean);
+        case Type::String:  return Json(string);
+        case Type::Number: {
+            switch (number.kind) {
+            case Number::Kind::Int:    return Json(number.i);
+            case Number::Kind::UInt:   return Json(number.u);
+            case Number::Kind::Double: return Json(number.d);
+            }
+            break;
+        }
+        default: break;
+        }
+        return Json();
+    }
+
+private:
+
+    Checker& checker_;
+    std::vector<Frame> frames_;
+    std::string path_;
+    std::size_t pending_;           // node of the member value after on_key
+    std::vector<char> seen_;        // required properties seen, per open object
+    std::vector<std::unordered_set<std::string>> keys_;    // the first open_objects_ are the open objects'
+    std::size_t open_objects_;
+    std::optional<std::string> duplicate_key_;
+    std::vector<Built> building_;
+};
+
+} // namespace
+
+struct SchemaProgram {
+    std::vector<SchemaNode> nodes;  // the root schema first
+};
+
+// JsonSchema member functions
+
+JsonSchema::JsonSchema(std::shared_ptr<SchemaProgram const> program) noexcept
+    : program_(std::move(program)) { }
+
+auto JsonSchema::compile(Json const& schema) -> JsonSchema {
+    auto program = std::make_shared<SchemaProgram>();
+    static_cast<void>(SchemaCompiler(program->nodes).compile(schema));
+    return JsonSchema(std::move(program));
+}
+
+auto JsonSchema::validate(Json const& instance, ValidateOptions options) const -> std::vector<SchemaViolation> {
+    auto checker = Checker(program_->nodes, options);
+    TreeValidator(checker).validate(instance, 0);
+    return std::move(checker).result();
+}
+
+auto JsonSchema::validate(std::string_view source, ValidateOptions options) const -> std::vector<SchemaViolation> {
+    auto checker = Checker(program_->nodes, options);
+    auto validator = StreamValidator(checker);
+    auto parser = Parser<StreamValidator>(Scanner(source), validator);
+    // like parse_string, a duplicate key is an error of the input
+    if (not parser.parse() && validator.duplicate_key()) {
+        parser.fail("Key \"" + *validator.duplicate_key() + "\" already exist");
+    }
+    return std::move(checker).result();
+}
+
+auto JsonSchema::is_valid(Json const& instance) const -> bool {
+    return validate(instance, ValidateOptions{ 1 }).empty();
+}
+
+auto JsonSchema::is_valid(std::string_view source) const -> bool {
+    return validate(source, ValidateOptions{ 1 }).empty();
+}
+
+} // namespace json
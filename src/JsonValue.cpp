@@ -1,13 +1,41 @@
 #include "json_parser/JsonValue.h"
-#include <sstream>
+#include "json_parser/Serializer.h"
 #include <cassert>
-#include <numeric>
+#include <new>
+#include <sstream>
+#include <utility>
 
 namespace json {
 
 // helpers
 
-inline static auto to_string(Type type) -> char const* {
+static auto cast_exception(Type from, Type to) -> JsonException {
+    std::stringstream ss;
+    ss << "Invalid cast from " << to_string(from) << " to " << to_string(to);
+    return JsonException(ss.str());
+}
+
+static_assert(sizeof(Json) == 16, "a Json node takes 16 bytes");
+
+static constexpr std::size_t size_byte = Json::inline_capacity;
+
+// out of line storage of strings and containers, allocated from their own resource
+template <typename T>
+static auto make_node(T value) -> T* {
+    auto* const resource = value.get_allocator().resource();
+    return new (resource->allocate(sizeof(T), alignof(T))) T(std::move(value));
+}
+
+template <typename T>
+static void free_node(T* node) noexcept {
+    auto* const resource = node->get_allocator().resource();
+    node->~T();
+    resource->deallocate(node, sizeof(T), alignof(T));
+}
+
+// free functions
+
+auto to_string(Type type) noexcept -> char const* {
     switch (type) {
     case Type::Null:    return "null";
     case Type::Boolean: return "boolean";
@@ -20,157 +48,246 @@ inline static auto to_string(Type type) -> char const* {
     return "";
 }
 
-static auto cast_exception(Type from, Type to) -> JsonException {
-    std::stringstream ss;
-    ss << "Invalid cast from " << to_string(from) << " to " << to_string(to);
-    return JsonException(ss.str());
+// Json member functions
+
+Json::Json(Type type)
+    : bytes_(), tag_(Tag::Null) {
+    switch (type) {
+    case Type::Null:    break;
+    case Type::Boolean: *this = Json(boolean_t{}); break;
+    case Type::Number:  *this = Json(number_t{});  break;
+    case Type::String:  tag_ = Tag::InlineString;  break;
+    case Type::Array:   *this = Json(array_t{});   break;
+    case Type::Object:  *this = Json(object_t{});  break;
+    }
 }
 
-static auto enclose(std::string str,
-                    std::string beg,
-                    std::string end) -> std::string {
-    return std::move(beg) + std::move(str) + std::move(end);
+Json::Json(Json const& other)
+    : bytes_(), tag_(other.tag_) {
+    switch (other.tag_) {
+    // own the copy, it may outlive the memory the original borrows from
+    case Tag::BorrowedString:
+    case Tag::OwnedString:
+        tag_ = Tag::Null;
+        set_string(other.string(), std::pmr::get_default_resource());
+        break;
+    case Tag::Array:  store(make_node<array_t>(*other.load<array_t*>()));   break;
+    case Tag::Object: store(make_node<object_t>(*other.load<object_t*>())); break;
+    default:          std::memcpy(bytes_, other.bytes_, sizeof bytes_);     break;
+    }
 }
 
-template <typename... Ts>
-struct overloaded : public Ts... { using Ts::operator()...; };
+Json::Json(string_t string)
+    : bytes_(), tag_(Tag::Null) {
+    if (string.size() <= inline_capacity) {
+        set_string(string, nullptr);
+    } else {
+        store(make_node(std::move(string)));
+        tag_ = Tag::OwnedString;
+    }
+}
 
-template <typename... Ts>
-overloaded(Ts...) -> overloaded<Ts...>;
+Json::Json(std::string_view string, std::pmr::memory_resource* resource)
+    : bytes_(), tag_(Tag::Null) {
+    set_string(string, resource);
+}
 
-// Json member functions
+Json::Json(char const* string)
+    : Json(std::string_view(string)) { }
 
-Json::Json(Type type)
-    :type_(type) {
-    switch (type_) {
-    case Type::Null:    value_ = null_t{};    break;
-    case Type::Boolean: value_ = boolean_t{}; break;
-    case Type::Number:  value_ = number_t{};  break;
-    case Type::String:  value_ = string_t{};  break;
-    case Type::Array:   value_ = array_t{};   break;
-    case Type::Object:  value_ = object_t{};  break;
+Json::Json(borrowed_string_t string)
+    : bytes_(), tag_(Tag::Null) {
+    auto const view = string.view;
+    if (view.size() <= inline_capacity || view.size() > std::numeric_limits<std::uint32_t>::max()) {
+        set_string(view, std::pmr::get_default_resource());
+        return;
     }
+    auto const size = static_cast<std::uint32_t>(view.size());
+    store(view.data());
+    std::memcpy(bytes_ + sizeof(char const*), &size, sizeof size);
+    tag_ = Tag::BorrowedString;
+}
+
+Json::Json(array_t array)
+    : bytes_(), tag_(Tag::Array) {
+    store(make_node(std::move(array)));
+}
+
+Json::Json(std::vector<Json> const& array)
+    : Json(array_t(array.begin(), array.end())) { }
+
+Json::Json(std::initializer_list<Json> list)
+    : Json(array_t(list)) { }
+
+Json::Json(object_t object)
+    : bytes_(), tag_(Tag::Object) {
+    store(make_node(std::move(object)));
+}
+
+auto Json::operator=(Json const& other) -> Json& {
+    return *this = Json(other);
+}
+
+auto Json::operator=(Json&& other) noexcept -> Json& {
+    // `other` may be part of this value, take it before releasing
+    Json taken(std::move(other));
+    if (tag_ >= Tag::OwnedString) { release(); }
+    std::memcpy(bytes_, taken.bytes_, sizeof bytes_);
+    tag_ = taken.tag_;
+    taken.tag_ = Tag::Null;
+    return *this;
 }
 
 auto Json::is_null() const noexcept -> bool {
-    return type_ == Type::Null;
+    return tag_ == Tag::Null;
 }
 auto Json::is_bool() const noexcept -> bool {
-    return type_ == Type::Boolean;
+    return tag_ == Tag::Boolean;
 }
 auto Json::is_number() const noexcept -> bool {
-    return type_ == Type::Number;
+    return Tag::Double <= tag_ && tag_ <= Tag::Unsigned;
 }
 auto Json::is_string() const noexcept -> bool {
-    return type_ == Type::String;
+    return Tag::InlineString <= tag_ && tag_ <= Tag::OwnedString;
 }
 auto Json::is_array() const noexcept -> bool {
-    return type_ == Type::Array;
+    return tag_ == Tag::Array;
 }
 auto Json::is_object() const noexcept -> bool {
-    return type_ == Type::Object;
+    return tag_ == Tag::Object;
 }
 
 auto Json::type() const noexcept -> Type {
-    return type_;
+    constexpr Type types[] = {
+        Type::Null, Type::Boolean, Type::Number, Type::Number, Type::Number,
+        Type::String, Type::String, Type::String, Type::Array, Type::Object,
+    };
+    return types[static_cast<std::size_t>(tag_)];
 }
 
 auto Json::boolean() const -> Json::boolean_t {
     if (not is_bool()) {
-        throw cast_exception(type_, Type::Boolean);
+        throw cast_exception(type(), Type::Boolean);
     }
-    return std::get<boolean_t>(value_);
+    return load<boolean_t>();
 }
 
 auto Json::number() const -> Json::number_t {
-    if (not is_number()) {
-        throw cast_exception(type_, Type::Number);
+    return as_number().to_double();
+}
+
+auto Json::is_integer() const noexcept -> bool {
+    return tag_ == Tag::Integer || tag_ == Tag::Unsigned;
+}
+
+auto Json::number_kind() const -> Number::Kind {
+    return as_number().kind;
+}
+
+auto Json::integer() const -> Json::integer_t {
+    auto value = integer_t{};
+    if (not as_number().to_int64(value)) {
+        throw JsonException("Number " + to_string() + " does not fit in a 64-bit integer");
+    }
+    return value;
+}
+
+auto Json::unsigned_integer() const -> Json::unsigned_t {
+    auto value = unsigned_t{};
+    if (not as_number().to_uint64(value)) {
+        throw JsonException("Number " + to_string() + " does not fit in a 64-bit unsigned integer");
+    }
+    return value;
+}
+
+auto Json::as_number() const -> Number {
+    switch (tag_) {
+    case Tag::Integer:  return Number::from(load<integer_t>());
+    case Tag::Unsigned: return Number::from(load<unsigned_t>());
+    case Tag::Double:   return Number::from(load<number_t>());
+    default:            throw cast_exception(type(), Type::Number);
     }
-    return std::get<number_t>(value_);
 }
 
 auto Json::string() -> Json::string_t& {
     if (not is_string()) {
-        throw cast_exception(type_, Type::String);
+        throw cast_exception(type(), Type::String);
     }
-    return std::get<string_t>(value_);
+    if (tag_ != Tag::OwnedString) {
+        auto* const owned = make_node(string_t(std::as_const(*this).string()));
+        store(owned);
+        tag_ = Tag::OwnedString;
+    }
+    return *load<string_t*>();
 }
 
-auto Json::string() const -> Json::string_t const& {
-    if (not is_string()) {
-        throw cast_exception(type_, Type::String);
+auto Json::string() const -> std::string_view {
+    switch (tag_) {
+    case Tag::InlineString:
+        return { reinterpret_cast<char const*>(bytes_), bytes_[size_byte] };
+    case Tag::BorrowedString: {
+        auto size = std::uint32_t{};
+        std::memcpy(&size, bytes_ + sizeof(char const*), sizeof size);
+        return { load<char const*>(), size };
+    }
+    case Tag::OwnedString:
+        return *load<string_t*>();
+    default:
+        throw cast_exception(type(), Type::String);
     }
-    return std::get<string_t>(value_);
 }
 
 auto Json::array() -> Json::array_t& {
     if (not is_array()) {
-        throw cast_exception(type_, Type::Array);
+        throw cast_exception(type(), Type::Array);
     }
-    return std::get<array_t>(value_);
+    return *load<array_t*>();
 }
 
 auto Json::array() const -> Json::array_t const& {
     if (not is_array()) {
-        throw cast_exception(type_, Type::Array);
+        throw cast_exception(type(), Type::Array);
     }
-    return std::get<array_t>(value_);
+    return *load<array_t*>();
 }
 
 auto Json::object() -> Json::object_t& {
     if (not is_object()) {
-        throw cast_exception(type_, Type::Object);
+        throw cast_exception(type(), Type::Object);
     }
-    return std::get<object_t>(value_);
+    return *load<object_t*>();
 }
 
 auto Json::object() const -> Json::object_t const& {
     if (not is_object()) {
-        throw cast_exception(type_, Type::Object);
+        throw cast_exception(type(), Type::Object);
     }
-    return std::get<object_t>(value_);
+    return *load<object_t*>();
 }
 
 auto Json::to_string() const -> std::string {
-    auto separate_by_space = [](std::string a, std::string b) {
-        return std::move(a) + ", " + std::move(b);
-    };
-    auto object_elem_ts = [](object_elem_t elem) {
-        auto&& [key, value] = std::move(elem);
-        return enclose(key, "\"", "\"") + ": " + value.to_string();
-    };
+    return serialize(*this);
+}
 
-    auto null_ts    = [](null_t)            -> std::string { return "null"; };
-    auto boolean_ts = [](boolean_t v)       -> std::string { return v ? "true" : "false"; };
-    auto string_ts  = [](string_t const& v) -> std::string { return enclose(v, "\"", "\""); };
-    auto number_ts  = [](number_t v)        -> std::string {
-        std::stringstream ss;
-        ss << v;
-        return ss.str();
-    };
-    auto array_ts   = [separate_by_space](array_t const& v) -> std::string {
-        auto s = std::transform_reduce(std::next(v.begin()), v.end(),
-            (*v.begin()).to_string(),
-            separate_by_space,
-            [](Json const& j) { return j.to_string(); });
-        return enclose(std::move(s), "[ ", " ]");
-    };
-    auto object_ts = [separate_by_space, object_elem_ts](object_t const& v) -> std::string {
-        auto s = std::transform_reduce(std::next(v.begin()), v.end(),
-            object_elem_ts(*v.begin()),
-            separate_by_space,
-            object_elem_ts);
-        return enclose(std::move(s), "{ ", " }");
-    };
+void Json::set_string(std::string_view string, std::pmr::memory_resource* resource) {
+    if (string.size() <= inline_capacity) {
+        std::memcpy(bytes_, string.data(), string.size());
+        bytes_[size_byte] = static_cast<unsigned char>(string.size());
+        tag_ = Tag::InlineString;
+        return;
+    }
+    store(make_node(string_t(string, resource)));
+    tag_ = Tag::OwnedString;
+}
 
-    return std::visit(overloaded{
-        null_ts,
-        boolean_ts,
-        number_ts,
-        string_ts,
-        array_ts,
-        object_ts
-    }, value_);
+void Json::release() noexcept {
+    switch (tag_) {
+    case Tag::OwnedString: free_node(load<string_t*>()); break;
+    case Tag::Array:       free_node(load<array_t*>());  break;
+    case Tag::Object:      free_node(load<object_t*>()); break;
+    default:               break;
+    }
+    tag_ = Tag::Null;
 }
 
-} // namespace json
\ No newline at end of file
+} // namespace json
@@ -0,0 +1,95 @@
+#include "json_parser/KeyDictionary.h"
+#include <cstring>
+#include <functional>
+
+namespace json {
+
+// KeyDictionary::Stats member functions
+
+auto KeyDictionary::Stats::hit_rate() const noexcept -> double {
+    if (lookups == 0) { return 0.0; }
+    return static_cast<double>(hits) / static_cast<double>(lookups);
+}
+
+// KeyDictionary member functions
+
+KeyDictionary::KeyDictionary(std::size_t const max_keys, std::size_t const max_key_size)
+    : max_keys_(max_keys)
+    , max_key_size_(max_key_size)
+    , key_count_(0)
+    , shards_() { }
+
+auto KeyDictionary::intern(std::string_view const key) -> InternedKey {
+    if (key.size() > max_key_size_) { return {}; }
+
+    auto& shard = shard_of(std::hash<std::string_view>{}(key));
+    auto const lock = std::lock_guard{ shard.mutex };
+
+    ++shard.lookups;
+    if (auto const it = shard.keys.find(key); it != shard.keys.end()) {
+        ++shard.hits;
+        return { it->data(), it->size(), this };
+    }
+    if (key_count_.fetch_add(1, std::memory_order_relaxed) >= max_keys_) {
+        key_count_.fetch_sub(1, std::memory_order_relaxed);
+        return {};
+    }
+
+    // one byte even for the empty key, so every key has its own address
+    auto* const data = static_cast<char*>(shard.storage.allocate(key.empty() ? 1 : key.size(), 1));
+    std::memcpy(data, key.data(), key.size());
+    auto const stored = std::string_view{ data, key.size() };
+    shard.keys.insert(stored);
+    shard.bytes += key.size();
+    return { stored.data(), stored.size(), this };
+}
+
+auto KeyDictionary::find(std::string_view const key) const -> InternedKey {
+    if (key.size() > max_key_size_) { return {}; }
+
+    auto const& shard = shard_of(std::hash<std::string_view>{}(key));
+    auto const lock = std::lock_guard{ shard.mutex };
+    auto const it = shard.keys.find(key);
+    if (it == shard.keys.end()) { return {}; }
+    return { it->data(), it->size(), this };
+}
+
+auto KeyDictionary::size() const -> std::size_t {
+    auto size = std::size_t{0};
+    for (auto const& shard : shards_) {
+        auto const lock = std::lock_guard{ shard.mutex };
+        size += shard.keys.size();
+    }
+    return size;
+}
+
+auto KeyDictionary::stats() const -> Stats {
+    auto stats = Stats{};
+    for (auto const& shard : shards_) {
+        auto const lock = std::lock_guard{ shard.mutex };
+        stats.keys += shard.keys.size();
+        stats.bytes += shard.bytes;
+        stats.lookups += shard.lookups;
+        stats.hits += shard.hits;
+    }
+    return stats;
+}
+
+auto KeyDictionary::max_keys() const noexcept -> std::size_t {
+    return max_keys_;
+}
+
+auto KeyDictionary::max_key_size() const noexcept -> std::size_t {
+    return max_key_size_;
+}
+
+auto KeyDictionary::shard_of(std::size_t const hash) noexcept -> Shard& {
+    // the high bits, the set buckets use the low ones
+    return shards_[(hash >> (sizeof(std::size_t) * 8 - 4)) % shard_count];
+}
+
+auto KeyDictionary::shard_of(std::size_t const hash) const noexcept -> Shard const& {
+    return shards_[(hash >> (sizeof(std::size_t) * 8 - 4)) % shard_count];
+}
+
+} // namespace json
@@ -0,0 +1,335 @@
+#include "json_parser/LazyDocument.h"
+#include "json_parser/JsonException.h"
+#include "json_parser/detail/Parser.h"
+#include "json_parser/detail/Scanner.h"
+#include "json_parser/detail/SourceLocation.h"
+#include "json_parser/detail/StructuralIndexer.h"
+#include <sstream>
+
+namespace json {
+
+// helpers
+
+inline static auto is_whitespace(char const c) -> bool {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline static auto skip_whitespace(std::string_view source, std::size_t offset) -> std::size_t {
+    while (offset < source.size() && is_whitespace(source[offset])) {
+        ++offset;
+    }
+    return offset;
+}
+
+[[noreturn]] static void parse_error(std::string_view source, std::string const& message, Token const& token) {
+    throw JsonException("Parse error at " + token.to_string(source) + ": " + message);
+}
+
+// Returns the offset just past the value starting at `offset`. Nothing is
+// validated: a malformed value ends somewhere the caller's next token
+// is not expected, or at the end of the source
+static auto skip_value(std::string_view source, std::size_t offset) -> std::size_t {
+    switch (source[offset]) {
+
+    case '{': case '[': {
+        // strings never appear in the structural index, so every bracket
+        // it reports is one of the document's structure
+        auto const rest = source.substr(offset);
+        auto indexer = StructuralIndexer(rest);
+        std::size_t depth = 0;
+        for (auto position = indexer.next(); position < rest.size(); position = indexer.next()) {
+            switch (rest[position]) {
+            case '{': case '[': ++depth; break;
+            case '}': case ']': {
+                if (--depth == 0) { return offset + position + 1; }
+                break;
+            }
+            default: break;
+            }
+        }
+        return source.size();
+    }
+    case '"': {
+        for (auto position = offset + 1;;) {
+            position = source.find_first_of("\"\\", position);
+            if (position == std::string_view::npos) { return source.size(); }
+            if (source[position] == '"') { return position + 1; }
+            position += 2;
+        }
+    }
+    default: {
+        auto const end = source.find_first_of(" \t\r\n,:[]{}\"", offset);
+        return end == std::string_view::npos ? source.size() : end;
+    }
+
+    }
+}
+
+namespace {
+
+// accepts everything, for validation only
+struct NullHandler {
+    auto on_null() -> bool                   { return true; }
+    auto on_bool(bool) -> bool               { return true; }
+    auto on_number(double) -> bool           { return true; }
+    auto on_string(std::string_view) -> bool { return true; }
+    auto on_key(std::string_view) -> bool    { return true; }
+    auto on_start_object() -> bool           { return true; }
+    auto on_end_object() -> bool             { return true; }
+    auto on_start_array() -> bool            { return true; }
+    auto on_end_array() -> bool              { return true; }
+};
+
+} // namespace
+
+// LazyValue member functions
+
+LazyValue::LazyValue(std::string_view source, std::size_t offset) noexcept
+    : source_(source), offset_(offset) { }
+
+auto LazyValue::type() const -> Type {
+    switch (source_[offset_]) {
+    case '{': return Type::Object;
+    case '[': return Type::Array;
+    case '"': return Type::String;
+    case 't': case 'f': return Type::Boolean;
+    case 'n': return Type::Null;
+    case '+': case '-':
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+        return Type::Number;
+    default: {
+        // the scanner reports invalid characters and literals itself
+        auto scanner = Scanner(source_, offset_);
+        parse_error(source_, "Invalid literal", scanner.next_token());
+    }
+    }
+}
+
+auto LazyValue::is_null() const -> bool {
+    if (type() != Type::Null) { return false; }
+    auto scanner = Scanner(source_, offset_);
+    return scanner.next_token().type == TokenType::Null;
+}
+
+auto LazyValue::get_bool() const -> bool {
+    auto scanner = Scanner(source_, offset_);
+    auto const token = scanner.next_token();
+    if (token.type != TokenType::True && token.type != TokenType::False) {
+        access_error(std::string("Invalid cast from ") + to_string(type()) + " to boolean");
+    }
+    return token.type == TokenType::True;
+}
+
+auto LazyValue::get_number() const -> double {
+    return as_number().to_double();
+}
+
+auto LazyValue::get_string() const -> std::string {
+    // an escaped string is unescaped into the scanner's scratch buffer
+    auto scanner = Scanner(source_, offset_);
+    auto const token = scanner.next_token();
+    if (token.type != TokenType::String) {
+        access_error(std::string("Invalid cast from ") + to_string(type()) + " to string");
+    }
+    return std::string(std::get<std::string_view>(token.literal));
+}
+
+auto LazyValue::find(std::string_view key) const -> std::optional<LazyValue> {
+    auto found = std::optional<LazyValue>{};
+    walk_members([&](std::string_view member_key, LazyValue value) {
+        if (member_key != key) { return false; }
+        found = value;
+        return true;
+    });
+    return found;
+}
+
+auto LazyValue::operator[](std::string_view key) const -> LazyValue {
+    auto const found = find(key);
+    if (not found) { access_error("Key \"" + std::string(key) + "\" does not exist"); }
+    return *found;
+}
+
+auto LazyValue::members() const -> std::vector<std::pair<std::string, LazyValue>> {
+    auto members = std::vector<std::pair<std::string, LazyValue>>{};
+    walk_members([&](std::string_view key, LazyValue value) {
+        members.emplace_back(key, value);
+        return false;
+    });
+    return members;
+}
+
+auto LazyValue::find(std::size_t index) const -> std::optional<LazyValue> {
+    auto found = std::optional<LazyValue>{};
+    std::size_t current = 0;
+    walk_elements([&](LazyValue value) {
+        if (current++ != index) { return false; }
+        found = value;
+        return true;
+    });
+    return found;
+}
+
+auto LazyValue::operator[](std::size_t index) const -> LazyValue {
+    auto const found = find(index);
+    if (not found) { access_error("Index " + std::to_string(index) + " is out of range"); }
+    return *found;
+}
+
+auto LazyValue::elements() const -> std::vector<LazyValue> {
+    auto elements = std::vector<LazyValue>{};
+    walk_elements([&](LazyValue value) {
+        elements.push_back(value);
+        return false;
+    });
+    return elements;
+}
+
+auto LazyValue::size() const -> std::size_t {
+    std::size_t count = 0;
+    if (type() == Type::Object) {
+        walk_members([&](std::string_view, LazyValue) { ++count; return false; });
+    } else {
+        walk_elements([&](LazyValue) { ++count; return false; });
+    }
+    return count;
+}
+
+auto LazyValue::offset() const noexcept -> std::size_t {
+    return offset_;
+}
+
+template <typename Visit>
+auto LazyValue::walk_members(Visit&& visit) const -> bool {
+    using TT = TokenType;
+
+    auto scanner = Scanner(source_, offset_);
+    auto token = scanner.next_token();
+    if (token.type != TT::LeftBrace) {
+        access_error(std::string("Invalid cast from ") + to_string(type()) + " to object");
+    }
+
+    token = scanner.next_token();
+    if (token.type == TT::RightBrace) { return false; }
+    for (;;) {
+        if (token.type != TT::String) {
+            parse_error(source_, "Key of object element must be a string", token);
+        }
+        auto const colon = scanner.next_token();
+        if (colon.type != TT::Colon) {
+            parse_error(source_, "Object must have a colon \":\" to separate a key-value pair", colon);
+        }
+        auto const value = skip_whitespace(source_, colon.offset + 1);
+        if (value == source_.size()) { parse_error(source_, "Invalid literal", colon); }
+
+        // the key may live in the scanner's scratch, visit before replacing it
+        if (visit(std::get<std::string_view>(token.literal), LazyValue(source_, value))) { return true; }
+
+        scanner = Scanner(source_, skip_value(source_, value));
+        token = scanner.next_token();
+        if (token.type == TT::RightBrace) { return false; }
+        if (token.type == TT::Eof) {
+            parse_error(source_, "Need right brace \"}\" to terminate an object", token);
+        }
+        if (token.type != TT::Comma) {
+            parse_error(source_, "Expected comma \",\" after element in object", token);
+        }
+        token = scanner.next_token();
+    }
+}
+
+template <typename Visit>
+auto LazyValue::walk_elements(Visit&& visit) const -> bool {
+    using TT = TokenType;
+
+    auto scanner = Scanner(source_, offset_);
+    auto token = scanner.next_token();
+    if (token.type != TT::LeftBracket) {
+        access_error(std::string("Invalid cast from ") + to_string(type()) + " to array");
+    }
+
+    auto value = skip_whitespace(source_, token.offset + 1);
+    if (value < source_.size() && source_[value] == ']') { return false; }
+    for (;;) {
+        if (value == source_.size()) { parse_error(source_, "Invalid literal", token); }
+        if (visit(LazyValue(source_, value))) { return true; }
+
+        // a string token lives in the scanner's scratch, keep it for the errors
+        scanner = Scanner(source_, skip_value(source_, value));
+        token = scanner.next_token();
+        if (token.type == TT::RightBracket) { return false; }
+        if (token.type == TT::Eof) {
+            parse_error(source_, "Need right bracket \"]\" to terminate an array", token);
+        }
+        if (token.type != TT::Comma) {
+            parse_error(source_, "Expected comma \",\" after element in array", token);
+        }
+        value = skip_whitespace(source_, token.offset + 1);
+    }
+}
+
+auto LazyValue::number_kind() const -> Number::Kind {
+    return as_number().kind;
+}
+
+auto LazyValue::integer() const -> std::int64_t {
+    auto value = std::int64_t{};
+    if (not as_number().to_int64(value)) {
+        auto const text = source_.substr(offset_, skip_value(source_, offset_) - offset_);
+        access_error("Number " + std::string(text) + " does not fit in a 64-bit integer");
+    }
+    return value;
+}
+
+auto LazyValue::unsigned_integer() const -> std::uint64_t {
+    auto value = std::uint64_t{};
+    if (not as_number().to_uint64(value)) {
+        auto const text = source_.substr(offset_, skip_value(source_, offset_) - offset_);
+        access_error("Number " + std::string(text) + " does not fit in a 64-bit unsigned integer");
+    }
+    return value;
+}
+
+auto LazyValue::as_number() const -> Number {
+    auto scanner = Scanner(source_, offset_);
+    auto const token = scanner.next_token();
+    if (token.type != TokenType::Number) {
+        access_error(std::string("Invalid cast from ") + to_string(type()) + " to number");
+    }
+    return std::get<Number>(token.literal);
+}
+
+void LazyValue::access_error(std::string const& message) const {
+    auto const [line, column] = locate(source_, offset_);
+    std::stringstream ss;
+    ss << "Access error at "
+       << '[' << line << ':' << column << "]: " << message;
+
+    throw JsonException(ss.str());
+}
+
+// LazyDocument member functions
+
+LazyDocument::LazyDocument(std::string_view source) noexcept
+    : source_(source) { }
+
+auto LazyDocument::root() const -> LazyValue {
+    auto const offset = skip_whitespace(source_, 0);
+    if (offset == source_.size()) {
+        auto scanner = Scanner(source_);
+        parse_error(source_, "Empty string", scanner.next_token());
+    }
+    return LazyValue(source_, offset);
+}
+
+auto LazyDocument::operator[](std::string_view key) const -> LazyValue {
+    return root()[key];
+}
+
+void LazyDocument::validate() const {
+    auto handler = NullHandler{};
+    static_cast<void>(Parser<NullHandler>(Scanner(source_), handler).parse());
+}
+
+} // namespace json
@@ -0,0 +1,121 @@
+#include "json_parser/detail/MappedFile.h"
+#include <cerrno>
+#include <system_error>
+
+#if __has_include(<sys/mman.h>)
+#   define JSON_PARSER_HAS_MMAP 1
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#else
+#   define JSON_PARSER_HAS_MMAP 0
+#   include <fstream>
+#   include <sstream>
+#endif
+
+namespace json {
+
+// helpers
+
+[[noreturn]] inline static void throw_io_error(int error, std::string const& what, std::string const& path) {
+    throw std::system_error(error, std::generic_category(), what + " \"" + path + "\"");
+}
+
+// MappedFile member functions
+
+#if JSON_PARSER_HAS_MMAP
+
+MappedFile::MappedFile(std::string const& path, Access access)
+:
+    mapping_(nullptr),
+    size_(0),
+    buffer_()
+{
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) { throw_io_error(errno, "Cannot open", path); }
+
+    struct stat info = {};
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        auto const size = static_cast<std::size_t>(info.st_size);
+        void* const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            // only a hint, failing to give it changes nothing else
+            auto const advice = access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM;
+            static_cast<void>(::madvise(mapping, size, advice));
+            mapping_ = mapping;
+            size_ = size;
+            // the mapping outlives the descriptor
+            ::close(fd);
+            return;
+        }
+    }
+
+    try {
+        read_all(fd, path);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (mapping_ != nullptr) { ::munmap(mapping_, size_); }
+}
+
+void MappedFile::read_all(int fd, std::string const& path) {
+    constexpr std::size_t block_size = 64 * 1024;
+    for (;;) {
+        auto const used = buffer_.size();
+        buffer_.resize(used + block_size);
+        auto const count = ::read(fd, buffer_.data() + used, block_size);
+        if (count < 0 && errno == EINTR) {
+            buffer_.resize(used);
+            continue;
+        }
+        if (count < 0) { throw_io_error(errno, "Cannot read", path); }
+
+        buffer_.resize(used + static_cast<std::size_t>(count));
+        if (count == 0) { break; }
+    }
+    size_ = buffer_.size();
+}
+
+#else
+
+// the whole file is read, `access` makes no difference
+MappedFile::MappedFile(std::string const& path, Access)
+:
+    mapping_(nullptr),
+    size_(0),
+    buffer_()
+{
+    read_all(0, path);
+}
+
+MappedFile::~MappedFile() = default;
+
+// without mmap the file is always read through a stream, `fd` is unused
+void MappedFile::read_all(int, std::string const& path) {
+    auto file = std::ifstream(path, std::ios::binary);
+    if (not file) { throw_io_error(ENOENT, "Cannot open", path); }
+
+    auto ss = std::ostringstream{};
+    ss << file.rdbuf();
+    buffer_ = std::move(ss).str();
+    size_ = buffer_.size();
+}
+
+#endif
+
+auto MappedFile::contents() const noexcept -> std::string_view {
+    if (mapping_ != nullptr) { return { static_cast<char const*>(mapping_), size_ }; }
+    return buffer_;
+}
+
+auto MappedFile::is_mapped() const noexcept -> bool {
+    return mapping_ != nullptr;
+}
+
+} // namespace json
@@ -0,0 +1,186 @@
+#include "json_parser/NdJson.h"
+#include "json_parser/JsonException.h"
+#include "json_parser/detail/DomBuilder.h"
+#include "json_parser/detail/Instrumentation.h"
+#include "json_parser/detail/MappedFile.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace json {
+
+// helpers
+
+namespace {
+
+// consecutive lines parsed by one task
+struct Batch {
+    std::string_view text;
+    std::size_t first_line = 0;
+    std::vector<NdJsonLine> lines;
+    std::exception_ptr failure;
+    bool done = false;
+};
+
+} // namespace
+
+inline static auto is_blank(std::string_view line) -> bool {
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+static void parse_batch(Batch& batch, NdJsonOptions const& options, ParserContext& context) {
+    auto number = batch.first_line;
+    auto rest = batch.text;
+    while (not rest.empty()) {
+        auto const newline = rest.find('\n');
+        auto line = rest.substr(0, newline);
+        rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+
+        if (not line.empty() && line.back() == '\r') { line.remove_suffix(1); }
+        if (not is_blank(line)) {
+            // an invalid line is reported and does not stop the batch
+            try {
+                if (options.observer) {
+                    auto stats = ParseStats{};
+                    auto value = build_dom(line, CountingResource::heap(), StringMode::Copy, options.keys, &stats);
+                    options.observer(number, stats);
+                    batch.lines.push_back({ number, std::move(value), {} });
+                } else {
+                    auto value = context.parse(line, std::pmr::get_default_resource(), options.keys);
+                    batch.lines.push_back({ number, std::move(value), {} });
+                }
+            } catch (JsonException const& e) {
+                batch.lines.push_back({ number, Json{}, e.what() });
+            }
+        }
+        ++number;
+    }
+}
+
+// NdJsonParser member functions
+
+NdJsonParser::NdJsonParser(NdJsonOptions options)
+:
+    options_(options),
+    contexts_mutex_(),
+    contexts_(),
+    pool_(options.threads)
+{
+    options_.batch_bytes = std::max<std::size_t>(options_.batch_bytes, 1);
+    // release_context() never reallocates
+    contexts_.reserve(pool_.size());
+}
+
+void NdJsonParser::parse(std::string_view source, callback_t const& callback) {
+    // enough batches to keep every worker busy while the previous ones are delivered
+    auto const max_in_flight = 2 * pool_.size();
+
+    auto mutex = std::mutex{};
+    auto finished = std::condition_variable{};
+    // a list keeps the batches in place while the workers fill them
+    auto in_flight = std::list<Batch>{};
+    std::size_t position = 0;
+    std::size_t next_line = 1;
+
+    auto const submit_batch = [&] {
+        auto const cut = position + options_.batch_bytes;
+        auto const newline = cut >= source.size() ? std::string_view::npos : source.find('\n', cut - 1);
+        auto const end = newline == std::string_view::npos ? source.size() : newline + 1;
+
+        auto& batch = in_flight.emplace_back();
+        batch.text = source.substr(position, end - position);
+        batch.first_line = next_line;
+        next_line += static_cast<std::size_t>(std::count(batch.text.begin(), batch.text.end(), '\n'));
+        position = end;
+
+        pool_.submit([this, &batch, &mutex, &finished] {
+            auto context = std::unique_ptr<ParserContext>{};
+            try {
+                context = acquire_context();
+                parse_batch(batch, options_, *context);
+            } catch (...) {
+                batch.failure = std::current_exception();
+            }
+            release_context(std::move(context));
+            // notified under the lock, parse() may return as soon as it is released
+            auto const lock = std::lock_guard(mutex);
+            batch.done = true;
+            finished.notify_all();
+        });
+    };
+
+    auto const next_ready = [&] {
+        auto lock = std::unique_lock(mutex);
+        auto ready = in_flight.end();
+        finished.wait(lock, [&] {
+            ready = options_.ordered
+                ? (in_flight.front().done ? in_flight.begin() : in_flight.end())
+                : std::find_if(in_flight.begin(), in_flight.end(), [](Batch const& b) { return b.done; });
+            return ready != in_flight.end();
+        });
+        return ready;
+    };
+
+    try {
+        while (position < source.size() || not in_flight.empty()) {
+            while (position < source.size() && in_flight.size() < max_in_flight) {
+                submit_batch();
+            }
+
+            auto const ready = next_ready();
+            if (ready->failure) { std::rethrow_exception(ready->failure); }
+            for (auto& line : ready->lines) {
+                callback(std::move(line));
+            }
+            in_flight.erase(ready);
+        }
+    } catch (...) {
+        // the workers still reference the batches, let them finish first
+        auto lock = std::unique_lock(mutex);
+        finished.wait(lock, [&] {
+            return std::all_of(in_flight.begin(), in_flight.end(), [](Batch const& b) { return b.done; });
+        });
+        throw;
+    }
+}
+
+void NdJsonParser::parse_file(std::string const& path, callback_t const& callback) {
+    auto const file = MappedFile(path);
+    parse(file.contents(), callback);
+}
+
+auto NdJsonParser::threads() const noexcept -> std::size_t {
+    return pool_.size();
+}
+
+auto NdJsonParser::acquire_context() -> std::unique_ptr<ParserContext> {
+    {
+        auto const lock = std::lock_guard(contexts_mutex_);
+        if (not contexts_.empty()) {
+            auto context = std::move(contexts_.back());
+            contexts_.pop_back();
+            return context;
+        }
+    }
+    // lines are parsed onto the heap, the arena is never used
+    return std::make_unique<ParserContext>(0);
+}
+
+void NdJsonParser::release_context(std::unique_ptr<ParserContext> context) noexcept {
+    if (context == nullptr) { return; }
+    auto const lock = std::lock_guard(contexts_mutex_);
+    contexts_.push_back(std::move(context));
+}
+
+// free functions
+
+void parse_ndjson(std::string_view source,
+                  NdJsonParser::callback_t const& callback,
+                  NdJsonOptions options) {
+    NdJsonParser(options).parse(source, callback);
+}
+
+} // namespace json
@@ -0,0 +1,250 @@
+#include "json_parser/detail/Number.h"
+#include <cfloat>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <system_error>
+
+namespace json {
+
+// helpers
+
+inline static auto is_digit(char const c) -> bool {
+    return '0' <= c && c <= '9';
+}
+
+// Exact powers of ten as doubles, 10^22 is the largest one
+static constexpr double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// Clinger's fast path: a mantissa below 2^53 and a power of ten that are both
+// exact doubles give a correctly rounded result with one multiplication or
+// division. It needs double arithmetic without extended precision
+static auto fast_path(std::uint64_t mantissa, long exponent, double& value) -> bool {
+#if FLT_EVAL_METHOD == 0
+    constexpr auto max_exact_mantissa = std::uint64_t{1} << 53;
+    if (mantissa > max_exact_mantissa || exponent < -22 || exponent > 22) { return false; }
+
+    value = static_cast<double>(mantissa);
+    if (exponent < 0) { value /= exact_powers_of_ten[-exponent]; }
+    else              { value *= exact_powers_of_ten[exponent]; }
+    return true;
+#else
+    static_cast<void>(mantissa);
+    static_cast<void>(exponent);
+    static_cast<void>(value);
+    return false;
+#endif
+}
+
+// Eight digits at a time, as bytes of one little endian word: checking and
+// combining them takes a few multiplications instead of eight steps
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+static auto eight_digits(char const* p, char const* end, std::uint64_t& value) -> bool {
+    if (end - p < 8) { return false; }
+    auto word = std::uint64_t{};
+    std::memcpy(&word, p, sizeof word);
+    // every byte in '0'..'9': high nibble 3, and adding 6 does not carry out of it
+    if (((word & 0xF0F0F0F0F0F0F0F0u) | (((word + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4))
+        != 0x3333333333333333u) {
+        return false;
+    }
+    // pairs, then groups of four, then all eight, the first digit is the lowest byte
+    word = ((word & 0x0F0F0F0F0F0F0F0Fu) * 2561) >> 8;
+    word = ((word & 0x00FF00FF00FF00FFu) * 6553601) >> 16;
+    value = ((word & 0x0000FFFF0000FFFFu) * 42949672960001u) >> 32;
+    return true;
+}
+#else
+static auto eight_digits(char const*, char const*, std::uint64_t&) -> bool {
+    return false;
+}
+#endif
+
+// Number member functions
+
+auto Number::from(std::int64_t const value) noexcept -> Number {
+    auto number = Number{};
+    number.kind = Kind::Int;
+    number.i = value;
+    return number;
+}
+
+auto Number::from(std::uint64_t const value) noexcept -> Number {
+    auto number = Number{};
+    number.kind = Kind::UInt;
+    number.u = value;
+    return number;
+}
+
+auto Number::from(double const value) noexcept -> Number {
+    auto number = Number{};
+    number.kind = Kind::Double;
+    number.d = value;
+    return number;
+}
+
+auto Number::to_double() const noexcept -> double {
+    switch (kind) {
+    case Kind::Int:    return static_cast<double>(i);
+    case Kind::UInt:   return static_cast<double>(u);
+    case Kind::Double: return d;
+    }
+    return d;
+}
+
+auto Number::to_int64(std::int64_t& value) const noexcept -> bool {
+    switch (kind) {
+    case Kind::Int: value = i; return true;
+    case Kind::UInt: return false;
+    case Kind::Double: {
+        // 2^63 is exact as a double, unlike the int64_t maximum
+        constexpr auto limit = 9223372036854775808.0;
+        if (not (d >= -limit && d < limit) || static_cast<double>(static_cast<std::int64_t>(d)) != d) { return false; }
+        value = static_cast<std::int64_t>(d);
+        return true;
+    }
+    }
+    return false;
+}
+
+auto Number::to_uint64(std::uint64_t& value) const noexcept -> bool {
+    switch (kind) {
+    case Kind::Int: {
+        if (i < 0) { return false; }
+        value = static_cast<std::uint64_t>(i);
+        return true;
+    }
+    case Kind::UInt: value = u; return true;
+    case Kind::Double: {
+        constexpr auto limit = 18446744073709551616.0;
+        if (not (d >= 0 && d < limit) || static_cast<double>(static_cast<std::uint64_t>(d)) != d) { return false; }
+        value = static_cast<std::uint64_t>(d);
+        return true;
+    }
+    }
+    return false;
+}
+
+// free functions
+
+auto parse_number(std::string_view text, Number& number) noexcept -> NumberError {
+    auto length = std::size_t{0};
+    auto const error = parse_number_prefix(text, number, length);
+    if (error == NumberError::None && length != text.size()) { return NumberError::Invalid; }
+    return error;
+}
+
+auto parse_number_prefix(std::string_view text, Number& number, std::size_t& length) noexcept -> NumberError {
+    // large enough for any double, small enough to never overflow a long
+    constexpr long exponent_limit = 100'000;
+
+    auto const* p = text.data();
+    auto const* const end = text.data() + text.size();
+
+    auto const negative = p != end && *p == '-';
+    if (negative) { ++p; }
+    if (p == end || not is_digit(*p)) { return NumberError::Invalid; }
+
+    // the digits as an integer while it fits, and the power of ten scaling it
+    std::uint64_t mantissa = 0;
+    bool truncated = false;
+    long exponent = 0;
+    // position of the decimal point relative to the first significant digit,
+    // tells an underflow from an overflow when the conversion is out of range
+    long magnitude = 0;
+    auto const add_digit = [&](char const c) {
+        auto const digit = static_cast<std::uint64_t>(c - '0');
+        // below 10^18 another digit always fits, the division is for the last ones
+        if (mantissa >= 1'000'000'000'000'000'000u
+            && mantissa > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+            truncated = true;
+            return false;
+        }
+        mantissa = mantissa * 10 + digit;
+        return true;
+    };
+
+    if (*p == '0') {
+        ++p;
+        if (p != end && is_digit(*p)) { return NumberError::Invalid; }
+    } else {
+        // while another eight digits cannot overflow the mantissa
+        for (auto block = std::uint64_t{}; mantissa < 100'000'000'000u && eight_digits(p, end, block); p += 8) {
+            mantissa = mantissa * 100'000'000u + block;
+            magnitude += 8;
+        }
+        for (; p != end && is_digit(*p); ++p) {
+            if (truncated || not add_digit(*p)) { ++exponent; }
+            ++magnitude;
+        }
+    }
+
+    auto is_integer = true;
+    if (p != end && *p == '.') {
+        is_integer = false;
+        ++p;
+        if (p == end || not is_digit(*p)) { return NumberError::Invalid; }
+        for (auto block = std::uint64_t{};
+             mantissa != 0 && mantissa < 100'000'000'000u && eight_digits(p, end, block); p += 8) {
+            mantissa = mantissa * 100'000'000u + block;
+            exponent -= 8;
+        }
+        for (; p != end && is_digit(*p); ++p) {
+            if (not truncated && add_digit(*p)) { --exponent; }
+            if (mantissa == 0) { --magnitude; }
+        }
+    }
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        is_integer = false;
+        ++p;
+        auto const negative_exponent = p != end && *p == '-';
+        if (p != end && (*p == '-' || *p == '+')) { ++p; }
+        if (p == end || not is_digit(*p)) { return NumberError::Invalid; }
+        long written = 0;
+        for (; p != end && is_digit(*p); ++p) {
+            if (written < exponent_limit) { written = written * 10 + (*p - '0'); }
+        }
+        exponent += negative_exponent ? -written : written;
+        magnitude += negative_exponent ? -written : written;
+    }
+
+    length = static_cast<std::size_t>(p - text.data());
+
+    if (is_integer && not truncated) {
+        constexpr auto int_max = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+        if (not negative) {
+            number = mantissa <= int_max ? Number::from(static_cast<std::int64_t>(mantissa))
+                                         : Number::from(mantissa);
+            return NumberError::None;
+        }
+        if (mantissa == 0) {
+            number = Number::from(-0.0);
+            return NumberError::None;
+        }
+        if (mantissa <= int_max + 1) {
+            // -(int_max + 1) does not fit in an int64_t before the negation
+            number = Number::from(-static_cast<std::int64_t>(mantissa - 1) - 1);
+            return NumberError::None;
+        }
+    }
+
+    auto value = 0.0;
+    if (not truncated && fast_path(mantissa, exponent, value)) {
+        number = Number::from(negative ? -value : value);
+        return NumberError::None;
+    }
+
+    auto const [_, err] = std::from_chars(text.data(), p, value);
+    if (err == std::errc::result_out_of_range) {
+        if (magnitude > 0) { return NumberError::OutOfRange; }
+        value = negative ? -0.0 : 0.0;
+    }
+    number = Number::from(value);
+    return NumberError::None;
+}
+
+} // namespace json
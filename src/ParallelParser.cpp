@@ -0,0 +1,155 @@
+#include "json_parser/ParallelParser.h"
+#include "json_parser/JsonException.h"
+#include "json_parser/detail/DomBuilder.h"
+#include "json_parser/detail/StructuralIndexer.h"
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace json {
+
+// helpers
+
+namespace {
+
+// consecutive elements parsed by one task
+struct ElementRange {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    std::vector<Json> values;
+    bool invalid = false;
+    std::exception_ptr failure;
+};
+
+} // namespace
+
+inline static auto is_blank(std::string_view text) -> bool {
+    return text.find_first_not_of(" \t\r\n") == std::string_view::npos;
+}
+
+inline static auto parse_sequential(std::string_view source) -> Json {
+    return build_dom(source, std::pmr::get_default_resource());
+}
+
+// Splits the elements of a top-level array at its depth 1 commas. Returns
+// nothing when the source is not an array or the array is not closed.
+// Element texts are not validated, parsing them does
+static auto split_elements(std::string_view source) -> std::optional<std::vector<std::string_view>> {
+    auto indexer = StructuralIndexer(source);
+    auto position = indexer.next();
+    if (position == source.size() || source[position] != '[') { return std::nullopt; }
+
+    auto elements = std::vector<std::string_view>{};
+    std::size_t depth = 1;
+    auto element_start = position + 1;
+    for (position = indexer.next(); position < source.size(); position = indexer.next()) {
+        switch (source[position]) {
+
+        case '[': case '{': {
+            // too deep for the parse of an element, the sequential parse reports it
+            if (++depth > max_nesting_depth) { return std::nullopt; }
+            break;
+        }
+        case ']': case '}': {
+            if (--depth != 0) { break; }
+            elements.push_back(source.substr(element_start, position - element_start));
+            // only whitespace may follow the array
+            if (indexer.next() != source.size()) { return std::nullopt; }
+            if (elements.size() == 1 && is_blank(elements.front())) { elements.clear(); }
+            return elements;
+        }
+        case ',': {
+            if (depth != 1) { break; }
+            elements.push_back(source.substr(element_start, position - element_start));
+            element_start = position + 1;
+            break;
+        }
+        default: break;
+
+        }
+    }
+    return std::nullopt;
+}
+
+static void parse_range(std::vector<std::string_view> const& elements, ElementRange& range) {
+    range.values.reserve(range.end - range.begin);
+    for (auto i = range.begin; i < range.end; ++i) {
+        try {
+            range.values.push_back(parse_sequential(elements[i]));
+        } catch (JsonException const&) {
+            // the sequential parse reports it with its position in the source
+            range.invalid = true;
+            return;
+        }
+    }
+}
+
+// free functions
+
+auto parse_string_parallel(std::string_view source, ParallelOptions options) -> Json {
+    // a pool for a source too small to split would only cost thread startups
+    if (source.size() < options.chunk_bytes) { return parse_sequential(source); }
+
+    auto pool = ThreadPool(options.threads);
+    return parse_string_parallel(source, pool, options.chunk_bytes);
+}
+
+auto parse_string_parallel(std::string_view source, ThreadPool& pool, std::size_t chunk_bytes) -> Json {
+    // every range takes at least one element
+    chunk_bytes = std::max<std::size_t>(chunk_bytes, 1);
+    if (source.size() < chunk_bytes) { return parse_sequential(source); }
+
+    auto const elements = split_elements(source);
+    if (not elements) { return parse_sequential(source); }
+
+    // consecutive elements summing to at least chunk_bytes each
+    auto ranges = std::vector<ElementRange>{};
+    for (std::size_t i = 0; i < elements->size();) {
+        auto& range = ranges.emplace_back();
+        range.begin = i;
+        for (std::size_t bytes = 0; i < elements->size() && bytes < chunk_bytes; ++i) {
+            bytes += (*elements)[i].size();
+        }
+        range.end = i;
+    }
+
+    auto mutex = std::mutex{};
+    auto finished = std::condition_variable{};
+    auto pending = ranges.size();
+    for (auto& range : ranges) {
+        pool.submit([&elements, &range, &mutex, &finished, &pending] {
+            try {
+                parse_range(*elements, range);
+            } catch (...) {
+                range.failure = std::current_exception();
+            }
+            // notified under the lock, the caller may return as soon as it is released
+            auto const lock = std::lock_guard(mutex);
+            --pending;
+            finished.notify_all();
+        });
+    }
+    {
+        auto lock = std::unique_lock(mutex);
+        finished.wait(lock, [&pending] { return pending == 0; });
+    }
+
+    for (auto const& range : ranges) {
+        if (range.failure) { std::rethrow_exception(range.failure); }
+        if (range.invalid) { return parse_sequential(source); }
+    }
+
+    auto array = Json::array_t{};
+    array.reserve(elements->size());
+    for (auto& range : ranges) {
+        for (auto& value : range.values) {
+            array.push_back(std::move(value));
+        }
+    }
+    return Json(std::move(array));
+}
+
+} // namespace json
@@ -0,0 +1,101 @@
+#include "json_parser/ParseError.h"
+#include "json_parser/detail/Scanner.h"
+#include <algorithm>
+
+namespace json {
+
+// helpers
+
+// the characters Scanner takes into a malformed number
+static auto is_number_char(char const c) -> bool {
+    return ('0' <= c && c <= '9') || c == 'e' || c == 'E' || c == '+' || c == '-' || c == '.';
+}
+
+static auto is_alpha(char const c) -> bool {
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+// the run of characters from `offset` on, at least one
+template <typename Predicate>
+static auto lexeme(std::string_view source, std::size_t offset, Predicate predicate) -> std::string {
+    auto end = offset + 1;
+    while (end < source.size() && predicate(source[end])) { ++end; }
+    return std::string(source.substr(offset, end - offset));
+}
+
+static auto char_at(std::string_view source, std::size_t offset) -> char {
+    return offset < source.size() ? source[offset] : '\0';
+}
+
+static auto scan_message(ParseError const& error, std::string_view source) -> std::string {
+    switch (error.code) {
+    case ParseErrc::InvalidCharacter:
+        return std::string("\"") + char_at(source, error.offset) + "\" is an invalid character";
+    case ParseErrc::InvalidLiteral:
+        return '"' + lexeme(source, error.offset, is_alpha) + "\" is an invalid literal";
+    case ParseErrc::InvalidNumber:
+        return "Cannot convert " + lexeme(source, error.offset, is_number_char) + " to number";
+    case ParseErrc::NumberOutOfRange:
+        return "Number " + lexeme(source, error.offset, is_number_char) + " is out of the range of a double";
+    case ParseErrc::UnterminatedString:
+        return "Unterminated string";
+    case ParseErrc::InvalidEscape:
+        return std::string("\\") + char_at(source, error.offset - 1) + " is an invalid escape character";
+    case ParseErrc::InvalidHexDigit:
+        return std::string("Escape hex-code character can only be in [0, 9] or [a, f] or [A, F], found \"")
+               + char_at(source, error.offset - 1) + '"';
+    case ParseErrc::UnpairedSurrogate:
+        return "Unpaired surrogate in \\u escape";
+    case ParseErrc::InvalidUtf8:
+        return "Invalid UTF-8 in string";
+    default:
+        return {};
+    }
+}
+
+static auto parse_message(ParseErrc code, std::string_view key) -> std::string {
+    switch (code) {
+    case ParseErrc::EmptyInput:          return "Empty string";
+    case ParseErrc::TrailingContent:     return "Unexpected token after parsing element";
+    case ParseErrc::ExpectedValue:       return "Invalid literal";
+    case ParseErrc::ExpectedArrayComma:  return "Expected comma \",\" after element in array";
+    case ParseErrc::UnterminatedArray:   return "Need right bracket \"]\" to terminate an array";
+    case ParseErrc::ExpectedKey:         return "Key of object element must be a string";
+    case ParseErrc::ExpectedColon:       return "Object must have a colon \":\" to separate a key-value pair";
+    case ParseErrc::ExpectedObjectComma: return "Expected comma \",\" after element in object";
+    case ParseErrc::UnterminatedObject:  return "Need right brace \"}\" to terminate an object";
+    case ParseErrc::DuplicateKey:        return "Key \"" + std::string(key) + "\" already exist";
+    case ParseErrc::NestingTooDeep:
+        return "Arrays and objects nest deeper than " + std::to_string(max_nesting_depth) + " levels";
+    default:                             return {};
+    }
+}
+
+// ParseError member functions
+
+auto ParseError::is_scan_error() const noexcept -> bool {
+    return ParseErrc::InvalidCharacter <= code && code <= ParseErrc::InvalidUtf8;
+}
+
+auto ParseError::location(std::string_view source) const -> SourceLocation {
+    return locate(source, offset);
+}
+
+auto ParseError::message(std::string_view source) const -> std::string {
+    if (not *this) { return {}; }
+    if (is_scan_error()) {
+        auto const [line, column] = location(source);
+        return "Scan error at [" + std::to_string(line) + ':' + std::to_string(column) + "]: "
+               + scan_message(*this, source);
+    }
+
+    // the token was scanned once without error, scanning it again from its
+    // offset gives it back. Eof is not at its offset but after it
+    auto scanner = Scanner(source, offset);
+    auto const found = token == TokenType::Eof ? Token(offset, TokenType::Eof, Token::NullLiteral{})
+                                               : scanner.next_token();
+    auto const key = found.type == TokenType::String ? std::get<std::string_view>(found.literal) : std::string_view();
+    return "Parse error at " + found.to_string(source) + ": " + parse_message(code, key);
+}
+
+} // namespace json
@@ -1,4 +1,6 @@
 #include "json_parser/detail/Parser.h"
+#include "json_parser/detail/Instrumentation.h"
+#include "json_parser/JsonException.h"
 #include <algorithm>
 #include <cassert>
 
@@ -6,96 +8,47 @@ namespace json {
 
 using TT = TokenType;
 
-static inline void error(std::string const& message, Token const& token) {
-    throw JsonException("Parse error at " + token.to_string() + ": " + message);
-}
-
-Parser::Parser(std::vector<Token> tokens)
+template <typename Source>
+BasicParserBase<Source>::BasicParserBase(Source scanner, ErrorMode mode)
 :
-    source_(std::move(tokens)),
-    current_(0)
+    scanner_(std::move(scanner)),
+    previous_(),
+    current_(),
+    mode_(mode),
+    error_(),
+    depth_(0)
 {
+    scanner_.set_error_mode(mode);
+    pull();
 }
 
-auto Parser::parse() -> Json {
-    if (not is_not_end()) { error("Empty string", peek()); }
-    auto res = parse_element();
-    if (is_not_end()) { error("Unexpected token after parsing element", peek()); }
-    return res;
+template <typename Source>
+void BasicParserBase<Source>::fail(std::string const& message) const {
+    error(message, previous());
 }
 
-auto Parser::parse_element() -> Json {
-    if      (match(TT::LeftBracket)) { return parse_array(); }
-    else if (match(TT::LeftBrace))   { return parse_object(); }
-    else                             { return parse_literal(); }
-}
-
-auto Parser::parse_literal() -> Json {
-    auto const token = advance();
-    switch (token.type) {
-    case TT::Null:   return Json{};
-    case TT::True:   return Json{true};
-    case TT::False:  return Json{false};
-    case TT::Number: return Json{std::get<Json::number_t>(token.literal)};
-    case TT::String: return Json{std::get<Json::string_t>(token.literal)};
-    default: error("Invalid literal", previous()); return Json{};
-    }
+template <typename Source>
+void BasicParserBase<Source>::fail(ParseErrc code) {
+    static_cast<void>(error(code, previous()));
 }
 
-auto Parser::parse_array() -> Json {
-    auto array = Json::array_t{};
-
-    if (match(TT::RightBracket)) { return Json{ array }; }
-
-    array.push_back(parse_element());
-
-    while (is_not_end() && not check(TT::RightBracket)) {
-        consume(TT::Comma, "Expected comma \",\" after element in array");
-        array.push_back(parse_element());
-    }
-    consume(TT::RightBracket, "Need right bracket \"]\" to terminate an array");
-
-    return Json{ array };
+template <typename Source>
+auto BasicParserBase<Source>::error() const noexcept -> ParseError const& {
+    return error_;
 }
 
-auto Parser::parse_object() -> Json {
-    auto object = Json::object_t{};
-
-    if (match(TT::RightBrace)) { return Json{ object }; }
-
-    insert_object_elem(object);
-
-    while (is_not_end() && not check(TT::RightBrace)) {
-        consume(TT::Comma, "Expected comma \",\" after element in object");
-        insert_object_elem(object);
-    }
-    consume(TT::RightBrace, "Need right brace \"}\" to terminate an object");
-
-    return  Json{ object };
+template <typename Source>
+auto BasicParserBase<Source>::release_scratch() noexcept -> Scanner::Scratch {
+    return scanner_.release_scratch();
 }
 
-auto Parser::parse_object_elem() -> ObjectElemParsingResult {
-    auto const& key_token = consume(TT::String, "Key of object element must be a string");
-    auto const key = std::get<Json::string_t>(key_token.literal);
-    consume(TT::Colon, "Object must have a colon \":\" to separate a key-value pair");
-    auto value = parse_element();
-
-    return { Json::object_elem_t{ key, value }, key_token };
+template <typename Source>
+auto BasicParserBase<Source>::is_not_end() const noexcept -> bool {
+    return current_.type != TT::Eof;
 }
 
-void Parser::insert_object_elem(Json::object_t& object) {
-    auto [kv, key_token] = parse_object_elem();
-    auto [key, value] = kv;
-    if (not object.insert(std::make_pair(key, std::move(value))).second) {
-        error("Key \"" + key + "\" already exist", key_token);
-    }
-}
-
-auto Parser::is_not_end() const noexcept -> bool {
-    return source_[current_].type != TT::Eof;
-}
-
-auto Parser::match(TokenType expected) -> bool {
+template <typename Source>
+auto BasicParserBase<Source>::match(TokenType expected) -> bool {
     if (peek().type == expected) {
         advance();
         return true;
@@ -104,29 +57,38 @@ auto Parser::match(TokenType expected) -> bool {
     }
 }
 
-auto Parser::match(std::initializer_list<TokenType> list) -> bool {
+template <typename Source>
+auto BasicParserBase<Source>::match(std::initializer_list<TokenType> list) -> bool {
     return std::any_of(list.begin(), list.end(),
         [this](TokenType type) { return match(type); });
 }
 
-auto Parser::check(TokenType type) const -> bool {
+template <typename Source>
+auto BasicParserBase<Source>::check(TokenType type) const -> bool {
     return peek().type == type;
 }
 
-auto Parser::advance() -> Token& {
-    if (is_not_end()) { ++ current_; }
-    return source_[current_ - 1];
+template <typename Source>
+auto BasicParserBase<Source>::advance() -> Token& {
+    if (is_not_end()) {
+        previous_ = std::move(current_);
+        pull();
+    }
+    return previous_;
 }
 
-auto Parser::peek() const -> const Token& {
-    return source_[current_];
+template <typename Source>
+auto BasicParserBase<Source>::peek() const -> const Token& {
+    return current_;
 }
 
-auto Parser::previous() const -> const Token& {
-    return source_[current_ - 1];
+template <typename Source>
+auto BasicParserBase<Source>::previous() const -> const Token& {
+    return previous_;
 }
 
-auto Parser::consume(TokenType type, std::string const& message) -> Token& {
+template <typename Source>
+auto BasicParserBase<Source>::consume(TokenType type, char const* message) -> Token& {
     if (check(type)) {
         return advance();
     }
@@ -135,4 +97,46 @@ auto Parser::consume(TokenType type, std::string const& message) -> Token& {
     return advance(); // for MSVC C4715 - all path must return. I know it looks dirty
 }
 
+template <typename Source>
+auto BasicParserBase<Source>::consume(TokenType type, ParseErrc code) -> Token const* {
+    if (check(type)) { return &advance(); }
+    error(code, peek());
+    return nullptr;
+}
+
+template <typename Source>
+void BasicParserBase<Source>::error(std::string const& message, Token const& token) const {
+    throw JsonException("Parse error at " + token.to_string(scanner_.source()) + ": " + message);
+}
+
+template <typename Source>
+auto BasicParserBase<Source>::error(ParseErrc code, Token const& token) -> bool {
+    auto const error = ParseError{ code, token.type, token.offset };
+    if (mode_ == ErrorMode::Throw) { throw JsonException(error.message(scanner_.source())); }
+    if (not error_) { error_ = error; }
+    return false;
+}
+
+template <typename Source>
+auto BasicParserBase<Source>::enter() -> bool {
+    if (depth_ == max_nesting_depth) { return error(ParseErrc::NestingTooDeep, previous()); }
+    ++depth_;
+    return true;
+}
+
+template <typename Source>
+void BasicParserBase<Source>::leave() noexcept {
+    --depth_;
+}
+
+template <typename Source>
+void BasicParserBase<Source>::pull() {
+    current_ = scanner_.next_token();
+    if (current_.type == TT::Error && not error_) { error_ = scanner_.error(); }
+}
+
+// every token source parsers are instantiated with
+template class BasicParserBase<Scanner>;
+template class BasicParserBase<CountingScanner>;
+
 } // namespace json
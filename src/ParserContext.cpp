@@ -0,0 +1,87 @@
+#include "json_parser/ParserContext.h"
+#include "json_parser/detail/Instrumentation.h"
+#include "json_parser/detail/Parser.h"
+#include <new>
+#include <utility>
+
+namespace json {
+
+// ParserContext member functions
+
+ParserContext::ParserContext(std::size_t arena_bytes)
+:
+    scratch_(),
+    buffer_(std::make_unique<std::byte[]>(arena_bytes)),
+    buffer_size_(arena_bytes),
+    spill_(std::pmr::get_default_resource()),
+    spilled_(0),
+    arena_(),
+    root_(nullptr),
+    builder_({}, std::pmr::get_default_resource())
+{
+}
+
+auto ParserContext::parse(std::string_view source) -> Json const& {
+    reset();
+    // spill_ counts on the calling thread
+    auto const before = thread_allocation_counts();
+    auto& arena = arena_.emplace(buffer_.get(), buffer_size_, &spill_);
+    try {
+        auto root = build(source, &arena, nullptr);
+        root_ = new (arena.allocate(sizeof(Json), alignof(Json))) Json(std::move(root));
+    } catch (...) {
+        // the containers of the partial tree are released with the arena
+        builder_.abandon();
+        arena_.reset();
+        throw;
+    }
+    spilled_ = thread_allocation_counts().bytes - before.bytes;
+    return *root_;
+}
+
+auto ParserContext::parse(std::string_view source, std::pmr::memory_resource* resource,
+                          KeyDictionary* keys) -> Json {
+    try {
+        return build(source, resource, keys);
+    } catch (...) {
+        // destroyed now, the caller may release `resource` before the next parse
+        builder_.reset({}, resource);
+        throw;
+    }
+}
+
+void ParserContext::reset() {
+    root_ = nullptr;
+    arena_.reset();
+    if (spilled_ != 0) {
+        // the next document of the same size fits without spilling
+        buffer_size_ += spilled_;
+        buffer_ = std::make_unique<std::byte[]>(buffer_size_);
+        spilled_ = 0;
+    }
+}
+
+auto ParserContext::arena_capacity() const noexcept -> std::size_t {
+    return buffer_size_;
+}
+
+auto ParserContext::build(std::string_view source, std::pmr::memory_resource* resource,
+                          KeyDictionary* keys) -> Json {
+    builder_.reset(source, resource, StringMode::Copy, keys);
+    auto parser = Parser<DomBuilder>(Scanner(source, std::move(scratch_)), builder_);
+    try {
+        if (not parser.parse()) {
+            // The builder only stops on a duplicate key, which is the last
+            // consumed token. An escaped key is in the scratch buffers, so
+            // they are released only once the message is built
+            parser.fail("Key \"" + std::string(builder_.duplicate_key()) + "\" already exist");
+        }
+    } catch (...) {
+        scratch_ = parser.release_scratch();
+        throw;
+    }
+    scratch_ = parser.release_scratch();
+    return std::move(builder_).result();
+}
+
+} // namespace json
@@ -0,0 +1,37 @@
+#include "json_parser/PushParser.h"
+
+namespace json {
+
+// instantiated here so the handler calls inline into the state machine
+template class PushParser<DomBuilder>;
+
+// JsonPushParser member functions
+
+JsonPushParser::JsonPushParser(std::pmr::memory_resource* resource)
+:
+    builder_(std::string_view{}, resource),
+    parser_(builder_)
+{
+}
+
+void JsonPushParser::feed(std::string_view chunk) {
+    if (not parser_.feed(chunk)) {
+        // the builder only stops on a duplicate key, which is the last token
+        parser_.fail("Key \"" + std::string(builder_.duplicate_key()) + "\" already exist");
+    }
+}
+
+auto JsonPushParser::finish() -> Json {
+    if (not parser_.finish()) {
+        parser_.fail("Key \"" + std::string(builder_.duplicate_key()) + "\" already exist");
+    }
+    return std::move(builder_).result();
+}
+
+// free functions
+
+void throw_parse_error(std::string const& message, Token const& token, SourceLocation location) {
+    throw JsonException("Parse error at " + token.to_string(location) + ": " + message);
+}
+
+} // namespace json
@@ -0,0 +1,348 @@
+#include "json_parser/detail/PushScanner.h"
+#include "json_parser/detail/Utf8.h"
+#include "json_parser/JsonException.h"
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+
+namespace json {
+
+// helpers
+
+inline static auto is_digit(char const c) -> bool {
+    return '0' <= c && c <= '9';
+}
+
+inline static auto is_alpha(char const c) -> bool {
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+inline static auto is_whitespace(char const c) -> bool {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline static auto is_on_digit(char const c) -> bool {
+    return is_digit(c) || c == 'e' || c == 'E' ||
+           c == '+' || c == '-' || c == '.';
+}
+
+// PushScanner member functions
+
+PushScanner::PushScanner()
+:
+    state_(State::Between),
+    finished_(false),
+    has_token_(false),
+    token_(),
+    token_location_{ 0, 0 },
+    chunk_(),
+    chunk_offset_(0),
+    current_(0),
+    lexeme_start_(0),
+    lexeme_location_{ 0, 0 },
+    run_start_(0),
+    buffer_(),
+    buffered_(false),
+    hex_digits_(0),
+    hex_value_(0),
+    high_surrogate_(0),
+    last_offset_(0),
+    last_location_{ 0, 0 },
+    located_offset_(0),
+    line_(1),
+    line_start_(0)
+{
+}
+
+void PushScanner::feed(std::string_view chunk) {
+    assert(chunk_end() && not finished_);
+    chunk_ = chunk;
+    current_ = 0;
+}
+
+void PushScanner::finish() {
+    finished_ = true;
+}
+
+auto PushScanner::next() -> bool {
+    has_token_ = false;
+    while (not has_token_) {
+        if (chunk_end() && not finished_) {
+            release_chunk();
+            return false;
+        }
+        switch (state_) {
+        case State::Between:    scan_between();    break;
+        case State::String:     scan_string();     break;
+        case State::Escape:     scan_escape();     break;
+        case State::Unicode:    scan_unicode();    break;
+        case State::Number:     scan_number();     break;
+        case State::Identifier: scan_identifier(); break;
+        case State::Done:       return false;
+        }
+    }
+    return true;
+}
+
+auto PushScanner::token() const noexcept -> Token const& {
+    return token_;
+}
+
+auto PushScanner::location() const noexcept -> SourceLocation {
+    return token_location_;
+}
+
+void PushScanner::scan_between() {
+    auto const begin = current_;
+    while (not chunk_end() && is_whitespace(chunk_[current_])) {
+        ++current_;
+    }
+
+    if (chunk_end()) {
+        // like a whitespace-only lexeme, Eof points at the last whitespace byte
+        if (current_ != begin) {
+            last_offset_ = offset() - 1;
+            last_location_ = locate(last_offset_);
+        }
+        if (finished_) {
+            // nothing has been scanned in an empty stream
+            if (offset() == 0) { last_location_ = { 0, 0 }; }
+            token_ = Token(last_offset_, TokenType::Eof, Token::NullLiteral{});
+            token_location_ = last_location_;
+            has_token_ = true;
+            state_ = State::Done;
+        }
+        return;
+    }
+
+    lexeme_start_ = last_offset_ = offset();
+    lexeme_location_ = last_location_ = locate(lexeme_start_);
+    run_start_ = current_;
+    buffer_.clear();
+    buffered_ = false;
+    high_surrogate_ = 0;
+
+    char const c = chunk_[current_++];
+    switch (c) {
+
+    case '{': add_token(TokenType::LeftBrace);    break;
+    case '}': add_token(TokenType::RightBrace);   break;
+    case '[': add_token(TokenType::LeftBracket);  break;
+    case ']': add_token(TokenType::RightBracket); break;
+    case ',': add_token(TokenType::Comma);        break;
+    case ':': add_token(TokenType::Colon);        break;
+    case '"':
+        run_start_ = current_;
+        state_ = State::String;
+        break;
+    case '+': case '-': state_ = State::Number; break;
+    default: {
+        // like Scanner, "e" and "." start a (malformed) number, not a literal
+        if      (is_on_digit(c)) { state_ = State::Number; }
+        else if (is_alpha(c)) { state_ = State::Identifier; }
+        else    { error(std::string("\"") + c + "\" is an invalid character", lexeme_location_); }
+        break;
+    }
+
+    }
+}
+
+void PushScanner::scan_string() {
+    if (high_surrogate_ != 0) {
+        // a high surrogate escape must be followed by the low one
+        if (chunk_end()) {
+            if (finished_) { error("Unterminated string", lexeme_location_); }
+            return;
+        }
+        if (chunk_[current_] != '\\') { error("Unpaired surrogate in \\u escape", lexeme_location_); }
+    }
+
+    auto const stop = find_quote_or_backslash(chunk_, current_);
+    if (stop == chunk_.size()) {
+        current_ = chunk_.size();
+        if (finished_) { error("Unterminated string", lexeme_location_); }
+        return;
+    }
+
+    current_ = stop;
+    auto const run = chunk_.substr(run_start_, current_ - run_start_);
+    if (chunk_[current_++] == '"') {
+        state_ = State::Between;
+        if (not buffered_) {
+            check_utf8(run);
+            add_token(TokenType::String, run);
+        } else {
+            buffer_.append(run);
+            check_utf8(buffer_);
+            add_token(TokenType::String, std::string_view(buffer_));
+        }
+        return;
+    }
+
+    buffer_.append(run);
+    buffered_ = true;
+    state_ = State::Escape;
+}
+
+void PushScanner::scan_escape() {
+    if (chunk_end()) { error("Unterminated string", lexeme_location_); }
+
+    char const c = chunk_[current_++];
+    state_ = State::String;
+    if (high_surrogate_ != 0 && c != 'u') { error("Unpaired surrogate in \\u escape", lexeme_location_); }
+    switch (c) {
+
+    case '\\': buffer_ += '\\'; break;
+    case '"':  buffer_ += '"';  break;
+    case '/':  buffer_ += '/';  break;
+    case 'b':  buffer_ += '\b'; break;
+    case 'f':  buffer_ += '\f'; break;
+    case 'n':  buffer_ += '\n'; break;
+    case 'r':  buffer_ += '\r'; break;
+    case 't':  buffer_ += '\t'; break;
+    case 'u': {
+        hex_digits_ = 0;
+        hex_value_ = 0;
+        state_ = State::Unicode;
+        break;
+    }
+    default: {
+        error(std::string("\\") + c + " is an invalid escape character", locate(offset()));
+        break;
+    }
+
+    }
+    run_start_ = current_;
+}
+
+void PushScanner::scan_unicode() {
+    for (; hex_digits_ < 4; ++hex_digits_) {
+        if (chunk_end()) {
+            if (finished_) { error("Unterminated string", lexeme_location_); }
+            return;
+        }
+
+        auto const c = chunk_[current_++];
+        auto const digit = hex_digit_value(c);
+        if (digit < 0) {
+            error(std::string("Escape hex-code character can only be in [0, 9] or [a, f] or [A, F], found \"")
+                  + c + '"', locate(offset()));
+        }
+        hex_value_ = (hex_value_ << 4) | static_cast<char32_t>(digit);
+    }
+
+    // decoded like Scanner does, a high surrogate waits for its low half
+    state_ = State::String;
+    run_start_ = current_;
+    if (high_surrogate_ != 0) {
+        if (not is_low_surrogate(hex_value_)) { error("Unpaired surrogate in \\u escape", lexeme_location_); }
+        append_utf8(buffer_, combine_surrogates(high_surrogate_, hex_value_));
+        high_surrogate_ = 0;
+    } else if (is_high_surrogate(hex_value_)) {
+        high_surrogate_ = hex_value_;
+    } else if (is_low_surrogate(hex_value_)) {
+        error("Unpaired surrogate in \\u escape", lexeme_location_);
+    } else {
+        append_utf8(buffer_, hex_value_);
+    }
+}
+
+void PushScanner::scan_number() {
+    while (not chunk_end() && is_on_digit(chunk_[current_])) {
+        ++current_;
+    }
+    // the next chunk may continue the number
+    if (chunk_end() && not finished_) { return; }
+
+    auto text = chunk_.substr(run_start_, current_ - run_start_);
+    if (buffered_) {
+        buffer_.append(text);
+        text = buffer_;
+    }
+
+    auto number = Number{};
+    switch (parse_number(text, number)) {
+    case NumberError::None: break;
+    case NumberError::Invalid:
+        error("Cannot convert " + std::string(text) + " to number", lexeme_location_);
+        break;
+    case NumberError::OutOfRange:
+        error("Number " + std::string(text) + " is out of the range of a double", lexeme_location_);
+        break;
+    }
+    state_ = State::Between;
+    add_token(TokenType::Number, number);
+}
+
+void PushScanner::scan_identifier() {
+    while (not chunk_end() && is_alpha(chunk_[current_])) {
+        ++current_;
+    }
+    if (chunk_end() && not finished_) { return; }
+
+    auto iden = chunk_.substr(run_start_, current_ - run_start_);
+    if (buffered_) {
+        buffer_.append(iden);
+        iden = buffer_;
+    }
+
+    state_ = State::Between;
+    if      (iden == "null")  { add_token(TokenType::Null); }
+    else if (iden == "true")  { add_token(TokenType::True); }
+    else if (iden == "false") { add_token(TokenType::False); }
+    else    { error('"' + std::string(iden) + "\" is an invalid literal", lexeme_location_); }
+}
+
+void PushScanner::release_chunk() {
+    if (state_ == State::String || state_ == State::Number || state_ == State::Identifier) {
+        buffer_.append(chunk_.substr(run_start_));
+        buffered_ = true;
+    }
+    static_cast<void>(locate(chunk_offset_ + chunk_.size()));
+
+    chunk_offset_ += chunk_.size();
+    chunk_ = {};
+    current_ = 0;
+    run_start_ = 0;
+}
+
+auto PushScanner::chunk_end() const noexcept -> bool {
+    return current_ == chunk_.size();
+}
+
+auto PushScanner::offset() const noexcept -> std::size_t {
+    return chunk_offset_ + current_;
+}
+
+auto PushScanner::locate(std::size_t offset) -> SourceLocation {
+    assert(located_offset_ <= offset && offset <= chunk_offset_ + chunk_.size());
+
+    auto const unseen = chunk_.substr(located_offset_ - chunk_offset_, offset - located_offset_);
+    line_ += static_cast<std::size_t>(std::count(unseen.begin(), unseen.end(), '\n'));
+    if (auto const last_newline = unseen.rfind('\n'); last_newline != std::string_view::npos) {
+        line_start_ = located_offset_ + last_newline + 1;
+    }
+    located_offset_ = offset;
+
+    return { line_, offset - line_start_ + 1 };
+}
+
+void PushScanner::add_token(TokenType type, Token::literal_t literal) {
+    token_ = Token(lexeme_start_, type, std::move(literal));
+    token_location_ = lexeme_location_;
+    has_token_ = true;
+}
+
+void PushScanner::check_utf8(std::string_view text) const {
+    if (find_invalid_utf8(text) != std::string_view::npos) { error("Invalid UTF-8 in string", lexeme_location_); }
+}
+
+void PushScanner::error(std::string const& message, SourceLocation location) const {
+    std::stringstream ss;
+    ss << "Scan error at "
+       << '[' << location.line << ':' << location.column << "]: " << message;
+
+    throw JsonException(ss.str());
+}
+
+} // namespace json
@@ -0,0 +1,534 @@
+#include "json_parser/detail/Regex.h"
+#include "json_parser/JsonException.h"
+#include "json_parser/detail/Utf8.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <string>
+
+namespace json {
+
+// helpers
+
+namespace {
+
+using Range = std::pair<char32_t, char32_t>;
+
+constexpr char32_t max_code_point = 0x10FFFF;
+constexpr char32_t replacement_character = 0xFFFD;
+// before the first and after the last code point, and a class escape in a class
+constexpr char32_t no_code_point = std::numeric_limits<char32_t>::max();
+// the compiler recurses once per group
+constexpr std::size_t max_group_depth = 256;
+constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+auto is_digit(char const c) -> bool {
+    return '0' <= c && c <= '9';
+}
+
+auto is_alnum(char const c) -> bool {
+    return is_digit(c) || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+auto is_word(char32_t const c) -> bool {
+    return c < 0x80 && (is_alnum(static_cast<char>(c)) || c == '_');
+}
+
+// the code point at `i` and its length in bytes
+auto decode(std::string_view text, std::size_t i, std::size_t& length) -> char32_t {
+    auto const lead = static_cast<unsigned char>(text[i]);
+    length = 1;
+    if (lead < 0x80) { return lead; }
+    length = utf8_sequence_length(text, i);
+    if (length == 0) {
+        length = 1;
+        return replacement_character;
+    }
+    auto code_point = static_cast<char32_t>(lead & (0x7Fu >> length));
+    for (std::size_t k = 1; k < length; ++k) {
+        code_point = (code_point << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3Fu);
+    }
+    return code_point;
+}
+
+// sorted, overlapping and adjacent ranges merged
+auto normalized(std::vector<Range> ranges) -> std::vector<Range> {
+    std::sort(ranges.begin(), ranges.end());
+    auto merged = std::vector<Range>{};
+    for (auto const& range : ranges) {
+        if (not merged.empty() && range.first <= merged.back().second + 1) {
+            merged.back().second = std::max(merged.back().second, range.second);
+        } else {
+            merged.push_back(range);
+        }
+    }
+    return merged;
+}
+
+// of normalized ranges
+auto complement(std::vector<Range> const& ranges) -> std::vector<Range> {
+    auto result = std::vector<Range>{};
+    char32_t next = 0;
+    for (auto const& [first, last] : ranges) {
+        if (next < first) { result.emplace_back(next, first - 1); }
+        next = last + 1;
+    }
+    if (next <= max_code_point) { result.emplace_back(next, max_code_point); }
+    return result;
+}
+
+auto contains(std::vector<Range> const& ranges, char32_t const c) -> bool {
+    auto const it = std::upper_bound(ranges.begin(), ranges.end(), c,
+        [](char32_t value, Range const& range) { return value < range.first; });
+    return it != ranges.begin() && c <= std::prev(it)->second;
+}
+
+auto digit_ranges() -> std::vector<Range> {
+    return { { '0', '9' } };
+}
+
+auto word_ranges() -> std::vector<Range> {
+    return { { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' } };
+}
+
+// WhiteSpace and LineTerminator of ECMAScript
+auto space_ranges() -> std::vector<Range> {
+    return { { 0x09, 0x0D }, { 0x20, 0x20 }, { 0xA0, 0xA0 }, { 0x1680, 0x1680 }, { 0x2000, 0x200A },
+             { 0x2028, 0x2029 }, { 0x202F, 0x202F }, { 0x205F, 0x205F }, { 0x3000, 0x3000 }, { 0xFEFF, 0xFEFF } };
+}
+
+// what "." does not match
+auto line_terminator_ranges() -> std::vector<Range> {
+    return { { '\n', '\n' }, { '\r', '\r' }, { 0x2028, 0x2029 } };
+}
+
+// The parsed expression. Classes are indices into Regex::classes_
+struct Node {
+    enum class Kind : std::uint8_t {
+        Empty,
+        Class,
+        Begin,
+        End,
+        WordBoundary,
+        NotWordBoundary,
+        Sequence,
+        Alternation,
+        Repeat,
+    };
+
+    explicit Node(Kind node_kind)
+        : kind(node_kind), class_index(0), min(0), max(0), children() { }
+
+    Kind kind;
+    std::uint32_t class_index;
+    std::size_t min;            // of a Repeat
+    std::size_t max;
+    std::vector<Node> children;
+};
+
+} // namespace
+
+// Parses a pattern into Nodes, then emits their program
+class Regex::Compiler {
+public:
+
+    Compiler(std::string_view pattern, Regex& regex)
+        : pattern_(pattern), position_(0), regex_(regex) { }
+
+    void compile() {
+        auto const root = parse_alternation(0);
+        // only a ")" stops the outermost alternation early
+        if (position_ != pattern_.size()) { fail("Unmatched \")\""); }
+        emit(root);
+        push(Op::Match);
+        regex_.anchored_ = regex_.program_.front().op == Op::Begin;
+    }
+
+private:
+
+    using Kind = Node::Kind;
+
+    auto parse_alternation(std::size_t depth) -> Node {
+        auto node = parse_sequence(depth);
+        if (not at('|')) { return node; }
+        auto alternation = Node{ Kind::Alternation };
+        alternation.children.push_back(std::move(node));
+        while (at('|')) {
+            ++position_;
+            alternation.children.push_back(parse_sequence(depth));
+        }
+        return alternation;
+    }
+
+    auto parse_sequence(std::size_t depth) -> Node {
+        auto sequence = Node{ Kind::Sequence };
+        while (position_ < pattern_.size() && not at('|') && not at(')')) {
+            sequence.children.push_back(parse_quantified(depth));
+        }
+        return sequence;
+    }
+
+    auto parse_quantified(std::size_t depth) -> Node {
+        auto atom = parse_atom(depth);
+        auto repeat = Node{ Kind::Repeat };
+        if (not parse_quantifier(repeat.min, repeat.max)) { return atom; }
+        if (atom.kind != Kind::Class && atom.kind != Kind::Sequence && atom.kind != Kind::Alternation) {
+            fail("Nothing to repeat");
+        }
+        // lazy quantifiers match the same texts
+        if (at('?')) { ++position_; }
+        if (at('*') || at('+') || at('?') || is_quantifier_brace()) { fail("Nothing to repeat"); }
+        repeat.children.push_back(std::move(atom));
+        return repeat;
+    }
+
+    auto parse_quantifier(std::size_t& min, std::size_t& max) -> bool {
+        if (at('*')) { ++position_; min = 0; max = unbounded; return true; }
+        if (at('+')) { ++position_; min = 1; max = unbounded; return true; }
+        if (at('?')) { ++position_; min = 0; max = 1;         return true; }
+        return at('{') && parse_braces(min, max);
+    }
+
+    // {n}, {n,} or {n,m}, anything else being a literal "{". Counts
+    // saturate past max_size, the program would be too large anyway
+    auto parse_braces(std::size_t& min, std::size_t& max) -> bool {
+        auto i = position_ + 1;
+        auto const read = [&](std::size_t& value) {
+            auto const start = i;
+            for (value = 0; i < pattern_.size() && is_digit(pattern_[i]); ++i) {
+                value = std::min(value * 10 + static_cast<std::size_t>(pattern_[i] - '0'), max_size + 1);
+            }
+            return i != start;
+        };
+        if (not read(min)) { return false; }
+        max = min;
+        if (i < pattern_.size() && pattern_[i] == ',') {
+            ++i;
+            if (not read(max)) { max = unbounded; }
+        }
+        if (i == pattern_.size() || pattern_[i] != '}') { return false; }
+        if (max < min) { fail("Numbers out of order in {} quantifier"); }
+        position_ = i + 1;
+        return true;
+    }
+
+    auto is_quantifier_brace() -> bool {
+        auto const position = position_;
+        auto min = std::size_t{0};
+        auto max = std::size_t{0};
+        auto const found = at('{') && parse_braces(min, max);
+        position_ = position;
+        return found;
+    }
+
+    auto parse_atom(std::size_t depth) -> Node {
+        switch (pattern_[position_]) {
+        case '(': return parse_group(depth);
+        case '[': return parse_class();
+        case '.': ++position_; return class_node(complement(line_terminator_ranges()));
+        case '^': ++position_; return Node{ Kind::Begin };
+        case '$': ++position_; return Node{ Kind::End };
+        case '\\': return parse_escape();
+        case '*': case '+': case '?': fail("Nothing to repeat");
+        case '{': if (is_quantifier_brace()) { fail("Nothing to repeat"); } break;
+        default: break;
+        }
+        auto const c = next_code_point();
+        return class_node({ { c, c } });
+    }
+
+    auto parse_group(std::size_t depth) -> Node {
+        if (depth == max_group_depth) { fail("Groups nest too deeply"); }
+        ++position_;
+        if (at('?')) {
+            ++position_;
+            auto const lookbehind = at('<') && position_ + 1 < pattern_.size()
+                                 && (pattern_[position_ + 1] == '=' || pattern_[position_ + 1] == '!');
+            if (at('=') || at('!') || lookbehind) { fail("Lookarounds are not supported"); }
+            if (at(':')) {
+                ++position_;
+            } else if (at('<')) {
+                // a named group matches like any other
+                auto const end = pattern_.find('>', position_);
+                if (end == std::string_view::npos) { fail("Unterminated group name"); }
+                position_ = end + 1;
+            } else {
+                fail("Invalid group");
+            }
+        }
+        auto node = parse_alternation(depth + 1);
+        if (not at(')')) { fail("Missing \")\""); }
+        ++position_;
+        return node;
+    }
+
+    auto parse_escape() -> Node {
+        ++position_;
+        if (position_ == pattern_.size()) { fail("\\ at end of pattern"); }
+        if (at('b')) { ++position_; return Node{ Kind::WordBoundary }; }
+        if (at('B')) { ++position_; return Node{ Kind::NotWordBoundary }; }
+        return class_node(parse_escaped_ranges());
+    }
+
+    // the code points of the escape after a backslash, but \b and \B
+    auto parse_escaped_ranges() -> std::vector<Range> {
+        auto const single = [](char32_t c) { return std::vector<Range>{ { c, c } }; };
+        auto const c = pattern_[position_++];
+        switch (c) {
+        case 'd': return digit_ranges();
+        case 'D': return complement(digit_ranges());
+        case 'w': return word_ranges();
+        case 'W': return complement(word_ranges());
+        case 's': return space_ranges();
+        case 'S': return complement(space_ranges());
+        case 'b': return single(0x08);     // in a class only
+        case 'n': return single('\n');
+        case 'r': return single('\r');
+        case 't': return single('\t');
+        case 'f': return single('\f');
+        case 'v': return single('\v');
+        case '0': {
+            if (position_ < pattern_.size() && is_digit(pattern_[position_])) {
+                fail("Octal escapes are not supported");
+            }
+            return single(0);
+        }
+        case 'x': return single(parse_hex(2));
+        case 'u': return single(parse_unicode_escape());
+        case 'c': {
+            if (position_ == pattern_.size() || not is_alnum(pattern_[position_]) || is_digit(pattern_[position_])) {
+                fail("Invalid \\c escape");
+            }
+            return single(static_cast<char32_t>(pattern_[position_++] % 32));
+        }
+        case 'k': fail("Backreferences are not supported");
+        case 'p': case 'P': fail("Unicode property escapes are not supported");
+        default: break;
+        }
+        if (is_digit(c)) { fail("Backreferences are not supported"); }
+        if (is_alnum(c)) { fail(std::string("Invalid escape \\") + c); }
+        // any other character stands for itself, "\." say
+        --position_;
+        return single(next_code_point());
+    }
+
+    auto parse_hex(std::size_t digits) -> char32_t {
+        auto value = char32_t{0};
+        for (std::size_t k = 0; k < digits; ++k, ++position_) {
+            auto const digit = position_ < pattern_.size() ? hex_digit_value(pattern_[position_]) : -1;
+            if (digit < 0) { fail("Invalid hex escape"); }
+            value = value * 16 + static_cast<char32_t>(digit);
+        }
+        return value;
+    }
+
+    // \uFFFF, a surrogate pair of them, or \u{10FFFF}
+    auto parse_unicode_escape() -> char32_t {
+        if (at('{')) {
+            ++position_;
+            auto value = char32_t{0};
+            auto digits = std::size_t{0};
+            for (; position_ < pattern_.size() && hex_digit_value(pattern_[position_]) >= 0; ++position_, ++digits) {
+                value = value * 16 + static_cast<char32_t>(hex_digit_value(pattern_[position_]));
+                if (value > max_code_point) { fail("Invalid hex escape"); }
+            }
+            if (digits == 0 || not at('}')) { fail("Invalid hex escape"); }
+            ++position_;
+            return value;
+        }
+        auto const value = parse_hex(4);
+        auto const low_follows = pattern_.substr(position_, 2) == "\\u";
+        if (is_high_surrogate(value) && low_follows) {
+            auto const position = position_;
+            position_ += 2;
+            auto const low = parse_hex(4);
+            if (is_low_surrogate(low)) { return combine_surrogates(value, low); }
+            position_ = position;
+        }
+        return value;
+    }
+
+    auto parse_class() -> Node {
+        ++position_;
+        auto const negated = at('^');
+        if (negated) { ++position_; }
+        auto ranges = std::vector<Range>{};
+        while (not at(']')) {
+            auto first = std::vector<Range>{};
+            auto const low = parse_class_atom(first);
+            auto const is_range = at('-') && position_ + 1 < pattern_.size() && pattern_[position_ + 1] != ']';
+            if (not is_range) {
+                ranges.insert(ranges.end(), first.begin(), first.end());
+                continue;
+            }
+            ++position_;
+            auto last = std::vector<Range>{};
+            auto const high = parse_class_atom(last);
+            if (low == no_code_point || high == no_code_point) { fail("Invalid range in character class"); }
+            if (high < low) { fail("Range out of order in character class"); }
+            ranges.emplace_back(low, high);
+        }
+        ++position_;
+        ranges = normalized(std::move(ranges));
+        return class_node(negated ? complement(ranges) : std::move(ranges));
+    }
+
+    // One member of a class into `ranges`. Returns its code point, or
+    // no_code_point for a class escape such as \d
+    auto parse_class_atom(std::vector<Range>& ranges) -> char32_t {
+        if (position_ == pattern_.size()) { fail("Missing \"]\""); }
+        if (at('\\')) {
+            ++position_;
+            if (position_ == pattern_.size()) { fail("\\ at end of pattern"); }
+            if (at('B')) { fail("Invalid escape \\B"); }
+            ranges = parse_escaped_ranges();
+        } else {
+            auto const c = next_code_point();
+            ranges = { { c, c } };
+        }
+        auto const is_single = ranges.size() == 1 && ranges.front().first == ranges.front().second;
+        return is_single ? ranges.front().first : no_code_point;
+    }
+
+    auto class_node(std::vector<Range> ranges) -> Node {
+        auto node = Node{ Kind::Class };
+        node.class_index = static_cast<std::uint32_t>(regex_.classes_.size());
+        regex_.classes_.push_back(std::move(ranges));
+        return node;
+    }
+
+    auto next_code_point() -> char32_t {
+        auto length = std::size_t{0};
+        auto const c = decode(pattern_, position_, length);
+        position_ += length;
+        return c;
+    }
+
+    [[nodiscard]] auto at(char const c) const -> bool {
+        return position_ < pattern_.size() && pattern_[position_] == c;
+    }
+
+    void emit(Node const& node) {
+        switch (node.kind) {
+        case Kind::Empty:           break;
+        case Kind::Class:           push(Op::Class, node.class_index); break;
+        case Kind::Begin:           push(Op::Begin); break;
+        case Kind::End:             push(Op::End); break;
+        case Kind::WordBoundary:    push(Op::WordBoundary); break;
+        case Kind::NotWordBoundary: push(Op::NotWordBoundary); break;
+        case Kind::Sequence: {
+            for (auto const& child : node.children) { emit(child); }
+            break;
+        }
+        case Kind::Alternation: {
+            // every branch but the last: split to the next branch, jump to the end
+            auto jumps = std::vector<std::size_t>{};
+            for (std::size_t i = 0; i + 1 < node.children.size(); ++i) {
+                auto const split = push(Op::Split);
+                emit(node.children[i]);
+                jumps.push_back(push(Op::Jump));
+                patch(split);
+            }
+            emit(node.children.back());
+            for (auto const jump : jumps) { patch(jump); }
+            break;
+        }
+        case Kind::Repeat: {
+            auto const& child = node.children.front();
+            for (std::size_t i = 0; i < node.min; ++i) { emit(child); }
+            if (node.max == unbounded) {
+                auto const split = push(Op::Split);
+                emit(child);
+                push(Op::Jump, static_cast<std::uint32_t>(split));
+                patch(split);
+            } else {
+                auto splits = std::vector<std::size_t>{};
+                for (auto i = node.min; i < node.max; ++i) {
+                    splits.push_back(push(Op::Split));
+                    emit(child);
+                }
+                for (auto const split : splits) { patch(split); }
+            }
+            break;
+        }
+        }
+    }
+
+    auto push(Op op, std::uint32_t arg = 0) -> std::size_t {
+        if (regex_.program_.size() == max_size) { fail("Pattern is too large once its quantifiers are expanded"); }
+        regex_.program_.push_back({ op, arg });
+        return regex_.program_.size() - 1;
+    }
+
+    // points the Split or Jump at `at` to the next instruction to be emitted
+    void patch(std::size_t const instruction) {
+        regex_.program_[instruction].arg = static_cast<std::uint32_t>(regex_.program_.size());
+    }
+
+    [[noreturn]] void fail(std::string const& message) const {
+        throw JsonException("Invalid regular expression: " + message + " at offset " + std::to_string(position_));
+    }
+
+private:
+
+    std::string_view pattern_;
+    std::size_t position_;
+    Regex& regex_;
+};
+
+// Regex member functions
+
+Regex::Regex(std::string_view pattern)
+    : program_(), classes_(), anchored_(false) {
+    Compiler(pattern, *this).compile();
+}
+
+auto Regex::search(std::string_view text) const -> bool {
+    // Threads are instruction indices. Each one is followed through Splits,
+    // Jumps and assertions to the Class instructions waiting for the next
+    // code point, at most once per position
+    auto waiting = std::vector<std::uint32_t>{};
+    auto advanced = std::vector<std::uint32_t>{};
+    auto pending = std::vector<std::uint32_t>{};
+    auto added_at = std::vector<std::size_t>(program_.size(), unbounded);
+
+    auto previous = no_code_point;
+    for (std::size_t i = 0, step = 0;; ++step) {
+        auto length = std::size_t{0};
+        auto const at_end = i == text.size();
+        auto const c = at_end ? no_code_point : decode(text, i, length);
+        auto const boundary = is_word(previous) != is_word(c);
+
+        pending.assign(advanced.begin(), advanced.end());
+        // a match may start at any position
+        if (i == 0 || not anchored_) { pending.push_back(0); }
+        waiting.clear();
+        while (not pending.empty()) {
+            auto const pc = pending.back();
+            pending.pop_back();
+            if (added_at[pc] == step) { continue; }
+            added_at[pc] = step;
+            auto const& instruction = program_[pc];
+            switch (instruction.op) {
+            case Op::Class:           waiting.push_back(pc); break;
+            case Op::Split:           pending.push_back(instruction.arg); pending.push_back(pc + 1); break;
+            case Op::Jump:            pending.push_back(instruction.arg); break;
+            case Op::Begin:           if (i == 0) { pending.push_back(pc + 1); } break;
+            case Op::End:             if (at_end) { pending.push_back(pc + 1); } break;
+            case Op::WordBoundary:    if (boundary) { pending.push_back(pc + 1); } break;
+            case Op::NotWordBoundary: if (not boundary) { pending.push_back(pc + 1); } break;
+            case Op::Match:           return true;
+            }
+        }
+        if (at_end || (waiting.empty() && anchored_)) { return false; }
+
+        advanced.clear();
+        for (auto const pc : waiting) {
+            if (contains(classes_[program_[pc].arg], c)) { advanced.push_back(pc + 1); }
+        }
+        previous = c;
+        i += length;
+    }
+}
+
+} // namespace json
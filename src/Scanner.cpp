@@ -1,34 +1,71 @@
 #include "json_parser/detail/Scanner.h"
+#include "json_parser/detail/SourceLocation.h"
+#include "json_parser/detail/Utf8.h"
 #include "json_parser/JsonException.h"
-#include <cctype>
-#include <cassert>
-#include <sstream>
-#include <iomanip>
-#include <charconv>
+#include <algorithm>
 
 namespace json  {
 
-Scanner::Scanner(std::string const& source)
+// helpers
+
+inline static auto is_digit(char const c) -> bool {
+    return '0' <= c && c <= '9';
+}
+
+inline static auto is_alpha(char const c) -> bool {
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+inline static auto is_whitespace(char const c) -> bool {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Scanner member functions
+
+Scanner::Scanner(std::string_view source, InstructionSet set)
+    : Scanner(source, 0, set) { }
+
+Scanner::Scanner(std::string_view source, Scratch scratch, InstructionSet set)
+    : Scanner(source, 0, set) {
+    scratch_ = std::move(scratch);
+}
+
+Scanner::Scanner(std::string_view source, std::size_t from, InstructionSet set)
 :
-    tokens_(std::vector<Token>{}),
-    source_(source),
+    indexer_(source.substr(from), set),
+    scratch_(),
+    scratch_index_(0),
+    token_(),
+    has_token_(false),
+    document_(source),
+    base_(from),
+    source_(source.substr(from)),
     start_(0),
-    start_line_(0),
-    start_column_(0),
     current_(0),
-    current_line_(1),
-    current_column_(1)
+    mode_(ErrorMode::Throw),
+    error_()
 {
 }
 
 auto Scanner::scan() && -> std::vector<Token> {
-    while (is_not_end()) {
-        start_ = current_;
+    auto tokens = std::vector<Token>{};
+    do {
+        tokens.push_back(next_token());
+    } while (tokens.back().type != TokenType::Eof);
+
+    return tokens;
+}
+
+auto Scanner::next_token() -> Token {
+    has_token_ = false;
+    while (is_not_end() && not has_token_) {
         scan_token();
     }
-    add_token(TokenType::Eof);
+    if (error_) { return Token(error_.offset, TokenType::Error, Token::NullLiteral{}); }
+    // Eof keeps the start position of the last scanned lexeme
+    if (not has_token_) { add_token(TokenType::Eof); }
 
-    return std::move(tokens_);
+    return std::move(token_);
 }
 
 void Scanner::scan_token() {
@@ -44,98 +81,164 @@ void Scanner::scan_token() {
     case ':': add_token(TokenType::Colon);        break;
     case '"':           scan_string();            break;
     case '+': case '-': scan_number();            break;
-    //  DO NOTHING cause advance() takes care of increasing current_line_, current_column_;
-    case ' ': case '\n': case '\r': case '\t':    break;
+    case ' ': case '\n': case '\r': case '\t': skip_whitespace(); break;
     default: {
         if      (is_on_digit(c)) { scan_number(); }
-        else if (isalpha(c))     { scan_identifier(); }
-        else    { error(std::string("\"") + c + "\" is an invalid character"); }
+        else if (is_alpha(c))    { scan_identifier(); }
+        else    { error(ParseErrc::InvalidCharacter); }
         break;
     }
 
     }
 }
 
+void Scanner::skip_whitespace() {
+    // The indexer reports every lexeme start outside of strings, so the bytes
+    // up to the next structural position are all whitespace
+    current_ = indexer_.next_from(current_);
+    // like a whitespace-only lexeme, Eof points at the last whitespace byte
+    if (not is_not_end()) { start_ = source_.length() - 1; }
+}
+
 void Scanner::scan_number() {
+    // decoded in the same pass that finds its end
+    auto number = Number{};
+    auto length = std::size_t{0};
+    auto const status = parse_number_prefix(source_.substr(start_), number, length);
+    current_ = start_ + length;
+    if (status == NumberError::None && not is_on_digit(peek())) {
+        add_token(TokenType::Number, number);
+        return;
+    }
+
+    // report the whole malformed lexeme, like "1-2e"
+    current_ = std::max(current_, start_ + 1);
     while (is_on_digit(peek())) {
         advance();
     }
-
     auto const sv = source_.substr(start_, current_ - start_);
-    double num = 0;
-    auto const [_, err] = std::from_chars(sv.data(), sv.data() + sv.size(), num);
-    if (err == std::errc::invalid_argument) {
-        error("Cannot convert " + std::string(sv) + " to number");
+    switch (parse_number(sv, number)) {
+    case NumberError::None:       break;
+    case NumberError::Invalid:    return error(ParseErrc::InvalidNumber);
+    case NumberError::OutOfRange: return error(ParseErrc::NumberOutOfRange);
     }
-    add_token(TokenType::Number, num);
+    add_token(TokenType::Number, number);
 }
 
 void Scanner::scan_string() {
-    std::stringstream ss;
-    while (is_not_end()) {
-        char const c = advance();
-        if      (c == '"')  { break; }
-        else if (c == '\\') { ss << scan_escape_sequence(); }
-        else                { ss << c; }
+    // strings without escape sequences are a plain slice of the source
+    auto const begin = current_;
+    current_ = find_quote_or_backslash(source_, current_);
+    auto const plain = source_.substr(begin, current_ - begin);
+    if (not is_not_end()) { return error(ParseErrc::UnterminatedString); }
+    if (advance() == '"') {
+        if (check_utf8(plain)) { add_token(TokenType::String, plain); }
+        return;
     }
 
-    // dirty fix since is_not_end() will yield false now if the last character of source_ is '"'
-    if (current_ > source_.length()) {
-        error("Unterminated string");
+    // escaped strings are decoded into the scratch buffer not used last time,
+    // the runs between escape sequences copied whole
+    scratch_index_ ^= 1;
+    auto& string = scratch_[scratch_index_];
+    string.assign(plain);
+    for (;;) {
+        if (not scan_escape_sequence(string)) { return; }
+        auto const run_begin = current_;
+        current_ = find_quote_or_backslash(source_, current_);
+        string.append(source_.substr(run_begin, current_ - run_begin));
+        if (not is_not_end()) { return error(ParseErrc::UnterminatedString); }
+        if (advance() == '"') { break; }
     }
-    add_token(TokenType::String, ss.str());
+    // decoded escapes are valid UTF-8, checking the whole string once is simplest
+    if (check_utf8(string)) { add_token(TokenType::String, std::string_view(string)); }
 }
 
-auto Scanner::scan_escape_sequence() -> char {
+auto Scanner::scan_escape_sequence(std::string& out) -> bool {
+    if (not is_not_end()) {
+        error(ParseErrc::UnterminatedString);
+        return false;
+    }
     char const c = advance();
 
     switch (c) {
 
-    case '\\': return '\\';
-    case '"':  return '"';
-    case '/':  return '/';
-    case 'b':  return '\b';
-    case 'f':  return '\f';
-    case 'n':  return '\n';
-    case 'r':  return '\r';
-    case 't':  return '\t';
-    case 'u':  return scan_hex_digit();
+    case '\\': out += '\\'; break;
+    case '"':  out += '"';  break;
+    case '/':  out += '/';  break;
+    case 'b':  out += '\b'; break;
+    case 'f':  out += '\f'; break;
+    case 'n':  out += '\n'; break;
+    case 'r':  out += '\r'; break;
+    case 't':  out += '\t'; break;
+    case 'u':  return scan_unicode_escape(out);
     default: {
         update_start_position();
-        error(std::string("\\") + c + " is an invalid escape character");
-        break;
+        error(ParseErrc::InvalidEscape);
+        return false;
     }
 
     }
-    return '\0';
-}
-
-auto Scanner::scan_hex_digit() -> char {
-    auto const factors = { 12u, 8u, 4u, 0u };
-    unsigned int hex_value = 0;
-    for (auto const factor : factors) {
-        auto const c = advance();
-        if      ('0' <= c && c <= '9') { hex_value += static_cast<unsigned int>(c - '0') << factor; }
-        else if ('a' <= c && c <= 'f') { hex_value += static_cast<unsigned int>(c - 'a') << factor; }
-        else if ('A' <= c && c <= 'F') { hex_value += static_cast<unsigned int>(c - 'A') << factor; }
-        else {
-            std::stringstream ss;
-            update_start_position();
-            ss << "Escape hex-code character can only be in [0, 9] or [a, z] or [A. Z], found ";
-            ss << '"' << c << '"';
-            error(ss.str());
+    return true;
+}
+
+auto Scanner::scan_unicode_escape(std::string& out) -> bool {
+    auto code_point = char32_t{};
+    if (not scan_hex_digits(code_point)) { return false; }
+    if (is_high_surrogate(code_point)) {
+        // characters above U+FFFF are a pair of escapes, high then low surrogate
+        auto low = char32_t{};
+        for (auto const expected : { '\\', 'u' }) {
+            if (not is_not_end()) {
+                error(ParseErrc::UnterminatedString);
+                return false;
+            }
+            if (advance() != expected) {
+                error(ParseErrc::UnpairedSurrogate);
+                return false;
+            }
         }
+        if (not scan_hex_digits(low)) { return false; }
+        if (not is_low_surrogate(low)) {
+            error(ParseErrc::UnpairedSurrogate);
+            return false;
+        }
+        code_point = combine_surrogates(code_point, low);
+    } else if (is_low_surrogate(code_point)) {
+        error(ParseErrc::UnpairedSurrogate);
+        return false;
     }
+    append_utf8(out, code_point);
+    return true;
+}
 
-    assert(0x000 <= hex_value && hex_value <= 0xFFFF);
-    if(0x000 <= hex_value && hex_value <= 0xFFFF) {
-        error("Escape hex-code value can only in range [0, 2^16-1(65535)], computed " + std::to_string(hex_value));
+auto Scanner::scan_hex_digits(char32_t& value) -> bool {
+    value = 0;
+    for (auto i = 0; i < 4; ++i) {
+        if (not is_not_end()) {
+            error(ParseErrc::UnterminatedString);
+            return false;
+        }
+        auto const digit = hex_digit_value(advance());
+        if (digit < 0) {
+            // reported just after the digit, which the message quotes
+            update_start_position();
+            error(ParseErrc::InvalidHexDigit);
+            return false;
+        }
+        value = (value << 4) | static_cast<char32_t>(digit);
     }
-    return static_cast<char>(hex_value);
+    return true;
+}
+
+auto Scanner::check_utf8(std::string_view text) -> bool {
+    // reported at the start of the string, like every string error
+    if (find_invalid_utf8(text) == std::string_view::npos) { return true; }
+    error(ParseErrc::InvalidUtf8);
+    return false;
 }
 
 void Scanner::scan_identifier() {
-    while (isalpha(peek())) {
+    while (is_alpha(peek())) {
         advance();
     }
 
@@ -144,11 +247,11 @@ void Scanner::scan_identifier() {
     if      (iden == "null")  { add_token(TokenType::Null); }
     else if (iden == "true")  { add_token(TokenType::True); }
     else if (iden == "false") { add_token(TokenType::False); }
-    else                      { error('"' + std::string(iden) + "\" is an invalid literal"); }
+    else                      { error(ParseErrc::InvalidLiteral); }
 }
 
 auto Scanner::is_on_digit(char const c) const -> bool {
-    return isdigit(c) || tolower(c) == 'e' ||
+    return is_digit(c) || c == 'e' || c == 'E' ||
            c == '+' || c == '-' || c == '.';
 }
 
@@ -156,36 +259,44 @@ auto Scanner::is_not_end() const -> bool {
     return current_ < source_.length();
 }
 
+auto Scanner::source() const -> std::string_view {
+    return document_;
+}
+
+void Scanner::set_error_mode(ErrorMode mode) noexcept {
+    mode_ = mode;
+}
+
+auto Scanner::error() const noexcept -> ParseError const& {
+    return error_;
+}
+
+auto Scanner::release_scratch() noexcept -> Scratch {
+    return std::move(scratch_);
+}
+
 auto Scanner::advance() -> char {
-    char const c = source_[current_++];
-    if (c == '\n') {
-        ++current_line_;
-        current_column_ = 1;
-    } else {
-        ++current_column_;
-    }
-    return c;
+    return source_[current_++];
 }
 
 auto Scanner::peek() const -> char {
-    return source_[current_];
+    return is_not_end() ? source_[current_] : '\0';
 }
 
 void Scanner::update_start_position() {
-    start_column_ = current_column_;
-    start_line_ = current_line_;
+    start_ = current_;
 }
 
 void Scanner::add_token(TokenType type, Token::literal_t literal) {
-    tokens_.emplace_back(start_line_, start_column_, type, std::move(literal));
+    token_ = Token(base_ + start_, type, std::move(literal));
+    has_token_ = true;
 }
 
-void Scanner::error(std::string const& message) const {
-    std::stringstream ss;
-    ss << "Scan error at "
-       << '[' << start_line_ << ':' << start_column_ << "]: " << message;
-
-    throw JsonException(ss.str());
+void Scanner::error(ParseErrc code) {
+    error_ = ParseError{ code, TokenType::Error, base_ + start_ };
+    if (mode_ == ErrorMode::Throw) { throw JsonException(error_.message(document_)); }
+    // nothing more is scanned, next_token() returns Error tokens
+    current_ = source_.length();
 }
 
 } // namespace json
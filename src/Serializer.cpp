@@ -0,0 +1,252 @@
+#include "json_parser/Serializer.h"
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <system_error>
+
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+
+#if __has_include(<unistd.h>)
+#   include <unistd.h>
+#   define JSON_PARSER_HAS_UNISTD 1
+#else
+#   define JSON_PARSER_HAS_UNISTD 0
+#endif
+
+namespace json {
+
+// helpers
+
+inline static auto needs_escape(char const c) -> bool {
+    return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+}
+
+// Length of the prefix of `text` that can be written as is. Strings are
+// mostly clean, so whole 16 byte blocks are checked at once
+static auto clean_prefix(std::string_view text) -> std::size_t {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    auto const quote     = _mm_set1_epi8('"');
+    auto const backslash = _mm_set1_epi8('\\');
+    auto const control   = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= text.size(); i += 16) {
+        auto const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(text.data() + i));
+        // unsigned block <= 0x1F exactly when max(block, 0x1F) == 0x1F
+        auto const dirty = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, quote), _mm_cmpeq_epi8(block, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(block, control), control));
+        if (auto const mask = _mm_movemask_epi8(dirty); mask != 0) {
+            return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned int>(mask)));
+        }
+    }
+#endif
+    for (; i < text.size(); ++i) {
+        if (needs_escape(text[i])) { return i; }
+    }
+    return text.size();
+}
+
+static void write_escape(char const c, Writer& writer) {
+    switch (c) {
+    case '"':  writer.write("\\\""); break;
+    case '\\': writer.write("\\\\"); break;
+    case '\b': writer.write("\\b");  break;
+    case '\f': writer.write("\\f");  break;
+    case '\n': writer.write("\\n");  break;
+    case '\r': writer.write("\\r");  break;
+    case '\t': writer.write("\\t");  break;
+    default: {
+        constexpr char const* hex = "0123456789abcdef";
+        auto const code = static_cast<unsigned char>(c);
+        char const escape[] = { '\\', 'u', '0', '0', hex[code >> 4], hex[code & 0xF] };
+        writer.write({ escape, sizeof escape });
+        break;
+    }
+    }
+}
+
+static void write_number(Json const& json, Writer& writer) {
+    switch (json.number_kind()) {
+    case Number::Kind::Int:    write_number(Number::from(json.integer()), writer);          break;
+    case Number::Kind::UInt:   write_number(Number::from(json.unsigned_integer()), writer); break;
+    case Number::Kind::Double: write_number(Number::from(json.number()), writer);           break;
+    }
+}
+
+namespace {
+
+class Serializer {
+public:
+
+    Serializer(Writer& writer, SerializeOptions options)
+        : writer_(writer), options_(options), spaces_() { }
+
+    void write_value(Json const& json, std::size_t depth) {
+        switch (json.type()) {
+        case Type::Null:    writer_.write("null");                           break;
+        case Type::Boolean: writer_.write(json.boolean() ? "true" : "false"); break;
+        case Type::Number:  write_number(json, writer_);                     break;
+        case Type::String:  write_string(json.string(), writer_);            break;
+        case Type::Array:   write_array(json.array(), depth);                break;
+        case Type::Object:  write_object(json.object(), depth);              break;
+        }
+    }
+
+private:
+
+    void write_array(Json::array_t const& array, std::size_t depth) {
+        writer_.put('[');
+        for (auto it = array.begin(); it != array.end(); ++it) {
+            if (it != array.begin()) { writer_.put(','); }
+            new_line(depth + 1);
+            write_value(*it, depth + 1);
+            writer_.maybe_flush();
+        }
+        if (not array.empty()) { new_line(depth); }
+        writer_.put(']');
+    }
+
+    void write_object(Json::object_t const& object, std::size_t depth) {
+        writer_.put('{');
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            if (it != object.begin()) { writer_.put(','); }
+            new_line(depth + 1);
+            write_string(it->first, writer_);
+            writer_.put(':');
+            if (options_.indent != 0) { writer_.put(' '); }
+            write_value(it->second, depth + 1);
+            writer_.maybe_flush();
+        }
+        if (not object.empty()) { new_line(depth); }
+        writer_.put('}');
+    }
+
+    void new_line(std::size_t depth) {
+        if (options_.indent == 0) { return; }
+        auto const width = depth * options_.indent;
+        if (spaces_.size() < width) { spaces_.resize(width, ' '); }
+        writer_.put('\n');
+        writer_.write(std::string_view(spaces_).substr(0, width));
+    }
+
+private:
+
+    Writer& writer_;
+    SerializeOptions options_;
+    std::string spaces_;
+};
+
+} // namespace
+
+// Writer member functions
+
+Writer::Writer(std::string& target)
+:
+    buffer_(),
+    target_(&target),
+    sink_()
+{
+}
+
+Writer::Writer(std::FILE* file)
+    : Writer(sink_t([file](std::string_view block) {
+        if (std::fwrite(block.data(), 1, block.size(), file) != block.size()) {
+            throw std::system_error(errno, std::generic_category(), "Cannot write to the file");
+        }
+    })) { }
+
+Writer::Writer(int fd)
+    : Writer(sink_t([fd](std::string_view block) {
+#if JSON_PARSER_HAS_UNISTD
+        while (not block.empty()) {
+            auto const count = ::write(fd, block.data(), block.size());
+            if (count < 0 && errno == EINTR) { continue; }
+            if (count < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot write to the file descriptor");
+            }
+            block.remove_prefix(static_cast<std::size_t>(count));
+        }
+#else
+        static_cast<void>(fd);
+        static_cast<void>(block);
+        throw std::system_error(std::make_error_code(std::errc::not_supported), "File descriptors are not supported");
+#endif
+    })) { }
+
+Writer::Writer(sink_t sink)
+:
+    buffer_(),
+    target_(&buffer_),
+    sink_(std::move(sink))
+{
+    buffer_.reserve(flush_threshold + flush_threshold / 4);
+}
+
+Writer::~Writer() {
+    try {
+        flush();
+    } catch (...) {
+        // a destructor must not throw
+    }
+}
+
+void Writer::flush() {
+    if (not sink_ || buffer_.empty()) { return; }
+    // emptied even when the sink throws, it must not see the same output twice
+    struct ClearOnExit {
+        std::string& buffer;
+        ~ClearOnExit() { buffer.clear(); }
+    } const clear_on_exit{ buffer_ };
+    sink_(buffer_);
+}
+
+// free functions
+
+void write_string(std::string_view text, Writer& writer) {
+    writer.put('"');
+    for (;;) {
+        auto const clean = clean_prefix(text);
+        writer.write(text.substr(0, clean));
+        if (clean == text.size()) { break; }
+        write_escape(text[clean], writer);
+        text.remove_prefix(clean + 1);
+    }
+    writer.put('"');
+}
+
+void write_number(Number const& number, Writer& writer) {
+    char buffer[32];
+    auto* end = buffer;
+    switch (number.kind) {
+    case Number::Kind::Int:  end = std::to_chars(buffer, buffer + sizeof buffer, number.i).ptr; break;
+    case Number::Kind::UInt: end = std::to_chars(buffer, buffer + sizeof buffer, number.u).ptr; break;
+    case Number::Kind::Double: {
+        // JSON has no representation for them, like JSON.stringify
+        if (not std::isfinite(number.d)) {
+            writer.write("null");
+            return;
+        }
+        // the shortest representation that reads back as the same double
+        end = std::to_chars(buffer, buffer + sizeof buffer, number.d).ptr;
+        break;
+    }
+    }
+    writer.write({ buffer, static_cast<std::size_t>(end - buffer) });
+}
+
+void serialize(Json const& json, Writer& writer, SerializeOptions options) {
+    Serializer(writer, options).write_value(json, 0);
+}
+
+auto serialize(Json const& json, SerializeOptions options) -> std::string {
+    auto out = std::string{};
+    {
+        auto writer = Writer(out);
+        serialize(json, writer, options);
+    }
+    return out;
+}
+
+} // namespace json
@@ -0,0 +1,18 @@
+#include "json_parser/detail/SourceLocation.h"
+#include <algorithm>
+
+namespace json {
+
+auto locate(std::string_view source, std::size_t offset) -> SourceLocation {
+    // nothing has been scanned in an empty source
+    if (source.empty()) { return { 0, 0 }; }
+
+    auto const prefix = source.substr(0, offset);
+    auto const line = static_cast<std::size_t>(std::count(prefix.begin(), prefix.end(), '\n')) + 1;
+    auto const last_newline = prefix.rfind('\n');
+    auto const line_start = last_newline == std::string_view::npos ? 0 : last_newline + 1;
+
+    return { line, offset - line_start + 1 };
+}
+
+} // namespace json
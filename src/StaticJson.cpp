@@ -0,0 +1,62 @@
+#include "json_parser/StaticJson.h"
+#include "json_parser/JsonException.h"
+#include <stdexcept>
+#include <string>
+
+namespace json {
+
+// StaticValue member functions
+
+auto StaticValue::to_json() const -> Json {
+    switch (type()) {
+    case Type::Null:    return Json();
+    case Type::Boolean: return Json(boolean());
+    case Type::Number: {
+        switch (number_kind()) {
+        case Number::Kind::Int:    return Json(node().integer);
+        case Number::Kind::UInt:   return Json(node().unsigned_integer);
+        case Number::Kind::Double: return Json(node().number);
+        }
+        return Json(node().number);
+    }
+    case Type::String: return Json(string());
+    case Type::Array: {
+        auto json = Json(Type::Array);
+        auto& array = json.array();
+        array.reserve(size());
+        for (auto index = index_ + 1; index != node().end; index = nodes_[index].end) {
+            array.push_back(StaticValue(nodes_, index, source_, strings_).to_json());
+        }
+        return json;
+    }
+    case Type::Object: {
+        auto json = Json(Type::Object);
+        auto& object = json.object();
+        for (auto index = index_ + 1; index != node().end; index = nodes_[index].end) {
+            object[view(nodes_[index].key)] = StaticValue(nodes_, index, source_, strings_).to_json();
+        }
+        return json;
+    }
+    }
+    return Json();
+}
+
+// free functions
+
+void detail::invalid_json_literal(char const* message, std::size_t offset) {
+    throw JsonException("Invalid JSON literal at offset " + std::to_string(offset) + ": " + message);
+}
+
+void detail::invalid_static_cast(Type from, Type to) {
+    throw JsonException(std::string("Invalid cast from ") + to_string(from) + " to " + to_string(to));
+}
+
+void detail::invalid_static_number(char const* message) {
+    throw JsonException(std::string("Number ") + message);
+}
+
+void detail::static_value_out_of_range(char const* message) {
+    throw std::out_of_range(message);
+}
+
+} // namespace json
@@ -0,0 +1,263 @@
+#include "json_parser/detail/StructuralIndexer.h"
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_PARSER_X86_DISPATCH 1
+#include <immintrin.h>
+#else
+#define JSON_PARSER_X86_DISPATCH 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace json {
+
+using BlockMasks = StructuralIndexer::BlockMasks;
+
+// helpers
+
+inline static auto trailing_zeros(std::uint64_t value) -> unsigned {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+// bit i of the result is the xor of bits [0, i] of value, which turns
+// the quote mask into an "inside of a string" mask
+inline static auto prefix_xor(std::uint64_t value) -> std::uint64_t {
+    value ^= value << 1;
+    value ^= value << 2;
+    value ^= value << 4;
+    value ^= value << 8;
+    value ^= value << 16;
+    value ^= value << 32;
+    return value;
+}
+
+// every backslash not itself escaped escapes the following byte.
+// Backslashes are rare enough that walking them one by one is cheap
+static auto find_escaped(std::uint64_t backslash, bool& prev_escaped) -> std::uint64_t {
+    std::uint64_t escaped = prev_escaped ? 1 : 0;
+    backslash &= ~escaped;
+    prev_escaped = false;
+    while (backslash != 0) {
+        auto const i = trailing_zeros(backslash);
+        if (i == 63) {
+            prev_escaped = true;
+            break;
+        }
+        escaped |= std::uint64_t{1} << (i + 1);
+        backslash &= ~(std::uint64_t{3} << i);
+    }
+    return escaped;
+}
+
+// classifiers
+
+static auto classify_scalar(char const* block) -> BlockMasks {
+    BlockMasks masks{};
+    for (std::size_t i = 0; i < StructuralIndexer::block_size; ++i) {
+        auto const bit = std::uint64_t{1} << i;
+        switch (block[i]) {
+        case '"':  masks.quote      |= bit; break;
+        case '\\': masks.backslash  |= bit; break;
+        case ' ': case '\n': case '\r': case '\t':
+                   masks.whitespace |= bit; break;
+        case '{': case '}': case '[': case ']': case ':': case ',':
+                   masks.op         |= bit; break;
+        default: break;
+        }
+    }
+    return masks;
+}
+
+#if JSON_PARSER_X86_DISPATCH
+
+// Nibble lookup tables: lo[c & 0xF] & hi[c >> 4] has one of the bits 0x07 set
+// for "{}[]:," and one of the bits 0x18 set for whitespace, zero otherwise.
+// pshufb zeroes bytes with the high bit set, so non-ASCII bytes classify as 0
+#define JSON_PARSER_LO_NIBBLES 16, 0, 0, 0, 0, 0, 0, 0, 0, 8, 12, 1, 2, 9, 0, 0
+#define JSON_PARSER_HI_NIBBLES  8, 0, 18, 4, 0, 1, 0, 1, 0, 0, 0, 3, 2, 1, 0, 0
+
+// lambdas do not inherit the target attribute, hence the named helpers
+__attribute__((target("sse4.2")))
+inline static auto bits(__m128i v) -> std::uint64_t {
+    return static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(v)));
+}
+
+__attribute__((target("avx2")))
+inline static auto bits(__m256i v) -> std::uint64_t {
+    return static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(v)));
+}
+
+__attribute__((target("sse4.2")))
+static auto classify_sse42(char const* block) -> BlockMasks {
+    auto const lo_table = _mm_setr_epi8(JSON_PARSER_LO_NIBBLES);
+    auto const hi_table = _mm_setr_epi8(JSON_PARSER_HI_NIBBLES);
+    auto const low_nibble = _mm_set1_epi8(0x0F);
+    auto const zero = _mm_setzero_si128();
+
+    BlockMasks masks{};
+    for (unsigned i = 0; i < 4; ++i) {
+        auto const in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(block + 16 * i));
+        auto const lo = _mm_shuffle_epi8(lo_table, in);
+        auto const hi = _mm_shuffle_epi8(hi_table, _mm_and_si128(_mm_srli_epi16(in, 4), low_nibble));
+        auto const cls = _mm_and_si128(lo, hi);
+
+        auto const op = _mm_cmpeq_epi8(_mm_and_si128(cls, _mm_set1_epi8(0x07)), zero);
+        auto const ws = _mm_cmpeq_epi8(_mm_and_si128(cls, _mm_set1_epi8(0x18)), zero);
+
+        masks.op         |= (~bits(op) & 0xFFFF) << (16 * i);
+        masks.whitespace |= (~bits(ws) & 0xFFFF) << (16 * i);
+        masks.quote      |= bits(_mm_cmpeq_epi8(in, _mm_set1_epi8('"')))  << (16 * i);
+        masks.backslash  |= bits(_mm_cmpeq_epi8(in, _mm_set1_epi8('\\'))) << (16 * i);
+    }
+    return masks;
+}
+
+__attribute__((target("avx2")))
+static auto classify_avx2(char const* block) -> BlockMasks {
+    // vpshufb looks up within each 128-bit lane, so the tables are duplicated
+    auto const lo_table = _mm256_setr_epi8(JSON_PARSER_LO_NIBBLES, JSON_PARSER_LO_NIBBLES);
+    auto const hi_table = _mm256_setr_epi8(JSON_PARSER_HI_NIBBLES, JSON_PARSER_HI_NIBBLES);
+    auto const low_nibble = _mm256_set1_epi8(0x0F);
+    auto const zero = _mm256_setzero_si256();
+
+    BlockMasks masks{};
+    for (unsigned i = 0; i < 2; ++i) {
+        auto const in = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(block + 32 * i));
+        auto const lo = _mm256_shuffle_epi8(lo_table, in);
+        auto const hi = _mm256_shuffle_epi8(hi_table, _mm256_and_si256(_mm256_srli_epi16(in, 4), low_nibble));
+        auto const cls = _mm256_and_si256(lo, hi);
+
+        auto const op = _mm256_cmpeq_epi8(_mm256_and_si256(cls, _mm256_set1_epi8(0x07)), zero);
+        auto const ws = _mm256_cmpeq_epi8(_mm256_and_si256(cls, _mm256_set1_epi8(0x18)), zero);
+
+        masks.op         |= (~bits(op) & 0xFFFFFFFF) << (32 * i);
+        masks.whitespace |= (~bits(ws) & 0xFFFFFFFF) << (32 * i);
+        masks.quote      |= bits(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('"')))  << (32 * i);
+        masks.backslash  |= bits(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('\\'))) << (32 * i);
+    }
+    return masks;
+}
+
+#undef JSON_PARSER_LO_NIBBLES
+#undef JSON_PARSER_HI_NIBBLES
+
+#endif // JSON_PARSER_X86_DISPATCH
+
+static auto classifier_of(InstructionSet set) -> StructuralIndexer::classifier_t {
+    switch (set) {
+#if JSON_PARSER_X86_DISPATCH
+    case InstructionSet::Avx2:   return classify_avx2;
+    case InstructionSet::Sse42:  return classify_sse42;
+#else
+    case InstructionSet::Avx2:
+    case InstructionSet::Sse42:
+#endif
+    case InstructionSet::Scalar: return classify_scalar;
+    }
+    return classify_scalar;
+}
+
+// free functions
+
+auto is_supported(InstructionSet set) noexcept -> bool {
+    switch (set) {
+    case InstructionSet::Scalar: return true;
+#if JSON_PARSER_X86_DISPATCH
+    case InstructionSet::Sse42:  return __builtin_cpu_supports("sse4.2");
+    case InstructionSet::Avx2:   return __builtin_cpu_supports("avx2");
+#else
+    case InstructionSet::Sse42:
+    case InstructionSet::Avx2:   return false;
+#endif
+    }
+    return false;
+}
+
+auto best_instruction_set() noexcept -> InstructionSet {
+    static auto const best =
+        is_supported(InstructionSet::Avx2)  ? InstructionSet::Avx2  :
+        is_supported(InstructionSet::Sse42) ? InstructionSet::Sse42 :
+                                              InstructionSet::Scalar;
+    return best;
+}
+
+auto to_string(InstructionSet set) noexcept -> char const* {
+    switch (set) {
+    case InstructionSet::Scalar: return "scalar";
+    case InstructionSet::Sse42:  return "sse4.2";
+    case InstructionSet::Avx2:   return "avx2";
+    }
+    return "";
+}
+
+// StructuralIndexer member functions
+
+StructuralIndexer::StructuralIndexer(std::string_view source, InstructionSet set)
+:
+    source_(source),
+    classify_(classifier_of(is_supported(set) ? set : InstructionSet::Scalar)),
+    block_start_(0),
+    next_block_(0),
+    structurals_(0),
+    prev_escaped_(false),
+    prev_in_string_(0),
+    prev_scalar_(0)
+{
+}
+
+auto StructuralIndexer::next() -> std::size_t {
+    while (structurals_ == 0) {
+        if (next_block_ >= source_.size()) { return source_.size(); }
+        index_next_block();
+    }
+    auto const position = block_start_ + trailing_zeros(structurals_);
+    structurals_ &= structurals_ - 1;
+    return position;
+}
+
+auto StructuralIndexer::next_from(std::size_t from) -> std::size_t {
+    auto position = next();
+    while (position < from) {
+        position = next();
+    }
+    return position;
+}
+
+void StructuralIndexer::index_next_block() {
+    auto const remaining = source_.size() - next_block_;
+    BlockMasks masks{};
+    if (remaining >= block_size) {
+        masks = classify_(source_.data() + next_block_);
+    } else {
+        // pad the tail with whitespace, which never becomes structural
+        char block[block_size];
+        std::memset(block, ' ', block_size);
+        std::memcpy(block, source_.data() + next_block_, remaining);
+        masks = classify_(block);
+    }
+
+    auto const escaped   = find_escaped(masks.backslash, prev_escaped_);
+    auto const quote     = masks.quote & ~escaped;
+    // includes the opening quote, excludes the closing one
+    auto const in_string = prefix_xor(quote) ^ prev_in_string_;
+    auto const scalar    = ~(masks.op | masks.whitespace | quote | in_string);
+    auto const scalar_starts = scalar & ~((scalar << 1) | prev_scalar_);
+
+    prev_in_string_ = (in_string >> 63) != 0 ? ~std::uint64_t{0} : 0;
+    prev_scalar_    = scalar >> 63;
+
+    structurals_ = (masks.op & ~in_string) | (quote & in_string) | scalar_starts;
+    block_start_ = next_block_;
+    next_block_ += block_size;
+}
+
+} // namespace json
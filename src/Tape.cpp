@@ -0,0 +1,529 @@
+#include "json_parser/Tape.h"
+#include "json_parser/detail/MappedFile.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace json {
+
+// The bytes of an encoded tape, kept alive by `owner`
+struct TapeStorage {
+    std::shared_ptr<void const> owner;
+    char const* tape;
+    std::size_t words;
+    char const* pool;
+    std::size_t pool_size;
+};
+
+// helpers
+
+namespace {
+
+constexpr char tape_magic[8] = { 'J', 'S', 'O', 'N', 'T', 'A', 'P', 'E' };
+constexpr std::uint32_t tape_version = 2;
+// reads back as another value on a machine of the other byte order
+constexpr std::uint32_t tape_byte_order = 0x01020304;
+
+struct TapeHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t words;
+    std::uint64_t pool_size;
+};
+static_assert(sizeof(TapeHeader) == 32, "the tape must start 8 bytes aligned");
+
+constexpr int type_shift = 56;
+constexpr std::uint64_t payload_mask = (std::uint64_t{1} << type_shift) - 1;
+
+constexpr auto make_tag(Type type, std::uint64_t payload = 0) -> std::uint64_t {
+    return std::uint64_t{static_cast<std::uint8_t>(type)} << type_shift | payload;
+}
+
+// Json to tape, depth first so every node is followed by its children
+class TapeEncoder {
+public:
+
+    // strings up to this size are stored once, longer ones are rarely repeated
+    static constexpr std::size_t shared_string_size = 64;
+
+    void encode(Json const& json) {
+        switch (json.type()) {
+        case Type::Null:    tape_.push_back(make_tag(Type::Null)); break;
+        case Type::Boolean: tape_.push_back(make_tag(Type::Boolean, json.boolean() ? 1 : 0)); break;
+        case Type::Number: {
+            auto const kind = json.number_kind();
+            auto bits = std::uint64_t{};
+            switch (kind) {
+            case Number::Kind::Int:  bits = static_cast<std::uint64_t>(json.integer()); break;
+            case Number::Kind::UInt: bits = json.unsigned_integer();                      break;
+            case Number::Kind::Double: {
+                auto const number = json.number();
+                std::memcpy(&bits, &number, sizeof bits);
+                break;
+            }
+            }
+            tape_.push_back(make_tag(Type::Number, static_cast<std::uint8_t>(kind)));
+            tape_.push_back(bits);
+            break;
+        }
+        case Type::String: string(json.string()); break;
+        case Type::Array: {
+            auto const& array = json.array();
+            tape_.push_back(make_tag(Type::Array, array.size()));
+            auto const table = tape_.size();
+            tape_.resize(table + array.size());
+            for (std::size_t i = 0; i < array.size(); ++i) {
+                tape_[table + i] = tape_.size();
+                encode(array[i]);
+            }
+            break;
+        }
+        case Type::Object: {
+            auto const& object = json.object();
+            auto const sorted = object.size() > JsonObject::index_threshold;
+            tape_.push_back(make_tag(Type::Object, object.size()));
+            auto const table = tape_.size();
+            tape_.resize(table + (sorted ? 2 : 1) * object.size());
+
+            auto keys = std::vector<std::pair<std::string_view, std::uint64_t>>{};
+            std::size_t i = 0;
+            for (auto const& [key, value] : object) {
+                if (sorted) { keys.emplace_back(key, i); }
+                tape_[table + i++] = tape_.size();
+                string(key);
+                encode(value);
+            }
+            if (sorted) {
+                std::sort(keys.begin(), keys.end());
+                for (std::size_t k = 0; k < keys.size(); ++k) {
+                    tape_[table + object.size() + k] = keys[k].second;
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    [[nodiscard]] auto header() const -> TapeHeader {
+        auto header = TapeHeader{};
+        std::memcpy(header.magic, tape_magic, sizeof tape_magic);
+        header.version = tape_version;
+        header.byte_order = tape_byte_order;
+        header.words = tape_.size();
+        header.pool_size = pool_.size();
+        return header;
+    }
+
+    [[nodiscard]] auto tape() const noexcept -> std::string_view {
+        return { reinterpret_cast<char const*>(tape_.data()), tape_.size() * sizeof(std::uint64_t) };
+    }
+
+    [[nodiscard]] auto pool() const noexcept -> std::string_view {
+        return pool_;
+    }
+
+private:
+
+    void string(std::string_view text) {
+        tape_.push_back(make_tag(Type::String, text.size()));
+        if (text.size() > shared_string_size) {
+            tape_.push_back(append(text));
+            return;
+        }
+        // the views point into the Json being encoded, which outlives the encoder
+        auto const [it, inserted] = shared_.try_emplace(text, 0);
+        if (inserted) { it->second = append(text); }
+        tape_.push_back(it->second);
+    }
+
+    auto append(std::string_view text) -> std::uint64_t {
+        auto const offset = pool_.size();
+        pool_.append(text);
+        return offset;
+    }
+
+private:
+
+    std::vector<std::uint64_t> tape_;
+    std::string pool_;
+    std::unordered_map<std::string_view, std::uint64_t> shared_;
+};
+
+[[noreturn]] void corrupt_tape(std::string const& message) {
+    throw JsonException("Invalid tape: " + message);
+}
+
+// checks the header and locates the tape and the pool in `bytes`
+auto open_storage(std::string_view bytes, std::shared_ptr<void const> owner) -> std::shared_ptr<TapeStorage const> {
+    auto header = TapeHeader{};
+    if (bytes.size() < sizeof header) { corrupt_tape("too short for a header"); }
+    std::memcpy(&header, bytes.data(), sizeof header);
+
+    if (std::memcmp(header.magic, tape_magic, sizeof tape_magic) != 0) { corrupt_tape("bad magic"); }
+    if (header.version != tape_version) { corrupt_tape("unsupported version " + std::to_string(header.version)); }
+    if (header.byte_order != tape_byte_order) { corrupt_tape("written with another byte order"); }
+
+    auto const available = bytes.size() - sizeof header;
+    if (header.words == 0 || header.words > available / sizeof(std::uint64_t)
+        || header.pool_size != available - header.words * sizeof(std::uint64_t)) {
+        corrupt_tape("sizes do not match the data");
+    }
+
+    auto const* const tape = bytes.data() + sizeof header;
+    auto const words = header.words;
+    return std::make_shared<TapeStorage const>(TapeStorage{
+        std::move(owner), tape, words, tape + words * sizeof(std::uint64_t), header.pool_size
+    });
+}
+
+// Every read is bounds checked, a damaged tape throws instead of reading past
+// it. Child tables are checked too, see child_at, so walking a tape ends
+auto word(TapeStorage const* storage, std::size_t index) -> std::uint64_t {
+    if (index >= storage->words) { corrupt_tape("node out of bounds"); }
+    auto word = std::uint64_t{};
+    std::memcpy(&word, storage->tape + index * sizeof word, sizeof word);
+    return word;
+}
+
+// The child at `position` in the table of the node at `index` with `size`
+// children. The encoder writes children after their parent's table, a child
+// pointing back would make a damaged tape a cycle
+auto child_at(TapeStorage const* storage, std::size_t index, std::size_t size, std::size_t position) -> std::size_t {
+    auto const child = word(storage, index + 1 + position);
+    if (child <= index + size) { corrupt_tape("child before its parent"); }
+    return child;
+}
+
+auto string_at(TapeStorage const* storage, std::size_t index) -> std::string_view {
+    auto const length = word(storage, index) & payload_mask;
+    auto const offset = word(storage, index + 1);
+    if (offset > storage->pool_size || length > storage->pool_size - offset) { corrupt_tape("string out of bounds"); }
+    return { storage->pool + offset, length };
+}
+
+auto cast_exception(Type from, Type to) -> JsonException {
+    std::stringstream ss;
+    ss << "Invalid cast from " << to_string(from) << " to " << to_string(to);
+    return JsonException(ss.str());
+}
+
+} // namespace
+
+// TapeValue member functions
+
+TapeValue::TapeValue(TapeStorage const* storage, std::size_t index) noexcept
+    : storage_(storage), index_(index) { }
+
+auto TapeValue::tag() const -> std::uint64_t {
+    return word(storage_, index_);
+}
+
+auto TapeValue::type() const -> Type {
+    auto const type = tag() >> type_shift;
+    if (type > static_cast<std::uint64_t>(Type::Object)) { corrupt_tape("unknown node type"); }
+    return static_cast<Type>(type);
+}
+
+auto TapeValue::is_null() const -> bool {
+    return type() == Type::Null;
+}
+auto TapeValue::is_bool() const -> bool {
+    return type() == Type::Boolean;
+}
+auto TapeValue::is_number() const -> bool {
+    return type() == Type::Number;
+}
+auto TapeValue::is_string() const -> bool {
+    return type() == Type::String;
+}
+auto TapeValue::is_array() const -> bool {
+    return type() == Type::Array;
+}
+auto TapeValue::is_object() const -> bool {
+    return type() == Type::Object;
+}
+
+void TapeValue::expect(Type expected) const {
+    auto const actual = type();
+    if (actual != expected) { throw cast_exception(actual, expected); }
+}
+
+auto TapeValue::boolean() const -> bool {
+    expect(Type::Boolean);
+    return (tag() & payload_mask) != 0;
+}
+
+auto TapeValue::number() const -> double {
+    return as_number().to_double();
+}
+
+auto TapeValue::is_integer() const -> bool {
+    return is_number() && as_number().kind != Number::Kind::Double;
+}
+
+auto TapeValue::number_kind() const -> Number::Kind {
+    return as_number().kind;
+}
+
+auto TapeValue::integer() const -> std::int64_t {
+    auto value = std::int64_t{};
+    if (not as_number().to_int64(value)) {
+        throw JsonException("Number " + to_json().to_string() + " does not fit in a 64-bit integer");
+    }
+    return value;
+}
+
+auto TapeValue::unsigned_integer() const -> std::uint64_t {
+    auto value = std::uint64_t{};
+    if (not as_number().to_uint64(value)) {
+        throw JsonException("Number " + to_json().to_string() + " does not fit in a 64-bit unsigned integer");
+    }
+    return value;
+}
+
+auto TapeValue::as_number() const -> Number {
+    expect(Type::Number);
+    auto const bits = word(storage_, index_ + 1);
+    switch (tag() & payload_mask) {
+    case static_cast<std::uint8_t>(Number::Kind::Int):  return Number::from(static_cast<std::int64_t>(bits));
+    case static_cast<std::uint8_t>(Number::Kind::UInt): return Number::from(bits);
+    case static_cast<std::uint8_t>(Number::Kind::Double): {
+        auto number = 0.0;
+        std::memcpy(&number, &bits, sizeof number);
+        return Number::from(number);
+    }
+    default: corrupt_tape("unknown number kind");
+    }
+}
+
+auto TapeValue::string() const -> std::string_view {
+    expect(Type::String);
+    return string_at(storage_, index_);
+}
+
+auto TapeValue::array() const -> TapeArray {
+    expect(Type::Array);
+    return { storage_, index_, tag() & payload_mask };
+}
+
+auto TapeValue::object() const -> TapeObject {
+    expect(Type::Object);
+    return { storage_, index_, tag() & payload_mask };
+}
+
+auto TapeValue::to_json() const -> Json {
+    switch (type()) {
+    case Type::Null:    return Json{};
+    case Type::Boolean: return Json(boolean());
+    case Type::Number: {
+        auto const number = as_number();
+        switch (number.kind) {
+        case Number::Kind::Int:    return Json(number.i);
+        case Number::Kind::UInt:   return Json(number.u);
+        case Number::Kind::Double: return Json(number.d);
+        }
+        return Json{};
+    }
+    case Type::String:  return Json(string());
+    case Type::Array: {
+        auto const elements = array();
+        auto result = Json::array_t{};
+        result.reserve(elements.size());
+        for (auto const element : elements) {
+            result.push_back(element.to_json());
+        }
+        return Json(std::move(result));
+    }
+    case Type::Object: {
+        auto const members = object();
+        auto result = Json::object_t{};
+        result.reserve(members.size());
+        for (auto const [key, value] : members) {
+            result.try_emplace(Json::object_t::key_type(key), value.to_json());
+        }
+        return Json(std::move(result));
+    }
+    }
+    return Json{};
+}
+
+// TapeArray member functions
+
+TapeArray::TapeArray(TapeStorage const* storage, std::size_t index, std::size_t size) noexcept
+    : storage_(storage), index_(index), size_(size) { }
+
+auto TapeArray::size() const noexcept -> std::size_t {
+    return size_;
+}
+
+auto TapeArray::empty() const noexcept -> bool {
+    return size_ == 0;
+}
+
+auto TapeArray::operator[](std::size_t index) const -> TapeValue {
+    return value_at(index);
+}
+
+auto TapeArray::at(std::size_t index) const -> TapeValue {
+    if (index >= size_) {
+        throw std::out_of_range("Index " + std::to_string(index) + " is out of range");
+    }
+    return value_at(index);
+}
+
+auto TapeArray::begin() const noexcept -> const_iterator {
+    return { *this, 0 };
+}
+
+auto TapeArray::end() const noexcept -> const_iterator {
+    return { *this, size_ };
+}
+
+auto TapeArray::value_at(std::size_t position) const -> TapeValue {
+    return { storage_, child_at(storage_, index_, size_, position) };
+}
+
+// TapeObject member functions
+
+TapeObject::TapeObject(TapeStorage const* storage, std::size_t index, std::size_t size) noexcept
+    : storage_(storage), index_(index), size_(size) { }
+
+auto TapeObject::size() const noexcept -> std::size_t {
+    return size_;
+}
+
+auto TapeObject::empty() const noexcept -> bool {
+    return size_ == 0;
+}
+
+auto TapeObject::begin() const noexcept -> const_iterator {
+    return { *this, 0 };
+}
+
+auto TapeObject::end() const noexcept -> const_iterator {
+    return { *this, size_ };
+}
+
+auto TapeObject::find(std::string_view key) const -> const_iterator {
+    return { *this, find_position(key) };
+}
+
+auto TapeObject::count(std::string_view key) const -> std::size_t {
+    return find_position(key) == size_ ? 0 : 1;
+}
+
+auto TapeObject::at(std::string_view key) const -> TapeValue {
+    auto const position = find_position(key);
+    if (position == size_) {
+        throw std::out_of_range("Key \"" + std::string(key) + "\" does not exist");
+    }
+    return value_at(position).second;
+}
+
+auto TapeObject::value_at(std::size_t position) const -> value_type {
+    auto const member = child_at(storage_, index_, size_, position);
+    return { string_at(storage_, member), TapeValue(storage_, member + 2) };
+}
+
+auto TapeObject::key_at(std::size_t member) const -> std::string_view {
+    return string_at(storage_, member);
+}
+
+auto TapeObject::find_position(std::string_view key) const -> std::size_t {
+    if (size_ <= JsonObject::index_threshold) {
+        for (std::size_t i = 0; i < size_; ++i) {
+            if (value_at(i).first == key) { return i; }
+        }
+        return size_;
+    }
+
+    // binary search of the insertion positions sorted by key
+    auto const sorted = index_ + 1 + size_;
+    auto const position_at = [this, sorted](std::size_t rank) -> std::size_t {
+        auto const position = word(storage_, sorted + rank);
+        if (position >= size_) { corrupt_tape("member out of bounds"); }
+        return position;
+    };
+    std::size_t low = 0;
+    std::size_t high = size_;
+    while (low < high) {
+        auto const middle = low + (high - low) / 2;
+        if (value_at(position_at(middle)).first < key) { low = middle + 1; }
+        else                                            { high = middle; }
+    }
+    if (low == size_) { return size_; }
+
+    auto const position = position_at(low);
+    return value_at(position).first == key ? position : size_;
+}
+
+// TapeDocument member functions
+
+TapeDocument::TapeDocument(std::string tape)
+    : storage_() {
+    auto owned = std::make_shared<std::string const>(std::move(tape));
+    auto const bytes = std::string_view(*owned);
+    storage_ = open_storage(bytes, std::move(owned));
+}
+
+TapeDocument::TapeDocument(std::shared_ptr<TapeStorage const> storage) noexcept
+    : storage_(std::move(storage)) { }
+
+auto TapeDocument::root() const -> TapeValue {
+    return { storage_.get(), 0 };
+}
+
+auto TapeDocument::size_bytes() const noexcept -> std::size_t {
+    return sizeof(TapeHeader) + storage_->words * sizeof(std::uint64_t) + storage_->pool_size;
+}
+
+// free functions
+
+auto encode_tape(Json const& json) -> std::string {
+    auto encoder = TapeEncoder{};
+    encoder.encode(json);
+
+    auto const header = encoder.header();
+    auto out = std::string{};
+    out.reserve(sizeof header + encoder.tape().size() + encoder.pool().size());
+    out.append(reinterpret_cast<char const*>(&header), sizeof header);
+    out.append(encoder.tape());
+    out.append(encoder.pool());
+    return out;
+}
+
+void save_tape(Json const& json, std::string const& path) {
+    auto encoder = TapeEncoder{};
+    encoder.encode(json);
+    auto const header = encoder.header();
+
+    auto* const file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::system_error(errno, std::generic_category(), "Cannot open \"" + path + "\"");
+    }
+    auto const write = [file](void const* data, std::size_t size) {
+        return std::fwrite(data, 1, size, file) == size;
+    };
+    auto const written = write(&header, sizeof header)
+                     && write(encoder.tape().data(), encoder.tape().size())
+                     && write(encoder.pool().data(), encoder.pool().size());
+    auto const error = errno;
+    if (std::fclose(file) != 0 || not written) {
+        throw std::system_error(written ? errno : error, std::generic_category(), "Cannot write \"" + path + "\"");
+    }
+}
+
+auto load_tape(std::string const& path) -> TapeDocument {
+    auto file = std::make_shared<MappedFile const>(path, MappedFile::Access::Random);
+    auto const bytes = file->contents();
+    return TapeDocument(open_storage(bytes, std::move(file)));
+}
+
+} // namespace json
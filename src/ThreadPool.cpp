@@ -0,0 +1,60 @@
+#include "json_parser/detail/ThreadPool.h"
+#include <algorithm>
+
+namespace json {
+
+ThreadPool::ThreadPool(std::size_t threads)
+:
+    mutex_(),
+    ready_(),
+    tasks_(),
+    stopping_(false),
+    workers_()
+{
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this] { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        auto const lock = std::lock_guard(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        auto const lock = std::lock_guard(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+}
+
+auto ThreadPool::size() const noexcept -> std::size_t {
+    return workers_.size();
+}
+
+void ThreadPool::work() {
+    for (;;) {
+        auto task = std::function<void()>{};
+        {
+            auto lock = std::unique_lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || not tasks_.empty(); });
+            if (tasks_.empty()) { return; }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace json
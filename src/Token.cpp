@@ -4,19 +4,23 @@
 
 namespace json {
 
-Token::Token(int _line, int _column, TokenType _type, literal_t _literal)
+Token::Token(std::size_t _offset, TokenType _type, literal_t _literal)
 :
-    line(_line),
-    column(_column),
+    offset(_offset),
     type(_type),
     literal(std::move(_literal))
 {
 }
 
-auto Token::to_string() const -> std::string {
+auto Token::to_string(std::string_view source) const -> std::string {
+    return to_string(locate(source, offset));
+}
+
+auto Token::to_string(SourceLocation location) const -> std::string {
     using TT = TokenType;
     using namespace std;
 
+    auto const [line, column] = location;
     std::stringstream ss;
     ss << '[' << line << ':' << column << "]";
     switch (type) {
@@ -30,8 +34,18 @@ auto Token::to_string() const -> std::string {
     case TT::LeftBracket:  ss << "[LeftBracket: "  << quoted("[");     break;
     case TT::RightBracket: ss << "[RightBracket: " << quoted("]");     break;
     case TT::Eof:          ss << "[Eof: EOF";                          break;
-    case TT::String:       ss << "[String: " << quoted(get<string>(literal)); break;
-    case TT::Number:       ss << "[Number: " << get<double>(literal);         break;
+    case TT::Error:        ss << "[Error: ERROR";                      break;
+    case TT::String:       ss << "[String: " << quoted(get<string_view>(literal)); break;
+    case TT::Number: {
+        auto const& number = get<Number>(literal);
+        ss << "[Number: ";
+        switch (number.kind) {
+        case Number::Kind::Int:    ss << number.i; break;
+        case Number::Kind::UInt:   ss << number.u; break;
+        case Number::Kind::Double: ss << number.d; break;
+        }
+        break;
+    }
     }
     ss << ']';
     return ss.str();
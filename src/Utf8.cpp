@@ -0,0 +1,107 @@
+#include "json_parser/detail/Utf8.h"
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define JSON_PARSER_X86_DISPATCH 1
+#include <immintrin.h>
+#else
+#define JSON_PARSER_X86_DISPATCH 0
+#endif
+
+namespace json {
+
+// helpers
+
+static constexpr std::uint64_t high_bits = 0x8080808080808080u;
+static constexpr std::uint64_t low_bits  = 0x0101010101010101u;
+
+inline static auto load_word(char const* p) -> std::uint64_t {
+    auto word = std::uint64_t{};
+    std::memcpy(&word, p, sizeof word);
+    return word;
+}
+
+// position of the first non-ASCII byte at or after `i`, 8 bytes at a time
+static auto skip_ascii_scalar(std::string_view text, std::size_t i) -> std::size_t {
+    for (; i + 8 <= text.size(); i += 8) {
+        if ((load_word(text.data() + i) & high_bits) != 0) { break; }
+    }
+    while (i < text.size() && static_cast<unsigned char>(text[i]) < 0x80) { ++i; }
+    return i;
+}
+
+#if JSON_PARSER_X86_DISPATCH
+
+__attribute__((target("sse4.2")))
+static auto skip_ascii_sse42(std::string_view text, std::size_t i) -> std::size_t {
+    for (; i + 16 <= text.size(); i += 16) {
+        auto const in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(text.data() + i));
+        if (_mm_movemask_epi8(in) != 0) { break; }
+    }
+    return skip_ascii_scalar(text, i);
+}
+
+__attribute__((target("avx2")))
+static auto skip_ascii_avx2(std::string_view text, std::size_t i) -> std::size_t {
+    for (; i + 32 <= text.size(); i += 32) {
+        auto const in = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(text.data() + i));
+        if (_mm256_movemask_epi8(in) != 0) { break; }
+    }
+    return skip_ascii_scalar(text, i);
+}
+
+#endif // JSON_PARSER_X86_DISPATCH
+
+using skip_ascii_t = auto (*)(std::string_view text, std::size_t i) -> std::size_t;
+
+static auto skip_ascii_of(InstructionSet set) -> skip_ascii_t {
+    switch (set) {
+#if JSON_PARSER_X86_DISPATCH
+    case InstructionSet::Avx2:   return skip_ascii_avx2;
+    case InstructionSet::Sse42:  return skip_ascii_sse42;
+#else
+    case InstructionSet::Avx2:
+    case InstructionSet::Sse42:
+#endif
+    case InstructionSet::Scalar: return skip_ascii_scalar;
+    }
+    return skip_ascii_scalar;
+}
+
+// free functions
+
+auto find_invalid_utf8(std::string_view text, InstructionSet set) noexcept -> std::size_t {
+    auto const skip_ascii = skip_ascii_of(is_supported(set) ? set : InstructionSet::Scalar);
+    auto i = skip_ascii(text, 0);
+    while (i < text.size()) {
+        auto const length = utf8_sequence_length(text, i);
+        if (length == 0) { return i; }
+        i += length;
+        // text is usually ASCII again right after a sequence, check before a vector load
+        if (i < text.size() && static_cast<unsigned char>(text[i]) < 0x80) { i = skip_ascii(text, i); }
+    }
+    return std::string_view::npos;
+}
+
+auto find_quote_or_backslash(std::string_view text, std::size_t from) noexcept -> std::size_t {
+    // a byte of a word is zero exactly when (b - 1) & ~b has its high bit set
+    constexpr auto quotes     = low_bits * static_cast<unsigned char>('"');
+    constexpr auto backslashes = low_bits * static_cast<unsigned char>('\\');
+    auto const has_zero = [](std::uint64_t v) { return (v - low_bits) & ~v & high_bits; };
+
+    auto i = from;
+    for (; i + 8 <= text.size(); i += 8) {
+        auto const word = load_word(text.data() + i);
+        if ((has_zero(word ^ quotes) | has_zero(word ^ backslashes)) != 0) { break; }
+    }
+    while (i < text.size() && text[i] != '"' && text[i] != '\\') { ++i; }
+    return i;
+}
+
+void append_utf8(std::string& out, char32_t code_point) {
+    char bytes[4] = {};
+    out.append(bytes, encode_utf8(code_point, bytes));
+}
+
+} // namespace json
@@ -1,11 +1,69 @@
 #include "json_parser/core.h"
-#include "json_parser/detail/Scanner.h"
-#include "json_parser/detail/Parser.h"
+#include "json_parser/detail/DomBuilder.h"
+#include "json_parser/detail/MappedFile.h"
+#include <algorithm>
+#include <memory>
 
 namespace json {
 
+// helpers
+
+// an arena of about `expected` bytes, which monotonic_buffer_resource needs
+// to be non-zero even for an empty source
+static auto make_arena(std::size_t expected) -> std::unique_ptr<Document::arena_t> {
+    return std::make_unique<Document::arena_t>(std::max<std::size_t>(expected, 1));
+}
+
+// free functions
+
 auto parse_string(std::string const& source) -> Json {
-    return Parser(Scanner(source).scan()).parse();
+    return build_dom(source, std::pmr::get_default_resource());
+}
+
+auto try_parse(std::string_view source) noexcept -> ParseResult<Json> {
+    return try_build_dom(source, std::pmr::get_default_resource());
+}
+
+auto parse_document(std::string const& source) -> Document {
+    // the tree is usually about as large as the source, start from there
+    auto arena = make_arena(source.size());
+    auto root = build_dom(source, arena.get());
+    return Document(std::move(arena), std::move(root));
+}
+
+auto parse_string(std::string const& source, KeyDictionary& keys) -> Json {
+    return build_dom(source, std::pmr::get_default_resource(), StringMode::Copy, &keys);
+}
+
+auto parse_document(std::string const& source, KeyDictionary& keys) -> Document {
+    auto arena = make_arena(source.size());
+    auto root = build_dom(source, arena.get(), StringMode::Copy, &keys);
+    return Document(std::move(arena), std::move(root));
+}
+
+auto parse_string(std::string const& source, ParseStats& stats) -> Json {
+    return build_dom(source, CountingResource::heap(), StringMode::Copy, nullptr, &stats);
+}
+
+auto parse_document(std::string const& source, ParseStats& stats) -> Document {
+    auto arena = make_arena(source.size());
+    // in the arena, so it lives exactly as long as the tree allocated through it
+    auto* const counting = new (arena->allocate(sizeof(CountingResource), alignof(CountingResource)))
+        CountingResource(arena.get());
+    auto root = build_dom(source, counting, StringMode::Copy, nullptr, &stats);
+    return Document(std::move(arena), std::move(root));
+}
+
+auto parse_document_in_situ(std::string_view source, std::shared_ptr<void const> owner) -> Document {
+    // borrowed strings leave the arena with containers and escaped strings only
+    auto arena = make_arena(source.size() / 2);
+    auto root = build_dom(source, arena.get(), StringMode::Borrow);
+    return Document(std::move(arena), std::move(root), std::move(owner));
+}
+
+auto parse_file(std::string const& path) -> Document {
+    auto const file = std::make_shared<MappedFile const>(path);
+    return parse_document_in_situ(file->contents(), file);
 }
 
-} // namespace json
\ No newline at end of file
+} // namespace json
@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace model {
+
+struct User {
+    std::string name;
+    std::int64_t followers = 0;
+    std::optional<std::string> location;
+};
+JSON_PARSER_BIND(User, name, followers, location)
+
+struct Post {
+    std::uint64_t id = 0;
+    std::string text;
+    User author;
+    std::vector<std::string> tags;
+    std::map<std::string, double> scores;
+    std::vector<std::optional<int>> votes;
+    bool pinned = false;
+    float weight = 0;
+};
+JSON_PARSER_BIND(Post, id, text, author, tags, scores, votes, pinned, weight)
+
+} // namespace model
+
+TEST_CASE("parse_bound reads straight into bound types", "[Binding]") {
+    using namespace json;
+
+    static_assert(is_bound_v<model::Post>);
+    static_assert(not is_bound_v<std::string>);
+
+    auto const post = parse_bound<model::Post>(R"({
+        "id": 18446744073709551615, "text": "café \"quoted\"",
+        "author": { "name": "ada", "followers": -3, "location": null },
+        "tags": ["a", "b"], "scores": { "x": 1.5, "y": -2 }, "votes": [1, null, 3],
+        "pinned": true, "weight": 0.25 })");
+
+    CHECK( post.id == 18446744073709551615u );
+    CHECK( post.text == "caf\xc3\xa9 \"quoted\"" );
+    CHECK( post.author.name == "ada" );
+    CHECK( post.author.followers == -3 );
+    CHECK_FALSE( post.author.location );
+    CHECK( post.tags == std::vector<std::string>{ "a", "b" } );
+    CHECK( post.scores == std::map<std::string, double>{ { "x", 1.5 }, { "y", -2.0 } } );
+    CHECK( post.votes == std::vector<std::optional<int>>{ 1, std::nullopt, 3 } );
+    CHECK( post.pinned );
+    CHECK( post.weight == 0.25f );
+
+    SECTION("Keys in any order, unknown keys skipped, missing keys left alone") {
+        auto user = model::User{ "before", 7, std::string("here") };
+        parse_bound(R"({"extra": {"deep": [1, {"x": null}]}, "location": "there", "name": "bob", "more": 1})",
+                    user);
+        CHECK( user.name == "bob" );
+        CHECK( user.followers == 7 );
+        CHECK( user.location == "there" );
+    }
+    SECTION("Standard containers at the top level") {
+        CHECK( parse_bound<std::vector<int>>("[1, 2, 3]") == std::vector<int>{ 1, 2, 3 } );
+        CHECK( parse_bound<std::vector<int>>("[]").empty() );
+        auto const map = parse_bound<std::unordered_map<std::string, std::vector<model::User>>>(
+            R"({"team": [{"name": "a"}, {"name": "b", "followers": 2}], "empty": []})");
+        REQUIRE( map.at("team").size() == 2 );
+        CHECK( map.at("team")[1].followers == 2 );
+        CHECK( map.at("empty").empty() );
+    }
+}
+
+TEST_CASE("parse_bound reports syntax and type errors", "[Binding]") {
+    using namespace json;
+
+    CHECK_THROWS_WITH( parse_bound<model::User>(R"({"name": 1})"),
+        "Parse error at [1:10][Number: 1]: Expected a string" );
+    CHECK_THROWS_WITH( parse_bound<model::User>(R"({"followers": 1.5})"),
+        "Parse error at [1:15][Number: 1.5]: Expected an integer in the range of the member type" );
+    CHECK_THROWS_WITH( parse_bound<std::vector<std::int8_t>>("[1, 300]"),
+        "Parse error at [1:5][Number: 300]: Expected an integer in the range of the member type" );
+    CHECK_THROWS_WITH( parse_bound<std::vector<unsigned>>("[-1]"),
+        "Parse error at [1:2][Number: -1]: Expected an integer in the range of the member type" );
+    CHECK_THROWS_AS( parse_bound<model::User>("[]"), JsonException );
+    CHECK_THROWS_AS( parse_bound<model::User>(R"({"name": "a" "followers": 1})"), JsonException );
+    CHECK_THROWS_AS( parse_bound<model::User>(R"({"name": "a", "skipped": [1 2]})"), JsonException );
+    CHECK_THROWS_AS( parse_bound<model::User>(R"({"name": "a"} 1)"), JsonException );
+    CHECK_THROWS_AS( parse_bound<std::vector<int>>("[1, 2"), JsonException );
+    CHECK_THROWS_AS( parse_bound<std::vector<int>>(""), JsonException );
+    CHECK_THROWS_AS( parse_bound<bool>("null"), JsonException );
+    CHECK_THROWS_WITH( parse_bound<model::User>(R"({"skipped": )" + std::string(100'000, '[')),
+        "Parse error at [1:1036][LeftBracket: \"[\"]: Arrays and objects nest deeper than 1024 levels" );
+}
+
+TEST_CASE("parse_bound rejects duplicate keys like parse_string", "[Binding]") {
+    using namespace json;
+
+    // a member, a skipped key, a key inside a skipped value, a map key
+    for (auto const source : { R"({"name": "a", "followers": 1, "name": "b"})",
+                               R"({"other": 1, "name": "a", "other": 2})",
+                               R"({"other": {"x": 1, "x": 2}})" }) {
+        CAPTURE( source );
+        auto const message = [&] {
+            try { static_cast<void>(parse_string(source)); } catch (JsonException const& e) { return std::string(e.what()); }
+            return std::string();
+        }();
+        CHECK_THROWS_WITH( parse_bound<model::User>(source), message );
+    }
+    CHECK_THROWS_WITH( (parse_bound<std::map<std::string, int>>(R"({"a": 1, "b": 2, "a": 3})")),
+        "Parse error at [1:18][String: \"a\"]: Key \"a\" already exist" );
+    // keys are per object
+    CHECK_NOTHROW( parse_bound<std::vector<model::User>>(R"([{"name": "a", "x": 1}, {"name": "b", "x": 2}])") );
+}
+
+TEST_CASE("serialize_bound writes what parse_bound reads", "[Binding]") {
+    using namespace json;
+
+    auto post = model::Post{};
+    post.id = 42;
+    post.text = "line\nbreak";
+    post.author = { "ada", 10, std::nullopt };
+    post.tags = { "x" };
+    post.scores = { { "b", 0.5 }, { "a", 2 } };
+    post.votes = { 1, std::nullopt };
+    post.weight = 1.5f;
+
+    auto const text = serialize_bound(post);
+    CHECK( text == R"({"id":42,"text":"line\nbreak","author":{"name":"ada","followers":10,"location":null},)"
+                   R"("tags":["x"],"scores":{"a":2,"b":0.5},"votes":[1,null],"pinned":false,"weight":1.5})" );
+
+    // the same JSON as a serialized Json
+    CHECK( serialize(parse_string(text)) == text );
+
+    auto const back = parse_bound<model::Post>(text);
+    CHECK( serialize_bound(back) == text );
+}
@@ -0,0 +1,67 @@
+#include "counting_new.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every form is replaced: one left to the C++ runtime, or to a sanitizer's,
+// would hand out memory that these operators delete do not own
+
+static std::atomic<std::size_t> allocations{0};
+
+// helpers
+
+static auto allocate(std::size_t size) noexcept -> void* {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned forms
+static auto allocate(std::size_t size, std::align_val_t alignment) noexcept -> void* {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    auto const align = static_cast<std::size_t>(alignment);
+    // aligned_alloc wants a non-zero multiple of the alignment
+    return std::aligned_alloc(align, size == 0 ? align : (size + align - 1) / align * align);
+}
+
+static auto allocate_or_throw(void* p) -> void* {
+    if (p == nullptr) { throw std::bad_alloc(); }
+    return p;
+}
+
+// free functions
+
+auto heap_allocations() noexcept -> std::size_t {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+auto operator new(std::size_t size) -> void* { return allocate_or_throw(allocate(size)); }
+auto operator new[](std::size_t size) -> void* { return allocate_or_throw(allocate(size)); }
+auto operator new(std::size_t size, std::nothrow_t const&) noexcept -> void* { return allocate(size); }
+auto operator new[](std::size_t size, std::nothrow_t const&) noexcept -> void* { return allocate(size); }
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void* {
+    return allocate_or_throw(allocate(size, alignment));
+}
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void* {
+    return allocate_or_throw(allocate(size, alignment));
+}
+auto operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept -> void* {
+    return allocate(size, alignment);
+}
+auto operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const&) noexcept -> void* {
+    return allocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::nothrow_t const&) noexcept { std::free(p); }
+void operator delete[](void* p, std::nothrow_t const&) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, std::nothrow_t const&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, std::nothrow_t const&) noexcept { std::free(p); }
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+
+// Calls of the global operator new since the start of the program, in every
+// form, the pmr default resource included. The executable must be linked
+// with counting_new.cpp, which replaces the global operators new and delete
+[[nodiscard]] auto heap_allocations() noexcept -> std::size_t;
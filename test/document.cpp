@@ -0,0 +1,75 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <utility>
+
+TEST_CASE("Document keeps the whole tree in its arena", "[Document]") {
+    using namespace json;
+
+    auto const source = R"({ "a long key that does not fit in SSO": ["a long string value that does not fit in SSO", 1, null] })";
+    auto doc = parse_document(source);
+    auto const& object = doc.root().object();
+
+    REQUIRE( object.size() == 1 );
+    auto const& [key, value] = *object.begin();
+    CHECK( key == "a long key that does not fit in SSO" );
+    CHECK( key.get_allocator().resource() == doc.resource() );
+    CHECK( value.array().get_allocator().resource() == doc.resource() );
+
+    SECTION("Copies are heap allocated") {
+        auto const copy = Json(doc.root());
+        CHECK( copy.object().get_allocator().resource() == std::pmr::get_default_resource() );
+        CHECK( copy.object().at(key).array()[0].string() == value.array()[0].string() );
+    }
+
+    SECTION("Documents can be moved") {
+        auto moved = std::move(doc);
+        CHECK( moved.root().object().at(key).array().size() == 3 );
+    }
+}
+
+TEST_CASE("Documents of the smallest sources", "[Document]") {
+    using namespace json;
+
+    CHECK( parse_document("1").root().integer() == 1 );
+    CHECK_THROWS_AS( parse_document(""), JsonException );
+
+    auto keys = KeyDictionary{};
+    CHECK_THROWS_AS( parse_document("", keys), JsonException );
+    auto stats = ParseStats{};
+    CHECK_THROWS_AS( parse_document("", stats), JsonException );
+}
+
+TEST_CASE("In situ documents borrow unescaped strings from their input", "[Document]") {
+    using namespace json;
+
+    auto const source = std::string(R"({ "plain": "borrowed from the source", "escaped": "line\nbreak" })");
+    auto const doc = parse_document_in_situ(source);
+    auto const& object = doc.root().object();
+
+    auto const plain = object.at("plain").string();
+    CHECK( plain == "borrowed from the source" );
+    CHECK( source.data() <= plain.data() );
+    CHECK( plain.data() + plain.size() <= source.data() + source.size() );
+
+    auto const escaped = object.at("escaped").string();
+    CHECK( escaped == "line\nbreak" );
+    CHECK( (escaped.data() < source.data() || source.data() + source.size() <= escaped.data()) );
+
+    SECTION("Copies own their strings") {
+        auto copy = Json(doc.root());
+        CHECK( copy.object().at("plain").string() == plain );
+        CHECK( std::as_const(copy).object().at("plain").string().data() != plain.data() );
+    }
+
+    SECTION("Single characters") {
+        CHECK( parse_document_in_situ("1").root().integer() == 1 );
+        CHECK_THROWS_AS( parse_document_in_situ(""), JsonException );
+    }
+
+    SECTION("Documents can own their input") {
+        auto owned = std::make_shared<std::string const>(source);
+        auto const owning = parse_document_in_situ(*owned, owned);
+        owned.reset();
+        CHECK( owning.root().object().at("plain").string() == "borrowed from the source" );
+    }
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include "json_parser/detail/MappedFile.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <thread>
+#include <sys/stat.h>
+
+namespace {
+
+auto temp_path(char const* name) -> std::string {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void write_file(std::string const& path, std::string const& contents) {
+    auto file = std::ofstream(path, std::ios::binary);
+    file << contents;
+}
+
+} // namespace
+
+TEST_CASE("parse_file maps regular files", "[File]") {
+    using namespace json;
+
+    auto const path = temp_path("json_parser_test_file.json");
+    auto const source = std::string(R"({ "plain": "a string long enough to not fit in SSO", "escaped": "a\tb" })");
+    write_file(path, source);
+
+    SECTION("The mapping holds the file's contents") {
+        auto const file = MappedFile(path);
+        CHECK( file.is_mapped() );
+        CHECK( file.contents() == source );
+    }
+
+    SECTION("The document keeps the mapping alive") {
+        auto doc = parse_file(path);
+        // the mapping stays valid once the file is gone
+        std::filesystem::remove(path);
+        CHECK( doc.root().object().at("plain").string() == "a string long enough to not fit in SSO" );
+        CHECK( doc.root().object().at("escaped").string() == "a\tb" );
+    }
+
+    SECTION("Files of a single character") {
+        auto const tiny = temp_path("json_parser_test_tiny.json");
+        write_file(tiny, "7");
+        CHECK( MappedFile(tiny).is_mapped() );
+        CHECK( parse_file(tiny).root().integer() == 7 );
+        std::filesystem::remove(tiny);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("parse_file reads what cannot be mapped", "[File]") {
+    using namespace json;
+
+    SECTION("Pipes") {
+        auto const path = temp_path("json_parser_test_fifo");
+        std::filesystem::remove(path);
+        REQUIRE( ::mkfifo(path.c_str(), 0600) == 0 );
+
+        auto writer = std::thread([&] { write_file(path, R"([1, "two", null])"); });
+        auto doc = parse_file(path);
+        writer.join();
+        std::filesystem::remove(path);
+
+        REQUIRE( doc.root().array().size() == 3 );
+        CHECK( doc.root().array()[1].string() == "two" );
+    }
+
+    SECTION("Empty files") {
+        auto const path = temp_path("json_parser_test_empty.json");
+        write_file(path, "");
+        auto const file = MappedFile(path);
+        CHECK_FALSE( file.is_mapped() );
+        CHECK( file.contents().empty() );
+        CHECK_THROWS_WITH( parse_file(path), "Parse error at [0:0][Eof: EOF]: Empty string" );
+        write_file(path, " \n");
+        CHECK_THROWS_WITH( parse_file(path), "Parse error at [1:2][Eof: EOF]: Empty string" );
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Missing files") {
+        CHECK_THROWS_AS( parse_file(temp_path("json_parser_test_missing.json")), std::system_error );
+    }
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("JsonObject keeps insertion order", "[JsonObject]") {
+    using namespace json;
+
+    auto const json = parse_string(R"({ "z": 1, "a": 2, "m": 3 })");
+    auto const& object = json.object();
+
+    auto it = object.begin();
+    CHECK( (it++)->first == "z" );
+    CHECK( (it++)->first == "a" );
+    CHECK( (it++)->first == "m" );
+    CHECK( it == object.end() );
+}
+
+TEST_CASE("JsonObject lookups below and above the index threshold", "[JsonObject]") {
+    using namespace json;
+
+    auto object = JsonObject{};
+    auto const count = 3 * JsonObject::index_threshold;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const [_, inserted] = object.try_emplace(JsonObject::key_type("key" + std::to_string(i)),
+                                                      Json{ static_cast<double>(i) });
+        CHECK( inserted );
+
+        // every key inserted so far is still found once the index kicks in
+        for (std::size_t j = 0; j <= i; ++j) {
+            REQUIRE( object.count("key" + std::to_string(j)) == 1 );
+        }
+    }
+
+    auto const last_key = "key" + std::to_string(count - 1);
+    CHECK( object.at(last_key).number() == static_cast<double>(count - 1) );
+    CHECK( object.find("missing") == object.end() );
+    CHECK_THROWS_AS( object.at("missing"), std::out_of_range );
+
+    SECTION("Duplicates are rejected without moving the arguments") {
+        auto key = JsonObject::key_type("key3");
+        auto value = Json{ "kept" };
+        CHECK_FALSE( object.try_emplace(std::move(key), std::move(value)).second );
+        CHECK( key == "key3" );
+        CHECK( value.string() == "kept" );
+        CHECK( object.size() == count );
+    }
+
+    SECTION("Erase keeps order and lookups") {
+        CHECK( object.erase("key0") == 1 );
+        CHECK( object.erase("key0") == 0 );
+        CHECK( object.begin()->first == "key1" );
+        CHECK( object.at(last_key).number() == static_cast<double>(count - 1) );
+    }
+
+    SECTION("operator[] inserts null") {
+        CHECK( object["new"].is_null() );
+        CHECK( object.size() == count + 1 );
+    }
+}
+
+TEST_CASE("Parser still rejects duplicate keys in large objects", "[JsonObject]") {
+    using namespace json;
+
+    std::string source = "{";
+    for (std::size_t i = 0; i < 2 * JsonObject::index_threshold; ++i) {
+        source += "\"k" + std::to_string(i) + "\": 0, ";
+    }
+    source += "\"k5\": 1 }";
+
+    CHECK_THROWS_WITH( parse_string(source), Catch::Contains("Key \"k5\" already exist") );
+}
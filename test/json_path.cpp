@@ -0,0 +1,132 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+auto const rfc6901 = std::string(R"({
+    "foo": ["bar", "baz"],
+    "": 0,
+    "a/b": 1,
+    "c%d": 2,
+    "e^f": 3,
+    "g|h": 4,
+    "i\\j": 5,
+    "k\"l": 6,
+    " ": 7,
+    "m~n": 8
+})");
+
+} // namespace
+
+TEST_CASE("JSON Pointer follows RFC 6901", "[JsonPath]") {
+    using namespace json;
+
+    auto const json = parse_string(rfc6901);
+    auto const lazy = LazyDocument(rfc6901);
+
+    auto const numbers = std::vector<std::pair<std::string, double>>{
+        {"/",    0}, {"/a~1b", 1}, {"/c%d", 2}, {"/e^f", 3}, {"/g|h", 4},
+        {"/i\\j", 5}, {"/k\"l", 6}, {"/ ",    7}, {"/m~0n", 8},
+    };
+    for (auto const& [pointer, expected] : numbers) {
+        auto const path = JsonPath::pointer(pointer);
+        REQUIRE( path.find(json) != nullptr );
+        CHECK( path.find(json)->number() == expected );
+        REQUIRE( path.find(lazy.root()).has_value() );
+        CHECK( path.find(lazy.root())->get_number() == expected );
+    }
+
+    CHECK( JsonPath::pointer("").find(json) == &json );
+    CHECK( JsonPath::pointer("/foo/0").find(json)->string() == "bar" );
+    CHECK( JsonPath::pointer("/foo/1").find(lazy.root())->get_string() == "baz" );
+
+    SECTION("Mismatches are not errors") {
+        for (auto const pointer : { "/missing", "/foo/2", "/foo/01", "/foo/-", "/foo/0/deeper", "/a~1b/x" }) {
+            CHECK( JsonPath::pointer(pointer).find(json) == nullptr );
+            CHECK_FALSE( JsonPath::pointer(pointer).find(lazy.root()).has_value() );
+        }
+    }
+    SECTION("Malformed pointers") {
+        CHECK_THROWS_WITH( JsonPath::pointer("foo"),
+            "Path error at column 1 of \"foo\": A JSON Pointer starts with \"/\"" );
+        CHECK_THROWS_WITH( JsonPath::pointer("/a~2"),
+            "Path error at column 3 of \"/a~2\": \"~\" must be followed by 0 or 1" );
+        CHECK_THROWS_AS( JsonPath::pointer("/a~"), JsonException );
+    }
+}
+
+TEST_CASE("Path expressions select every match in document order", "[JsonPath]") {
+    using namespace json;
+
+    auto const source = std::string(R"({
+        "store": {
+            "books": [
+                { "title": "A", "price": 8,  "tags": ["x"] },
+                { "title": "B", "price": 12, "tags": [] },
+                { "title": "C", "price": 9,  "tags": ["y", "z"] },
+                { "title": "D", "price": 23 }
+            ],
+            "a.b": { "c": true }
+        }
+    })");
+    auto const json = parse_string(source);
+    auto const lazy = LazyDocument(source);
+
+    auto const titles = [&](std::string_view expression) {
+        auto const path = JsonPath::compile(expression);
+        auto from_json = std::vector<std::string>{};
+        for (auto const* match : path.select(json)) {
+            from_json.emplace_back(match->string());
+        }
+        auto from_lazy = std::vector<std::string>{};
+        for (auto const& match : path.select(lazy.root())) {
+            from_lazy.push_back(match.get_string());
+        }
+        CHECK( from_json == from_lazy );
+        return from_json;
+    };
+
+    using strings = std::vector<std::string>;
+    CHECK( titles("$.store.books[*].title") == strings{"A", "B", "C", "D"} );
+    CHECK( titles("$.store.books.*.title")  == strings{"A", "B", "C", "D"} );
+    CHECK( titles("$.store.books[0].title") == strings{"A"} );
+    CHECK( titles("$.store.books[-1].title") == strings{"D"} );
+    CHECK( titles("$.store.books[-5].title").empty() );
+    CHECK( titles("$['store'][\"books\"][1]['title']") == strings{"B"} );
+    CHECK( titles("$.store.books[1:3].title") == strings{"B", "C"} );
+    CHECK( titles("$.store.books[::2].title") == strings{"A", "C"} );
+    CHECK( titles("$.store.books[-2:].title") == strings{"C", "D"} );
+    CHECK( titles("$.store.books[:100].title") == strings{"A", "B", "C", "D"} );
+    CHECK( titles("$.store.books[*].tags[*]") == strings{"x", "y", "z"} );
+    CHECK( titles("$.store.books[*].missing").empty() );
+    CHECK( titles("$.store.*.title").empty() );
+
+    auto const quoted = JsonPath::compile("$.store['a.b'].c");
+    CHECK( quoted.find(json)->boolean() );
+    CHECK( quoted.find(lazy.root())->get_bool() );
+
+    auto const first = JsonPath::compile("$.store.books[*].price");
+    CHECK( first.find(json)->number() == 8 );
+    CHECK( first.find(lazy.root())->get_number() == 8 );
+    CHECK( first.select(json).size() == 4 );
+    CHECK( JsonPath::compile("$").find(json) == &json );
+}
+
+TEST_CASE("Malformed path expressions", "[JsonPath]") {
+    using namespace json;
+
+    CHECK_THROWS_WITH( JsonPath::compile("store"),
+        "Path error at column 1 of \"store\": A path starts with \"$\"" );
+    CHECK_THROWS_WITH( JsonPath::compile("$."),
+        "Path error at column 3 of \"$.\": Expected a member name" );
+    CHECK_THROWS_WITH( JsonPath::compile("$[0"),
+        "Path error at column 4 of \"$[0\": Expected \"]\"" );
+    CHECK_THROWS_WITH( JsonPath::compile("$['a]"),
+        "Path error at column 6 of \"$['a]\": Unterminated quoted key" );
+    CHECK_THROWS_WITH( JsonPath::compile("$[1:2:0]"),
+        "Path error at column 7 of \"$[1:2:0]\": A slice step must be a positive integer" );
+    CHECK_THROWS_AS( JsonPath::compile("$[]"), JsonException );
+    CHECK_THROWS_AS( JsonPath::compile("$a"), JsonException );
+}
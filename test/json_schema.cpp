@@ -0,0 +1,230 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr char const* user_schema = R"({
+    "$schema": "https://json-schema.org/draft/2020-12/schema",
+    "title": "user",
+    "type": "object",
+    "properties": {
+        "id": { "type": "integer", "minimum": 1 },
+        "name": { "type": "string", "minLength": 2, "maxLength": 8, "pattern": "^[a-z]+$" },
+        "email": { "type": ["string", "null"] },
+        "role": { "enum": ["admin", "user", { "custom": [1, 2] }] },
+        "scores": { "type": "array", "items": { "type": "number", "exclusiveMaximum": 100 }, "maxItems": 3 },
+        "a/b~c": { "type": "boolean" }
+    },
+    "required": ["id", "name"],
+    "additionalProperties": false
+})";
+
+auto compile(char const* schema) -> json::JsonSchema {
+    return json::JsonSchema::compile(json::parse_string(schema));
+}
+
+// `instance` validated fused with parsing, checked against the validation of its Json
+auto check(json::JsonSchema const& schema, std::string const& instance) -> std::vector<json::SchemaViolation> {
+    auto const tree = json::parse_string(instance);
+    auto const from_tree = schema.validate(tree);
+    auto const fused = schema.validate(std::string_view(instance));
+    REQUIRE(fused.size() == from_tree.size());
+    for (std::size_t i = 0; i < fused.size(); ++i) {
+        CHECK(fused[i].path == from_tree[i].path);
+        CHECK(std::string(fused[i].keyword) == from_tree[i].keyword);
+        CHECK(fused[i].message == from_tree[i].message);
+        // the paths are JSON Pointers to the offending values
+        CHECK(json::JsonPath::pointer(fused[i].path).find(tree) != nullptr);
+    }
+    CHECK(schema.is_valid(tree) == fused.empty());
+    CHECK(schema.is_valid(std::string_view(instance)) == fused.empty());
+    return fused;
+}
+
+auto keywords(std::vector<json::SchemaViolation> const& violations) -> std::vector<std::string> {
+    auto result = std::vector<std::string>{};
+    for (auto const& violation : violations) { result.emplace_back(violation.keyword); }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("Valid instances have no violation", "[JsonSchema]") {
+    auto const schema = compile(user_schema);
+    CHECK(check(schema, R"({"id": 1, "name": "ada"})").empty());
+    CHECK(check(schema, R"({"id": 7.0, "name": "grace", "email": null, "role": "admin"})").empty());
+    CHECK(check(schema, R"({"id": 2, "name": "al", "role": {"custom": [1.0, 2]}, "scores": [1, 99.5]})").empty());
+    CHECK(check(schema, R"({"name": "bob", "a/b~c": true, "id": 18446744073709551615})").empty());
+}
+
+TEST_CASE("Every violation is reported with its path", "[JsonSchema]") {
+    auto const schema = compile(user_schema);
+    auto const violations = check(schema, R"({
+        "id": 0.5,
+        "name": "X",
+        "role": {"custom": [2, 1]},
+        "scores": [1, 100, "a", 3],
+        "a/b~c": 1,
+        "extra": {"deep": [1]}
+    })");
+    REQUIRE(violations.size() == 9);
+    CHECK(violations[0].path == "/id");
+    CHECK(violations[0].message == "Expected integer, found number");
+    CHECK(violations[1].path == "/name");
+    CHECK(violations[1].message == "String is shorter than 2 characters");
+    CHECK(violations[2].message == "String does not match the pattern \"^[a-z]+$\"");
+    CHECK(violations[3].path == "/role");
+    CHECK(violations[3].message == "Value is not one of the enum values");
+    CHECK(violations[4].path == "/scores/1");
+    CHECK(violations[4].message == "Value 100 is not below 100");
+    CHECK(violations[5].path == "/scores/2");
+    CHECK(violations[5].message == "Expected number, found string");
+    CHECK(violations[6].path == "/scores");
+    CHECK(violations[6].message == "Array has more than 3 items");
+    CHECK(violations[7].path == "/a~1b~0c");
+    CHECK(violations[7].message == "Expected boolean, found integer");
+    CHECK(violations[8].path == "/extra");
+    CHECK(violations[8].message == "Property \"extra\" is not allowed");
+    CHECK(violations[8].keyword == std::string("additionalProperties"));
+
+    auto const missing = check(schema, R"({"email": 1})");
+    REQUIRE(missing.size() == 3);
+    CHECK(missing[0].path == "/email");
+    CHECK(missing[0].message == "Expected null or string, found integer");
+    CHECK(missing[1].path == "");
+    CHECK(missing[1].message == "Missing required property \"id\"");
+    CHECK(missing[2].message == "Missing required property \"name\"");
+}
+
+TEST_CASE("Schema keywords", "[JsonSchema]") {
+    SECTION("type") {
+        auto const schema = compile(R"({"type": ["integer", "string"]})");
+        CHECK(check(schema, "3").empty());
+        CHECK(check(schema, "-3e2").empty());
+        CHECK(check(schema, "\"x\"").empty());
+        auto const violations = check(schema, "[1]");
+        REQUIRE(violations.size() == 1);
+        CHECK(violations[0].message == "Expected integer or string, found array");
+        CHECK(keywords(check(schema, "1.5")) == std::vector<std::string>{ "type" });
+    }
+    SECTION("Boolean schemas") {
+        CHECK(check(compile("true"), R"({"any": [1, null]})").empty());
+        auto const violations = check(compile(R"({"items": false})"), "[1, []]");
+        REQUIRE(violations.size() == 2);
+        CHECK(violations[1].path == "/1");
+        CHECK(violations[1].message == "No value is allowed here");
+    }
+    SECTION("enum compares numbers by value and objects regardless of order") {
+        auto const schema = compile(R"({"enum": [1, "1", {"a": 1, "b": [null]}, [true]]})");
+        CHECK(check(schema, "1.0").empty());
+        CHECK(check(schema, "\"1\"").empty());
+        CHECK(check(schema, R"({"b": [null], "a": 1e0})").empty());
+        CHECK(check(schema, "[true]").empty());
+        CHECK(check(schema, "2").size() == 1);
+        CHECK(check(schema, R"({"a": 1})").size() == 1);
+        CHECK(check(schema, "[true, true]").size() == 1);
+    }
+    SECTION("Nested enums") {
+        auto const schema = compile(R"({"enum": [[1, 2]], "items": {"enum": [1]}})");
+        CHECK(keywords(check(schema, "[1, 2]")) == std::vector<std::string>{ "enum" });
+        CHECK(keywords(check(schema, "[1, 3]")) == std::vector<std::string>{ "enum", "enum" });
+    }
+    SECTION("Numbers") {
+        auto const schema = compile(R"({"minimum": -1.5, "maximum": 10, "exclusiveMinimum": -2})");
+        CHECK(check(schema, "-1.5").empty());
+        CHECK(check(schema, "10").empty());
+        CHECK(check(schema, "\"text\"").empty());
+        CHECK(check(schema, "-1.75")[0].message == "Value -1.75 is below the minimum -1.5");
+        CHECK(check(schema, "11")[0].message == "Value 11 is above the maximum 10");
+        CHECK(keywords(check(schema, "-2")) == std::vector<std::string>{ "minimum", "exclusiveMinimum" });
+    }
+    SECTION("Integer bounds are exact past 2^53") {
+        auto const schema = compile(R"({"maximum": 9007199254740992, "exclusiveMinimum": -9007199254740993})");
+        CHECK(check(schema, "9007199254740992").empty());
+        CHECK(check(schema, "9007199254740993")[0].message
+              == "Value 9007199254740993 is above the maximum 9007199254740992");
+        CHECK(check(schema, "-9007199254740992").empty());
+        CHECK(keywords(check(schema, "-9007199254740993")) == std::vector<std::string>{ "exclusiveMinimum" });
+        CHECK(keywords(check(schema, "18446744073709551615")) == std::vector<std::string>{ "maximum" });
+
+        auto const unsigned_bounds = compile(R"({"minimum": 18446744073709551614})");
+        CHECK(check(unsigned_bounds, "18446744073709551615").empty());
+        CHECK(keywords(check(unsigned_bounds, "18446744073709551613")) == std::vector<std::string>{ "minimum" });
+        CHECK(keywords(check(unsigned_bounds, "-1")) == std::vector<std::string>{ "minimum" });
+    }
+    SECTION("String length counts code points") {
+        auto const schema = compile(R"({"minLength": 2, "maxLength": 3})");
+        CHECK(check(schema, R"("ééé")").empty());
+        CHECK(check(schema, R"("😀")")[0].message == "String is shorter than 2 characters");
+        CHECK(check(schema, R"("abcd")")[0].message == "String is longer than 3 characters");
+    }
+    SECTION("pattern is unanchored") {
+        auto const schema = compile(R"({"pattern": "b+c"})");
+        CHECK(check(schema, R"("abbcd")").empty());
+        CHECK(check(schema, R"("ac")").size() == 1);
+    }
+    SECTION("pattern does not recurse per character") {
+        auto const schema = compile(R"({"pattern": "^(a|b)*$"})");
+        auto text = "\"" + std::string(200'000, 'a') + "\"";
+        CHECK(check(schema, text).empty());
+        text[100'000] = 'c';
+        CHECK(check(schema, text).size() == 1);
+    }
+    SECTION("Container sizes") {
+        auto const schema = compile(R"({"minItems": 1, "minProperties": 2, "maxProperties": 2})");
+        CHECK(check(schema, "[]")[0].message == "Array has fewer than 1 items");
+        CHECK(check(schema, R"({"a": 1})")[0].message == "Object has fewer than 2 properties");
+        CHECK(check(schema, R"({"a": 1, "b": 2, "c": 3})")[0].message == "Object has more than 2 properties");
+        CHECK(check(schema, R"({"a": 1, "b": 2})").empty());
+    }
+    SECTION("additionalProperties as a schema") {
+        auto const schema = compile(R"({"properties": {"a": {}}, "additionalProperties": {"type": "string"}})");
+        CHECK(check(schema, R"({"a": 1, "b": "x"})").empty());
+        auto const violations = check(schema, R"({"a": 1, "b": 2})");
+        REQUIRE(violations.size() == 1);
+        CHECK(violations[0].path == "/b");
+    }
+    SECTION("Unknown keywords are ignored") {
+        CHECK(check(compile(R"({"description": "x", "format": "date", "type": "string"})"), "\"x\"").empty());
+    }
+}
+
+TEST_CASE("Validation stops at max_violations", "[JsonSchema]") {
+    auto const schema = compile(R"({"items": {"type": "string"}})");
+    auto const options = json::ValidateOptions{ 2 };
+    CHECK(schema.validate(json::parse_string("[1, 2, 3, 4]"), options).size() == 2);
+    // the rest of the input is not parsed once the limit is reached
+    auto const violations = schema.validate(std::string_view("[1, 2, 3, not json"), options);
+    REQUIRE(violations.size() == 2);
+    CHECK(violations[1].path == "/1");
+    CHECK_FALSE(schema.is_valid(std::string_view("[1, not json")));
+    CHECK_THROWS_AS(schema.validate(std::string_view("[\"a\", not json")), json::JsonException);
+    CHECK_THROWS_AS(schema.validate(std::string(100'000, '[')), json::JsonException);
+}
+
+TEST_CASE("Duplicate keys are errors like in parse_string", "[JsonSchema]") {
+    auto const schema = compile(R"({"type": "object"})");
+    auto const source = std::string_view(R"({"a": {"b": 1, "a": 2}, "a": 3})");
+    CHECK_THROWS_WITH(schema.validate(source), "Parse error at [1:25][String: \"a\"]: Key \"a\" already exist");
+    CHECK_THROWS_WITH(json::parse_string(std::string(source)), "Parse error at [1:25][String: \"a\"]: Key \"a\" already exist");
+    CHECK_THROWS_AS(schema.is_valid(source), json::JsonException);
+    // the empty key too
+    CHECK_THROWS_WITH(schema.validate(std::string_view(R"({"": 1, "": 2})")), "Parse error at [1:9][String: \"\"]: Key \"\" already exist");
+    CHECK_THROWS_WITH(json::parse_string(R"({"": 1, "": 2})"), "Parse error at [1:9][String: \"\"]: Key \"\" already exist");
+    // keys are per object
+    CHECK(schema.validate(std::string_view(R"({"a": {"a": {"a": 1}}, "b": {"a": 2}})")).empty());
+}
+
+TEST_CASE("Invalid schemas are errors", "[JsonSchema]") {
+    CHECK_THROWS_WITH(compile("1"), "Schema error at \"\": A schema is an object or a boolean");
+    CHECK_THROWS_WITH(compile(R"({"type": "text"})"), "Schema error at \"/type\": Unknown type \"text\"");
+    CHECK_THROWS_WITH(compile(R"({"properties": {"a/b": {"minLength": -1}}})"),
+                      "Schema error at \"/properties/a~1b/minLength\": Expected a non-negative integer");
+    CHECK_THROWS_WITH(compile(R"({"minLength": 1e300})"),
+                      Catch::StartsWith("Schema error at \"/minLength\": Expected an integer no larger than"));
+    CHECK_THROWS_WITH(compile(R"({"items": {"pattern": "("}})"),
+                      Catch::StartsWith("Schema error at \"/items/pattern\": Invalid regular expression"));
+    CHECK_THROWS_AS(compile(R"({"required": [1]})"), json::JsonException);
+}
@@ -1,5 +1,7 @@
 #include <catch2/catch.hpp>
 #include "json_parser/core.h"
+#include <string>
+#include <utility>
 
 TEST_CASE("Constructors", "[Json]") {
     using namespace json;
@@ -40,3 +42,64 @@ TEST_CASE("Constructors", "[Json]") {
 
     }
 }
+
+TEST_CASE("Layout of a Json node", "[Json]") {
+    using namespace json;
+    CHECK( sizeof(Json) == 16 );
+
+    SECTION("Short and long strings") {
+        auto const short_string = std::string(Json::inline_capacity, 's');
+        auto const long_string = std::string(Json::inline_capacity + 1, 'l');
+        auto const view = [](Json const& json) { return json.string(); };
+        CHECK( view(Json{ short_string }) == short_string );
+        CHECK( view(Json{ long_string }) == long_string );
+        CHECK( view(Json{ Json::string_t(long_string) }) == long_string );
+        CHECK( view(Json{ "" }).empty() );
+        CHECK( view(Json{ Type::String }).empty() );
+    }
+
+    SECTION("Mutable strings are owned") {
+        auto json = Json{ "inline" };
+        json.string() += " and now longer than inline";
+        CHECK( std::as_const(json).string() == "inline and now longer than inline" );
+
+        auto const source = std::string("a borrowed string, longer than inline");
+        auto borrowed = Json{ Json::borrowed_string_t{ source } };
+        CHECK( std::as_const(borrowed).string().data() == source.data() );
+        auto const copy = borrowed;
+        CHECK( std::as_const(copy).string().data() != source.data() );
+        borrowed.string() += "!";
+        CHECK( source == "a borrowed string, longer than inline" );
+    }
+
+    SECTION("Integers keep their kind") {
+        CHECK( Json{ -5 }.number_kind() == Number::Kind::Int );
+        CHECK( Json{ 5u }.number_kind() == Number::Kind::Int );
+        CHECK( Json{ 18446744073709551615u }.number_kind() == Number::Kind::UInt );
+        CHECK( Json{ 18446744073709551615u }.unsigned_integer() == 18446744073709551615u );
+        CHECK( Json{ 0.5 }.number_kind() == Number::Kind::Double );
+    }
+
+    SECTION("Containers stay in place when their Json moves") {
+        auto json = Json{ { Json{ 1 }, Json{ "two" } } };
+        auto const* elements = json.array().data();
+        auto moved = std::move(json);
+        CHECK( json.is_null() );
+        CHECK( moved.array().data() == elements );
+    }
+
+    SECTION("A value can be replaced by one of its members") {
+        auto json = parse_string(R"({"outer": {"inner": [1, "a string longer than inline"]}})");
+        json = std::move(json.object().at("outer"));
+        json = json.object().at("inner");
+        REQUIRE( json.array().size() == 2 );
+        CHECK( std::as_const(json).array()[1].string() == "a string longer than inline" );
+    }
+
+    SECTION("Copies own everything, from the default resource") {
+        auto document = parse_document(R"({"list": [1, 2, {"key": "a string longer than inline"}]})");
+        auto copy = document.root();
+        CHECK( copy.object().at("list").array().get_allocator().resource() == std::pmr::get_default_resource() );
+        CHECK( copy.to_string() == document.root().to_string() );
+    }
+}
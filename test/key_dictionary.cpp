@@ -0,0 +1,196 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("JsonKey stores short keys inline and long ones in its resource", "[JsonKey]") {
+    using namespace json;
+
+    CHECK( sizeof(JsonKey) == 24 );
+
+    auto arena = std::pmr::monotonic_buffer_resource{};
+    auto const short_key = JsonKey("id", &arena);
+    auto const long_key = JsonKey("a key longer than the inline capacity", &arena);
+    CHECK( short_key == "id" );
+    CHECK( long_key == "a key longer than the inline capacity" );
+    CHECK( short_key.get_allocator().resource() == &arena );
+    CHECK( long_key.get_allocator().resource() == &arena );
+    CHECK_FALSE( long_key.is_interned() );
+    CHECK_FALSE( long_key.handle() );
+    CHECK( JsonKey().empty() );
+
+    SECTION("Copies use their own resource") {
+        auto const copy = JsonKey(long_key);
+        CHECK( copy == long_key );
+        CHECK( copy.data() != long_key.data() );
+        CHECK( copy.get_allocator().resource() == std::pmr::get_default_resource() );
+    }
+
+    SECTION("Moves take the buffer over within one resource only") {
+        auto source = JsonKey(long_key, &arena);
+        auto const* const data = source.data();
+        auto moved = JsonKey(std::move(source), &arena);
+        CHECK( moved.data() == data );
+        CHECK( source.empty() );
+
+        auto other = JsonKey(std::move(moved), std::pmr::get_default_resource());
+        CHECK( other.data() != data );
+        CHECK( other == long_key );
+    }
+
+    SECTION("Assignment keeps the resource of the target") {
+        auto target = JsonKey("x", &arena);
+        target = JsonKey("another key longer than the inline capacity");
+        CHECK( target == "another key longer than the inline capacity" );
+        CHECK( target.get_allocator().resource() == &arena );
+        target = short_key;
+        CHECK( target == "id" );
+    }
+}
+
+TEST_CASE("KeyDictionary stores every key once", "[KeyDictionary]") {
+    using namespace json;
+
+    auto dictionary = KeyDictionary{};
+    auto const first = dictionary.intern("name");
+    auto const second = dictionary.intern(std::string("na") + "me");
+    REQUIRE( first );
+    CHECK( first.view() == "name" );
+    CHECK( first.view().data() == second.view().data() );
+    CHECK( first == second );
+    CHECK( first != dictionary.intern("other") );
+    CHECK( first.dictionary() == &dictionary );
+    CHECK( dictionary.find("name") == first );
+    CHECK_FALSE( dictionary.find("missing") );
+    CHECK( dictionary.intern("").view().empty() );
+
+    auto const stats = dictionary.stats();
+    CHECK( stats.keys == 3 );
+    CHECK( stats.bytes == 9 );
+    CHECK( stats.lookups == 4 );
+    CHECK( stats.hits == 1 );
+    CHECK( stats.hit_rate() == Approx(0.25) );
+    CHECK( dictionary.size() == 3 );
+
+    SECTION("Interned keys compare by pointer") {
+        auto const a = JsonKey(first);
+        auto const b = JsonKey(second);
+        CHECK( a.is_interned() );
+        CHECK( a == b );
+        CHECK( a.handle() == first );
+        CHECK( a != JsonKey(dictionary.intern("other")) );
+        CHECK( a == JsonKey("name") );
+
+        auto other_dictionary = KeyDictionary{};
+        CHECK( a == JsonKey(other_dictionary.intern("name")) );
+    }
+
+    SECTION("Copies of interned keys share the stored bytes") {
+        auto arena = std::pmr::monotonic_buffer_resource{};
+        auto const key = JsonKey(first);
+        auto const copy = JsonKey(key, &arena);
+        CHECK( copy.is_interned() );
+        CHECK( copy.data() == first.view().data() );
+
+        auto assigned = JsonKey("a key longer than the inline capacity", &arena);
+        assigned = key;
+        CHECK( assigned.data() == first.view().data() );
+    }
+}
+
+TEST_CASE("KeyDictionary is bounded", "[KeyDictionary]") {
+    using namespace json;
+
+    auto dictionary = KeyDictionary(2, 8);
+    CHECK_FALSE( dictionary.intern("longer than eight") );
+    CHECK( dictionary.intern("a") );
+    CHECK( dictionary.intern("b") );
+    CHECK_FALSE( dictionary.intern("c") );
+    CHECK( dictionary.intern("a") );
+    CHECK( dictionary.size() == 2 );
+
+    SECTION("Keys that are not interned are copied by the parser") {
+        auto const json = parse_string(R"({"a": 1, "c": 2, "longer than eight": 3})", dictionary);
+        auto const& object = json.object();
+        CHECK( object.begin()->first.is_interned() );
+        CHECK_FALSE( std::next(object.begin())->first.is_interned() );
+        CHECK( object.at("c").integer() == 2 );
+        CHECK( object.at("longer than eight").integer() == 3 );
+    }
+}
+
+TEST_CASE("Documents parsed with a KeyDictionary share their keys", "[KeyDictionary]") {
+    using namespace json;
+
+    auto dictionary = KeyDictionary{};
+    auto const source = std::string(R"({"identifier": 1, "description": {"identifier": 2}})");
+    auto const first = parse_document(source, dictionary);
+    auto const second = parse_string(source, dictionary);
+
+    auto const& a = first.root().object();
+    auto const& b = second.object();
+    CHECK( a.begin()->first.data() == b.begin()->first.data() );
+    CHECK( a.at("description").object().begin()->first.data() == a.begin()->first.data() );
+    CHECK( serialize(first.root()) == serialize(second) );
+    CHECK( dictionary.stats().keys == 2 );
+    CHECK( dictionary.stats().hits == 4 );
+
+    SECTION("Duplicate keys are still rejected") {
+        CHECK_THROWS_AS( parse_string(R"({"identifier": 1, "identifier": 2})", dictionary), JsonException );
+    }
+
+    SECTION("Interned keys survive copies and serialization") {
+        auto const copy = Json(first.root());
+        CHECK( copy.object().begin()->first.is_interned() );
+        CHECK( serialize(copy) == R"({"identifier":1,"description":{"identifier":2}})" );
+    }
+}
+
+TEST_CASE("KeyDictionary can be shared by threads", "[KeyDictionary]") {
+    using namespace json;
+
+    auto dictionary = KeyDictionary{};
+    constexpr auto thread_count = 4;
+    constexpr auto key_count = 500;
+
+    auto handles = std::vector<std::vector<InternedKey>>(thread_count);
+    auto threads = std::vector<std::thread>{};
+    for (auto t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            for (auto i = 0; i < key_count; ++i) {
+                handles[static_cast<std::size_t>(t)].push_back(dictionary.intern("key" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    for (auto i = std::size_t{0}; i < key_count; ++i) {
+        CHECK( handles[0][i].view().data() == handles[thread_count - 1][i].view().data() );
+    }
+    auto const stats = dictionary.stats();
+    CHECK( stats.keys == key_count );
+    CHECK( stats.lookups == thread_count * key_count );
+    CHECK( stats.hits == (thread_count - 1) * key_count );
+}
+
+TEST_CASE("NDJSON lines can intern their keys", "[KeyDictionary]") {
+    using namespace json;
+
+    auto dictionary = KeyDictionary{};
+    auto options = NdJsonOptions{};
+    options.threads = 2;
+    options.batch_bytes = 16;
+    options.keys = &dictionary;
+
+    auto const source = std::string(R"({"id": 1})" "\n" R"({"id": 2})" "\n" R"({"id": 3})" "\n");
+    auto lines = std::vector<NdJsonLine>{};
+    parse_ndjson(source, [&](NdJsonLine line) { lines.push_back(std::move(line)); }, options);
+    REQUIRE( lines.size() == 3 );
+    for (auto const& line : lines) {
+        CHECK( line.value.object().begin()->first.data() == dictionary.find("id").view().data() );
+    }
+    CHECK( dictionary.stats().keys == 1 );
+}
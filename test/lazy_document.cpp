@@ -0,0 +1,89 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <limits>
+#include <string>
+
+TEST_CASE("LazyDocument decodes only what is accessed", "[LazyDocument]") {
+    using namespace json;
+
+    auto const source = std::string(R"({
+        "skipped": { "deep": [1, [2, [3]], "a ] tricky } \" string"], "more": {} },
+        "user": { "name": "Ada \"L\"", "id": 42, "admin": false, "tags": ["x", "y", "z"] },
+        "nothing": null,
+        "empty": []
+    })");
+    auto const doc = LazyDocument(source);
+
+    CHECK( doc.root().type() == Type::Object );
+    CHECK( doc["user"]["id"].get_number() == 42 );
+    CHECK( doc["user"]["name"].get_string() == "Ada \"L\"" );
+    CHECK( doc["user"]["admin"].get_bool() == false );
+    CHECK( doc["user"]["tags"][2].get_string() == "z" );
+    CHECK( doc["user"]["tags"].size() == 3 );
+    CHECK( doc["nothing"].is_null() );
+    CHECK( doc["empty"].size() == 0 );
+    CHECK( doc["skipped"]["deep"][1][1][0].get_number() == 3 );
+    CHECK_FALSE( doc["user"].find("missing").has_value() );
+
+    auto const members = doc["user"].members();
+    REQUIRE( members.size() == 4 );
+    CHECK( members[3].first == "tags" );
+    CHECK( members[3].second.elements().size() == 3 );
+
+    SECTION("Access errors point at the value") {
+        CHECK_THROWS_WITH( doc["user"]["id"].get_string(),
+            "Access error at [3:46]: Invalid cast from number to string" );
+        CHECK_THROWS_WITH( doc["user"]["missing"],
+            "Access error at [3:17]: Key \"missing\" does not exist" );
+        CHECK_THROWS_WITH( doc["user"]["tags"][3],
+            "Access error at [3:74]: Index 3 is out of range" );
+    }
+}
+
+TEST_CASE("LazyDocument keeps 64-bit integers exact", "[LazyDocument]") {
+    using namespace json;
+
+    auto const source = std::string(R"({"id": 9007199254740993, "big": 18446744073709551615, "neg": -9223372036854775808, "x": 2.5})");
+    auto const doc = LazyDocument(source);
+
+    CHECK( doc["id"].number_kind() == Number::Kind::Int );
+    CHECK( doc["id"].integer() == 9007199254740993 );
+    CHECK( doc["big"].number_kind() == Number::Kind::UInt );
+    CHECK( doc["big"].unsigned_integer() == 18446744073709551615u );
+    CHECK( doc["neg"].integer() == std::numeric_limits<std::int64_t>::min() );
+    CHECK( doc["x"].number_kind() == Number::Kind::Double );
+    CHECK( doc["x"].get_number() == 2.5 );
+
+    CHECK_THROWS_WITH( doc["x"].integer(), "Access error at [1:89]: Number 2.5 does not fit in a 64-bit integer" );
+    CHECK_THROWS_WITH( doc["neg"].unsigned_integer(),
+        "Access error at [1:62]: Number -9223372036854775808 does not fit in a 64-bit unsigned integer" );
+    CHECK_THROWS_AS( doc["big"].integer(), JsonException );
+}
+
+TEST_CASE("LazyDocument reports errors lazily", "[LazyDocument]") {
+    using namespace json;
+
+    // the error is inside a value that is skipped
+    auto const source = std::string(R"({ "bad": [1, ?], "good": 2 })");
+    auto const doc = LazyDocument(source);
+    CHECK( doc["good"].get_number() == 2 );
+    CHECK_THROWS_WITH( doc["bad"][1].get_number(), "Scan error at [1:14]: \"?\" is an invalid character" );
+    CHECK_THROWS_WITH( doc.validate(), "Scan error at [1:14]: \"?\" is an invalid character" );
+
+    SECTION("Structure errors met on the way are parse errors") {
+        CHECK_THROWS_WITH( LazyDocument(R"({ "a": 1 "b": 2 })")["b"],
+            "Parse error at [1:10][String: \"b\"]: Expected comma \",\" after element in object" );
+        CHECK_THROWS_WITH( LazyDocument("[1, 2").root()[std::size_t{5}],
+            "Parse error at [1:6][Eof: EOF]: Need right bracket \"]\" to terminate an array" );
+        CHECK_THROWS_WITH( LazyDocument("  ").root(),
+            "Parse error at [1:2][Eof: EOF]: Empty string" );
+    }
+
+    SECTION("Escaped strings in errors are unescaped") {
+        CHECK_THROWS_WITH( LazyDocument(R"([1 "escaped \n and long enough to leave SSO"])").root()[1],
+            "Parse error at [1:4][String: \"escaped \n and long enough to leave SSO\"]: "
+            "Expected comma \",\" after element in array" );
+        CHECK_THROWS_WITH( LazyDocument(R"({ "escaped \n and long enough to leave SSO" 1 })")["x"],
+            "Parse error at [1:45][Number: 1]: Object must have a colon \":\" to separate a key-value pair" );
+    }
+}
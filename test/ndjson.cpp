@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+auto make_lines(std::size_t count) -> std::string {
+    std::string out;
+    for (std::size_t i = 0; i < count; ++i) {
+        out += R"({"id": )" + std::to_string(i) + R"(, "tags": ["a", "b"]})";
+        out += i % 3 == 0 ? "\r\n" : "\n";
+    }
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("NdJsonParser parses every line on its own", "[NdJson]") {
+    using namespace json;
+
+    auto const source = std::string("[1]\n\n  \n{\"a\": tru}\r\n\"last\"");
+    auto lines = std::vector<NdJsonLine>{};
+    parse_ndjson(source, [&](NdJsonLine&& line) { lines.push_back(std::move(line)); });
+
+    REQUIRE( lines.size() == 3 );
+    CHECK( lines[0].number == 1 );
+    CHECK( lines[0].value.array()[0].number() == 1 );
+    CHECK( lines[0].error.empty() );
+
+    // an invalid line does not stop the following ones
+    CHECK( lines[1].number == 4 );
+    CHECK( lines[1].value.is_null() );
+    CHECK( lines[1].error == "Scan error at [1:7]: \"tru\" is an invalid literal" );
+
+    CHECK( lines[2].number == 5 );
+    CHECK( lines[2].value.string() == "last" );
+}
+
+TEST_CASE("NdJsonParser reuses its parse state across lines and errors", "[NdJson]") {
+    using namespace json;
+
+    auto const source = std::string(R"({"a": [1, {"b": "x\ty"}]}
+{"a": 1, "a": 2}
+{"a\n":1,"a\n":2}
+[[[
+{"": "\u00e9"}
+{"a": [1, {"b": "x\ty"}]})");
+    auto options = NdJsonOptions{};
+    options.threads = 1;
+    auto parser = NdJsonParser(options);
+    // the second parse starts with the state the first one left
+    for (auto pass = 0; pass < 2; ++pass) {
+        auto lines = std::vector<NdJsonLine>{};
+        parser.parse(source, [&](NdJsonLine&& line) { lines.push_back(std::move(line)); });
+
+        REQUIRE( lines.size() == 6 );
+        CHECK( lines[0].value.object().at("a").array()[1].object().at("b").string() == "x\ty" );
+        CHECK( lines[1].error == "Parse error at [1:10][String: \"a\"]: Key \"a\" already exist" );
+        CHECK( lines[2].error == "Parse error at [1:10][String: \"a\n\"]: Key \"a\n\" already exist" );
+        CHECK_FALSE( lines[3].error.empty() );
+        CHECK( lines[4].value.object().at("").string() == "\u00e9" );
+        CHECK( lines[5].value.object().at("a").array()[1].object().at("b").string() == "x\ty" );
+    }
+}
+
+TEST_CASE("NdJsonParser delivers batches in order or as they complete", "[NdJson]") {
+    using namespace json;
+
+    auto const source = make_lines(500);
+    auto options = NdJsonOptions{};
+    options.threads = 3;
+    options.batch_bytes = 64;
+
+    SECTION("Ordered") {
+        auto numbers = std::vector<std::size_t>{};
+        NdJsonParser(options).parse(source, [&](NdJsonLine&& line) {
+            REQUIRE( line.error.empty() );
+            CHECK( line.value.object().at("id").number() == static_cast<double>(line.number - 1) );
+            numbers.push_back(line.number);
+        });
+        REQUIRE( numbers.size() == 500 );
+        CHECK( std::is_sorted(numbers.begin(), numbers.end()) );
+    }
+
+    SECTION("Unordered") {
+        options.ordered = false;
+        auto numbers = std::vector<std::size_t>{};
+        NdJsonParser(options).parse(source, [&](NdJsonLine&& line) {
+            CHECK( line.value.object().at("id").number() == static_cast<double>(line.number - 1) );
+            numbers.push_back(line.number);
+        });
+        std::sort(numbers.begin(), numbers.end());
+        REQUIRE( numbers.size() == 500 );
+        CHECK( numbers.front() == 1 );
+        CHECK( std::adjacent_find(numbers.begin(), numbers.end()) == numbers.end() );
+    }
+
+    SECTION("A throwing callback stops the parse") {
+        auto parser = NdJsonParser(options);
+        std::size_t delivered = 0;
+        CHECK_THROWS_AS( parser.parse(source, [&](NdJsonLine&&) {
+            if (++delivered == 10) { throw std::runtime_error("stop"); }
+        }), std::runtime_error );
+        CHECK( delivered == 10 );
+
+        // the pool is still usable afterwards
+        delivered = 0;
+        parser.parse(source, [&](NdJsonLine&&) { ++delivered; });
+        CHECK( delivered == 500 );
+    }
+}
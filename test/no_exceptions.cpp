@@ -0,0 +1,21 @@
+// Built with -fno-exceptions: the headers and try_parse must not need them
+#include "json_parser/core.h"
+#include <cstdio>
+#include <string_view>
+
+int main() {
+    auto const valid = json::try_parse(R"({"a": [1, 2]})");
+    if (not valid || valid->object().size() != 1) {
+        std::puts("try_parse failed on valid input");
+        return 1;
+    }
+
+    auto const source = std::string_view(R"({"a": [1, 2)");
+    auto const invalid = json::try_parse(source);
+    if (invalid || invalid.error().code != json::ParseErrc::UnterminatedArray) {
+        std::puts("try_parse did not report the error");
+        return 1;
+    }
+    std::printf("%s\n", invalid.error().message(source).c_str());
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+
+TEST_CASE("Numbers follow the JSON grammar", "[Number]") {
+    using namespace json;
+
+    SECTION("Valid numbers") {
+        for (auto const text : { "0", "-0", "1", "-1", "10", "0.5", "-0.5", "1e5", "1E5", "1e+5",
+                                 "1e-5", "1.25e2", "0e0", "123456789012345678901234567890" }) {
+            CAPTURE( text );
+            auto number = Number{};
+            CHECK( parse_number(text, number) == NumberError::None );
+            CHECK( parse_string(text).is_number() );
+        }
+    }
+    SECTION("Malformed numbers") {
+        for (auto const text : { "-", "+1", "01", "-01", "00", "1.", ".5", "1.e5", "1e", "1e+",
+                                 "1-2e", "1-2", "1e5.5", "--1", "1..2", "0x10", "1ee5" }) {
+            CAPTURE( text );
+            auto number = Number{};
+            CHECK( parse_number(text, number) == NumberError::Invalid );
+        }
+        CHECK_THROWS_WITH( parse_string("[1-2e]"), "Scan error at [1:2]: Cannot convert 1-2e to number" );
+        CHECK_THROWS_WITH( parse_string("[01]"), "Scan error at [1:2]: Cannot convert 01 to number" );
+    }
+    SECTION("Magnitudes beyond a double") {
+        CHECK_THROWS_WITH( parse_string("[1e400]"),
+            "Scan error at [1:2]: Number 1e400 is out of the range of a double" );
+        CHECK_THROWS_AS( parse_string("-" + std::string(400, '9')), JsonException );
+        CHECK( parse_string("1e-400").number() == 0.0 );
+        CHECK( std::signbit(parse_string("-1e-400").number()) );
+    }
+}
+
+TEST_CASE("Integers are stored exactly", "[Number]") {
+    using namespace json;
+
+    auto const max = std::numeric_limits<std::int64_t>::max();
+    auto const min = std::numeric_limits<std::int64_t>::min();
+    auto const umax = std::numeric_limits<std::uint64_t>::max();
+
+    auto const json = parse_string(R"({
+        "id": 9007199254740993, "max": 9223372036854775807, "min": -9223372036854775808,
+        "above": 9223372036854775808, "umax": 18446744073709551615,
+        "beyond": 18446744073709551616, "below": -9223372036854775809,
+        "zero": 0, "negative_zero": -0, "real": 2.5, "integral": 3.0
+    })");
+    auto const& object = json.object();
+
+    // 2^53 + 1 has no double
+    CHECK( object.at("id").is_integer() );
+    CHECK( object.at("id").integer() == 9007199254740993 );
+    CHECK( object.at("max").integer() == max );
+    CHECK( object.at("min").integer() == min );
+    CHECK( object.at("above").number_kind() == Number::Kind::UInt );
+    CHECK( object.at("above").unsigned_integer() == std::uint64_t{1} << 63 );
+    CHECK( object.at("umax").unsigned_integer() == umax );
+
+    // past 64 bits integers become the nearest double
+    CHECK( object.at("beyond").number_kind() == Number::Kind::Double );
+    CHECK( object.at("beyond").number() == 18446744073709551616.0 );
+    CHECK( object.at("below").number_kind() == Number::Kind::Double );
+
+    CHECK( object.at("zero").number_kind() == Number::Kind::Int );
+    CHECK( object.at("negative_zero").number_kind() == Number::Kind::Double );
+    CHECK( std::signbit(object.at("negative_zero").number()) );
+    CHECK( object.at("integral").integer() == 3 );
+
+    CHECK_THROWS_WITH( object.at("real").integer(), "Number 2.5 does not fit in a 64-bit integer" );
+    CHECK_THROWS_WITH( object.at("umax").integer(),
+        "Number 18446744073709551615 does not fit in a 64-bit integer" );
+    CHECK_THROWS_AS( object.at("min").unsigned_integer(), JsonException );
+    CHECK_THROWS_WITH( Json("text").integer(), "Invalid cast from string to number" );
+
+    SECTION("They round-trip through the serializer") {
+        CHECK( json.to_string() == R"({"id":9007199254740993,"max":9223372036854775807,)"
+                                   R"("min":-9223372036854775808,"above":9223372036854775808,)"
+                                   R"("umax":18446744073709551615,"beyond":18446744073709551616,)"
+                                   R"("below":-9223372036854775808,"zero":0,"negative_zero":-0,)"
+                                   R"("real":2.5,"integral":3})" );
+    }
+    SECTION("Every front end keeps them") {
+        auto const source = std::string(R"([9007199254740993, 18446744073709551615])");
+
+        auto const doc = parse_document(source);
+        CHECK( doc.root().array()[0].integer() == 9007199254740993 );
+
+        auto push = JsonPushParser{};
+        push.feed(source.substr(0, 10));
+        push.feed(source.substr(10));
+        auto const pushed = push.finish();
+        CHECK( pushed.array()[1].unsigned_integer() == umax );
+
+        auto const tape = TapeDocument(encode_tape(parse_string(source)));
+        CHECK( tape.root().array()[0].integer() == 9007199254740993 );
+        CHECK( tape.root().array()[1].unsigned_integer() == umax );
+        CHECK( tape.root().to_json().to_string() == source.substr(0, 17) + "," + source.substr(19) );
+    }
+    SECTION("Integers of every length") {
+        auto random = std::mt19937_64(1);
+        for (std::size_t length = 1; length <= 19; ++length) {
+            for (int i = 0; i < 100; ++i) {
+                auto text = std::to_string(random() % 9 + 1);
+                while (text.size() < length) {
+                    text += static_cast<char>('0' + random() % 10);
+                }
+                CAPTURE( text );
+                auto number = Number{};
+                REQUIRE( parse_number(text, number) == NumberError::None );
+                auto const expected = std::stoull(text);
+                if (expected <= static_cast<std::uint64_t>(max)) { CHECK( number.i == static_cast<std::int64_t>(expected) ); }
+                else                                             { CHECK( number.u == expected ); }
+                REQUIRE( parse_number(text + ".5", number) == NumberError::None );
+                CHECK( number.d == std::strtod((text + ".5").c_str(), nullptr) );
+            }
+        }
+    }
+    SECTION("Built values") {
+        CHECK( Json(42).is_integer() );
+        CHECK( Json(42).to_string() == "42" );
+        CHECK( Json(std::uint64_t{7}).number_kind() == Number::Kind::Int );
+        CHECK( Json(umax).number_kind() == Number::Kind::UInt );
+        CHECK( Json(1.0).is_integer() == false );
+        CHECK( Json(1.0).integer() == 1 );
+    }
+}
+
+TEST_CASE("Decimal numbers are correctly rounded", "[Number]") {
+    using namespace json;
+
+    auto random = std::mt19937_64(42);
+    auto digits = std::uniform_int_distribution<int>(1, 20);
+    auto exponents = std::uniform_int_distribution<int>(-330, 310);
+    for (int i = 0; i < 20'000; ++i) {
+        auto text = std::to_string(random() % 10 + 1);
+        auto const count = digits(random);
+        text += '.';
+        for (int d = 0; d < count; ++d) {
+            text += static_cast<char>('0' + random() % 10);
+        }
+        // mostly short exponents, where the fast path applies
+        auto const exponent = i % 2 == 0 ? exponents(random) % 23 : exponents(random);
+        text += "e" + std::to_string(exponent);
+
+        auto number = Number{};
+        auto const error = parse_number(text, number);
+        auto const expected = std::strtod(text.c_str(), nullptr);
+        CAPTURE( text );
+        if (std::isinf(expected)) {
+            CHECK( error == NumberError::OutOfRange );
+        } else {
+            REQUIRE( error == NumberError::None );
+            CHECK( number.d == expected );
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+auto same(json::Json const& a, json::Json const& b) -> bool {
+    using json::Type;
+    if (a.type() != b.type()) { return false; }
+    switch (a.type()) {
+    case Type::Null:    return true;
+    case Type::Boolean: return a.boolean() == b.boolean();
+    case Type::Number:  return a.number() == b.number();
+    case Type::String:  return a.string() == b.string();
+    case Type::Array: {
+        auto const& x = a.array();
+        auto const& y = b.array();
+        if (x.size() != y.size()) { return false; }
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if (not same(x[i], y[i])) { return false; }
+        }
+        return true;
+    }
+    case Type::Object: {
+        auto const& x = a.object();
+        auto const& y = b.object();
+        if (x.size() != y.size()) { return false; }
+        for (auto it = x.begin(), jt = y.begin(); it != x.end(); ++it, ++jt) {
+            if (it->first != jt->first || not same(it->second, jt->second)) { return false; }
+        }
+        return true;
+    }
+    }
+    return false;
+}
+
+auto error_of(std::string const& source, bool parallel) -> std::string {
+    auto pool = json::ThreadPool(3);
+    try {
+        if (parallel) { static_cast<void>(json::parse_string_parallel(source, pool, 1)); }
+        else          { static_cast<void>(json::parse_string(source)); }
+    } catch (json::JsonException const& e) {
+        return e.what();
+    }
+    return "no error";
+}
+
+} // namespace
+
+TEST_CASE("parse_string_parallel matches parse_string", "[ParallelParser]") {
+    using namespace json;
+
+    auto source = std::string("[\n");
+    for (int i = 0; i < 200; ++i) {
+        if (i != 0) { source += ",\n"; }
+        source += R"({ "id": )" + std::to_string(i) + R"(, "text": "a, [tricky] {string}\" ,", )"
+                + R"("nested": [[1, 2], {"x": [3]}], "empty": [] })";
+    }
+    source += "\n]\n";
+
+    auto pool = ThreadPool(3);
+    for (std::size_t chunk_bytes : { 1u, 100u, 1000u, 100000u }) {
+        CAPTURE( chunk_bytes );
+        CHECK( same(parse_string_parallel(source, pool, chunk_bytes), parse_string(source)) );
+    }
+
+    SECTION("A chunk size of 0 hands one element to each range") {
+        CHECK( same(parse_string_parallel(source, pool, 0), parse_string(source)) );
+        CHECK( same(parse_string_parallel("[1,2,3]", ParallelOptions{ 2, 0 }), parse_string("[1,2,3]")) );
+    }
+
+    SECTION("Other documents are parsed sequentially") {
+        for (auto const& other : { "[]", "[ ]", "[1]", "{\"a\": [1, 2]}", "\"text\"", "12" }) {
+            CAPTURE( other );
+            CHECK( same(parse_string_parallel(other, pool, 1), parse_string(other)) );
+        }
+    }
+}
+
+TEST_CASE("parse_string_parallel reports the errors of parse_string", "[ParallelParser]") {
+    auto const sources = std::vector<std::string>{
+        "[1, 2", "[1 2]", "[1,,2]", "[1,]", "[{\"a\": 1, \"a\": 2}]", "[1]]", "[1] x",
+        "[{]}", "[\"a\", [}, 3]", "[1, ?]", "[1,\n 2,\n tru]", "",
+        "[1, " + std::string(json::max_nesting_depth, '[') + std::string(json::max_nesting_depth, ']') + "]",
+    };
+    for (auto const& source : sources) {
+        CAPTURE( source );
+        auto const expected = error_of(source, false);
+        REQUIRE( expected != "no error" );
+        CHECK( error_of(source, true) == expected );
+    }
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <string>
+#include <vector>
+
+using json::ParseErrc;
+
+namespace {
+
+// counts values, stopping at the first string equal to `stop`
+struct StopHandler {
+    std::string_view stop;
+    int values = 0;
+
+    auto on_null() -> bool { return ++values, true; }
+    auto on_bool(bool) -> bool { return ++values, true; }
+    auto on_number(double) -> bool { return ++values, true; }
+    auto on_string(std::string_view value) -> bool { return ++values, value != stop; }
+    auto on_key(std::string_view) -> bool { return true; }
+    auto on_start_object() -> bool { return true; }
+    auto on_end_object() -> bool { return true; }
+    auto on_start_array() -> bool { return true; }
+    auto on_end_array() -> bool { return true; }
+};
+
+auto thrown_message(std::string const& source) -> std::string {
+    try {
+        static_cast<void>(json::parse_string(source));
+    } catch (json::JsonException const& e) {
+        return e.what();
+    }
+    return "no exception";
+}
+
+} // namespace
+
+TEST_CASE("try_parse returns the parsed value", "[ParseError]") {
+    auto const result = json::try_parse(R"({"a": [1, "two", null], "b": {"c": true}})");
+    REQUIRE(result.has_value());
+    REQUIRE(result);
+    CHECK(result->object().at("a").array().size() == 3);
+    CHECK((*result).object().at("b").object().at("c").boolean());
+    CHECK_FALSE(result.error());
+}
+
+TEST_CASE("try_parse returns the error parse_string throws", "[ParseError]") {
+    struct Case {
+        std::string source;
+        ParseErrc code;
+        std::size_t offset;
+    };
+    auto const cases = std::vector<Case>{
+        { "[1, @]",                 ParseErrc::InvalidCharacter,   4 },
+        { "[nul]",                  ParseErrc::InvalidLiteral,     1 },
+        { "[1, 2-3]",               ParseErrc::InvalidNumber,      4 },
+        { "1e999",                  ParseErrc::NumberOutOfRange,   0 },
+        { "[\"abc",                 ParseErrc::UnterminatedString, 1 },
+        { "[\"a\\x\"]",             ParseErrc::InvalidEscape,      5 },
+        { "\"\\u12g4\"",            ParseErrc::InvalidHexDigit,    6 },
+        { "\"\\uDC00\"",            ParseErrc::UnpairedSurrogate,  0 },
+        { "\"\xff\"",               ParseErrc::InvalidUtf8,        0 },
+        { "  ",                     ParseErrc::EmptyInput,         1 },
+        { "[1] 2",                  ParseErrc::TrailingContent,    4 },
+        { "[1, ]",                  ParseErrc::ExpectedValue,      4 },
+        { "[1 2]",                  ParseErrc::ExpectedArrayComma, 3 },
+        { "[1, 2",                  ParseErrc::UnterminatedArray,  4 },
+        { "{1: 2}",                 ParseErrc::ExpectedKey,        1 },
+        { "{\"a\" 2}",              ParseErrc::ExpectedColon,      5 },
+        { "{\"a\": 1 \"b\": 2}",    ParseErrc::ExpectedObjectComma, 8 },
+        { "{\"a\": 1",              ParseErrc::UnterminatedObject, 6 },
+        { "{\"a\": 1, \"a\": 2}",   ParseErrc::DuplicateKey,       9 },
+        { "{\"k\\n\": 1, \"k\\n\": 2}", ParseErrc::DuplicateKey,   11 },
+        { std::string(json::max_nesting_depth + 1, '['), ParseErrc::NestingTooDeep, json::max_nesting_depth },
+    };
+    for (auto const& [source, code, offset] : cases) {
+        INFO(source);
+        auto const result = json::try_parse(source);
+        REQUIRE_FALSE(result.has_value());
+        CHECK(result.error().code == code);
+        CHECK(result.error().offset == offset);
+        CHECK(result.error().message(source) == thrown_message(source));
+    }
+}
+
+TEST_CASE("Arrays and objects nest up to max_nesting_depth", "[ParseError]") {
+    using json::max_nesting_depth;
+
+    auto const deepest = std::string(max_nesting_depth, '[') + std::string(max_nesting_depth, ']');
+    CHECK(json::try_parse(deepest).has_value());
+    CHECK_THROWS_AS(json::parse_string("[" + deepest + "]"), json::JsonException);
+
+    // far beyond what the stack would hold in recursion
+    auto const attack = std::string(1'000'000, '[');
+    auto const result = json::try_parse(attack);
+    REQUIRE_FALSE(result.has_value());
+    CHECK(result.error().code == ParseErrc::NestingTooDeep);
+    CHECK(result.error().offset == max_nesting_depth);
+    CHECK(thrown_message(attack) == "Parse error at [1:1025][LeftBracket: \"[\"]: "
+                                    "Arrays and objects nest deeper than 1024 levels");
+
+    auto objects = std::string();
+    for (std::size_t i = 0; i < 2 * max_nesting_depth; ++i) { objects += R"({"a": [)"; }
+    CHECK(json::try_parse(objects).error().code == ParseErrc::NestingTooDeep);
+    // the object opening the level past the limit, two levels per 7 characters
+    CHECK(json::try_parse(objects).error().offset == 7 * max_nesting_depth / 2);
+}
+
+TEST_CASE("The location of a ParseError is computed from its offset", "[ParseError]") {
+    auto const source = std::string("{\n  \"a\": 1,\n  \"b\" 2\n}");
+    auto const error = json::try_parse(source).error();
+    CHECK(error.code == ParseErrc::ExpectedColon);
+    auto const [line, column] = error.location(source);
+    CHECK(line == 3);
+    CHECK(column == 7);
+    CHECK(error.message(source) == "Parse error at [3:7][Number: 2]: "
+                                   "Object must have a colon \":\" to separate a key-value pair");
+    CHECK(sizeof(json::ParseError) <= 16);
+}
+
+TEST_CASE("try_parse_sax tells errors from a stopped parse", "[ParseError]") {
+    auto handler = StopHandler{ "stop" };
+    auto const completed = json::try_parse_sax(R"(["a", 1, "b"])", handler);
+    REQUIRE(completed.has_value());
+    CHECK(*completed);
+
+    auto const stopped = json::try_parse_sax(R"(["a", "stop", "b"])", handler);
+    REQUIRE(stopped.has_value());
+    CHECK_FALSE(*stopped);
+
+    auto const failed = json::try_parse_sax(R"(["a", tru])", handler);
+    REQUIRE_FALSE(failed.has_value());
+    CHECK(failed.error().code == ParseErrc::InvalidLiteral);
+    CHECK(failed.error().is_scan_error());
+}
+
+TEST_CASE("A reporting Scanner returns Error tokens after an error", "[ParseError]") {
+    auto scanner = json::Scanner("[1, #, 2]");
+    scanner.set_error_mode(json::ErrorMode::Report);
+    CHECK(scanner.next_token().type == json::TokenType::LeftBracket);
+    CHECK(scanner.next_token().type == json::TokenType::Number);
+    CHECK(scanner.next_token().type == json::TokenType::Comma);
+    CHECK(scanner.next_token().type == json::TokenType::Error);
+    CHECK(scanner.next_token().type == json::TokenType::Error);
+    CHECK(scanner.error().code == ParseErrc::InvalidCharacter);
+    CHECK(scanner.error().offset == 4);
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include "json_parser/detail/Instrumentation.h"
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CountingSax {
+    std::size_t events = 0;
+
+    auto on_null() -> bool                   { return ++events, true; }
+    auto on_bool(bool) -> bool               { return ++events, true; }
+    auto on_number(double) -> bool           { return ++events, true; }
+    auto on_string(std::string_view) -> bool { return ++events, true; }
+    auto on_key(std::string_view) -> bool    { return ++events, true; }
+    auto on_start_object() -> bool           { return ++events, true; }
+    auto on_end_object() -> bool             { return ++events, true; }
+    auto on_start_array() -> bool            { return ++events, true; }
+    auto on_end_array() -> bool              { return ++events, true; }
+};
+
+} // namespace
+
+TEST_CASE("Instrumented parses count tokens and values", "[ParseStats]") {
+    using namespace json;
+
+    auto const source = std::string(R"({"a": [1, 2.5, "x\ty\"", null], "b\n": {"c": [[true]]}, "d": ""})");
+    auto stats = ParseStats{};
+    auto const json = parse_string(source, stats);
+
+    CHECK( json.object().at("a").array().size() == 4 );
+    CHECK( stats.bytes == source.size() );
+    CHECK( stats.token_count(TokenType::LeftBrace) == 2 );
+    CHECK( stats.token_count(TokenType::RightBrace) == 2 );
+    CHECK( stats.token_count(TokenType::LeftBracket) == 3 );
+    CHECK( stats.token_count(TokenType::String) == 6 );
+    CHECK( stats.token_count(TokenType::Number) == 2 );
+    CHECK( stats.token_count(TokenType::Comma) == 5 );
+    CHECK( stats.token_count(TokenType::Colon) == 4 );
+    CHECK( stats.token_count(TokenType::True) == 1 );
+    CHECK( stats.token_count(TokenType::Null) == 1 );
+    CHECK( stats.token_count(TokenType::Eof) == 1 );
+    CHECK( stats.max_depth == 4 );
+    CHECK( stats.strings == 2 );
+    CHECK( stats.keys == 4 );
+    CHECK( stats.escaped_strings == 2 );
+    CHECK( stats.escapes == 3 );
+    CHECK( stats.numbers == 2 );
+    CHECK( stats.integers == 1 );
+    CHECK( stats.allocations > 0 );
+    CHECK( stats.allocated_bytes > 0 );
+    CHECK( stats.total_time() == stats.scan_time + stats.parse_time + stats.build_time );
+
+    SECTION("Documents count what they allocate in their arena") {
+        auto document_stats = ParseStats{};
+        auto const document = parse_document(source, document_stats);
+        CHECK( document.root().object().size() == 3 );
+        CHECK( document_stats.allocations > 0 );
+        CHECK( document_stats.keys == stats.keys );
+    }
+
+    SECTION("Scalars have no depth") {
+        auto scalar = ParseStats{};
+        CHECK( parse_string("42", scalar).integer() == 42 );
+        CHECK( scalar.max_depth == 0 );
+        CHECK( scalar.integers == 1 );
+    }
+}
+
+TEST_CASE("Instrumented parses report errors like the others", "[ParseStats]") {
+    using namespace json;
+
+    auto stats = ParseStats{};
+    CHECK_THROWS_WITH( parse_string(R"({"a": 1, "a": 2})", stats),
+                       Catch::Contains("Key \"a\" already exist") );
+    CHECK_THROWS_AS( parse_string("[1 2]", stats), JsonException );
+    CHECK_THROWS_AS( parse_string(R"(["open)", stats), JsonException );
+
+    SECTION("Error tokens have a count too") {
+        auto statistics = ScanStatistics{ stats, PhaseTimer() };
+        statistics.count(Token(0, TokenType::Error, Token::NullLiteral{}), "?");
+        CHECK( stats.token_count(TokenType::Error) == 1 );
+    }
+}
+
+TEST_CASE("SAX parses can be instrumented", "[ParseStats]") {
+    using namespace json;
+
+    auto handler = CountingSax{};
+    auto stats = ParseStats{};
+    CHECK( parse_sax(R"([{"k": 1}, 18446744073709551615])", handler, stats) );
+    CHECK( handler.events == 7 );
+    CHECK( stats.keys == 1 );
+    CHECK( stats.integers == 2 );
+    CHECK( stats.max_depth == 2 );
+    CHECK( stats.allocations == 0 );
+}
+
+TEST_CASE("NDJSON lines can be observed", "[ParseStats]") {
+    using namespace json;
+
+    auto mutex = std::mutex{};
+    auto observed = std::vector<std::pair<std::size_t, std::size_t>>{};
+    auto options = NdJsonOptions{};
+    options.threads = 2;
+    options.observer = [&](std::size_t line, ParseStats const& stats) {
+        auto const lock = std::lock_guard{ mutex };
+        observed.emplace_back(line, stats.keys);
+    };
+
+    auto count = std::size_t{0};
+    parse_ndjson("{\"a\": 1}\n\n{\"a\": 1, \"b\": 2}\n", [&](NdJsonLine&&) { ++count; }, options);
+    CHECK( count == 2 );
+    std::sort(observed.begin(), observed.end());
+    CHECK( observed == std::vector<std::pair<std::size_t, std::size_t>>{ { 1, 1 }, { 3, 2 } } );
+}
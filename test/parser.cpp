@@ -0,0 +1,25 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+
+TEST_CASE("Parser pulls tokens from the scanner", "[Parser]") {
+    using namespace json;
+
+    SECTION("Nested documents") {
+        auto const json = parse_string(R"({ "a": [1, 2, { "b": null }], "c": "str" })");
+        REQUIRE( json.is_object() );
+        CHECK( json.object().at("a").array().size() == 3 );
+        CHECK( json.object().at("a").array()[2].object().at("b").is_null() );
+        CHECK( json.object().at("c").string() == "str" );
+    }
+
+    SECTION("Errors keep line and column") {
+        CHECK_THROWS_WITH( parse_string("[1,\n 2"),
+            "Parse error at [2:2][Eof: EOF]: Need right bracket \"]\" to terminate an array" );
+        CHECK_THROWS_WITH( parse_string(R"({ "a": 1, "a": 2 })"),
+            "Parse error at [1:11][String: \"a\"]: Key \"a\" already exist" );
+        CHECK_THROWS_WITH( parse_string("[1, ?]"),
+            "Scan error at [1:5]: \"?\" is an invalid character" );
+        CHECK_THROWS_WITH( parse_string(""),
+            "Parse error at [0:0][Eof: EOF]: Empty string" );
+    }
+}
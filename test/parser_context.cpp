@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include "counting_new.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+auto make_message(std::size_t i) -> std::string {
+    return R"({"message_identifier": )" + std::to_string(i)
+        + R"(, "text": "line\nbreak \"quoted\" é", "ratio": 0.)" + std::to_string(i % 100)
+        + R"(, "tags": ["a", "b", "c"], "nested": {"deep": [[[)" + std::to_string(i) + R"(]]]})"
+        + R"(, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5, "k6": 6, "k7": 7})";
+}
+
+} // namespace
+
+TEST_CASE("ParserContext parses like parse_string", "[ParserContext]") {
+    using namespace json;
+
+    auto context = ParserContext{};
+    auto const source = make_message(7);
+    auto const& json = context.parse(source);
+    CHECK( serialize(json) == serialize(parse_string(source)) );
+    CHECK( json.object().at("text").string() == "line\nbreak \"quoted\" \xC3\xA9" );
+
+    SECTION("The next parse replaces the result") {
+        auto const& next = context.parse("[1, 2]");
+        CHECK( next.array().size() == 2 );
+    }
+
+    SECTION("Results can be allocated elsewhere") {
+        auto const heap = context.parse(source, std::pmr::get_default_resource());
+        CHECK( heap.object().get_allocator().resource() == std::pmr::get_default_resource() );
+        CHECK( heap.object().at("message_identifier").integer() == 7 );
+    }
+
+    SECTION("Errors leave the context usable") {
+        CHECK_THROWS_AS( context.parse(R"({"a": 1, "a": 2})"), JsonException );
+        CHECK_THROWS_AS( context.parse(R"(["unterminated)"), JsonException );
+        CHECK_THROWS_AS( context.parse("[1 2]"), JsonException );
+        CHECK( context.parse(R"({"a": "b\tc"})").object().at("a").string() == "b\tc" );
+    }
+
+    SECTION("Duplicate keys are reported like parse_string does, escaped ones included") {
+        auto const duplicate = std::string(R"({"a\n":1,"a\n":2})");
+        auto const message = "Parse error at [1:10][String: \"a\n\"]: Key \"a\n\" already exist";
+        CHECK_THROWS_WITH( parse_string(duplicate), message );
+        CHECK_THROWS_WITH( context.parse(duplicate), message );
+        CHECK_THROWS_WITH( context.parse(duplicate, std::pmr::get_default_resource()), message );
+    }
+}
+
+TEST_CASE("ParserContext grows its arena to the largest document", "[ParserContext]") {
+    using namespace json;
+
+    auto context = ParserContext(64);
+    auto large = std::string("[");
+    for (auto i = 0; i < 1000; ++i) { large += std::to_string(i) + ","; }
+    large += "0]";
+
+    CHECK( context.parse(large).array().size() == 1001 );
+    CHECK( context.parse(large).array().size() == 1001 );
+    CHECK( context.arena_capacity() > 64 );
+}
+
+TEST_CASE("ParserContext recovers from errors past its arena", "[ParserContext]") {
+    using namespace json;
+
+    // the open containers of the failed parse spilled out of the arena
+    auto context = ParserContext(64);
+    auto nested = std::string();
+    for (auto i = 0; i < 50; ++i) { nested += R"([{"key": "a string too long to be stored inline", "next": )"; }
+
+    CHECK_THROWS_AS( context.parse(nested), JsonException );
+    CHECK_THROWS_AS( context.parse(nested + "1]"), JsonException );
+    CHECK( context.parse(R"([{"key": [1, 2]}])").array()[0].object().at("key").array().size() == 2 );
+
+    CHECK_THROWS_AS( context.parse(nested, std::pmr::get_default_resource()), JsonException );
+    CHECK( context.parse("[1]").array().size() == 1 );
+}
+
+TEST_CASE("ParserContext does not allocate once warmed up", "[ParserContext]") {
+    using namespace json;
+
+    auto messages = std::vector<std::string>{};
+    for (std::size_t i = 0; i < 100; ++i) { messages.push_back(make_message(i * 7919)); }
+
+    auto context = ParserContext{};
+    for (auto const& message : messages) { static_cast<void>(context.parse(message)); }
+
+    std::size_t integers = 0;
+    auto const before = heap_allocations();
+    for (auto const& message : messages) {
+        auto const& json = context.parse(message);
+        integers += json.object().at("nested").object().at("deep").array().size();
+    }
+    auto const allocations = heap_allocations() - before;
+
+    CHECK( integers == messages.size() );
+    CHECK( allocations == 0 );
+}
@@ -0,0 +1,170 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// records every event as a string
+struct RecordingHandler {
+    std::vector<std::string> events;
+
+    auto record(std::string event) -> bool {
+        events.push_back(std::move(event));
+        return true;
+    }
+
+    auto on_null() -> bool                     { return record("null"); }
+    auto on_bool(bool v) -> bool               { return record(v ? "true" : "false"); }
+    auto on_number(double v) -> bool           { return record(std::to_string(v)); }
+    auto on_string(std::string_view v) -> bool { return record("\"" + std::string(v) + "\""); }
+    auto on_key(std::string_view k) -> bool    { return record("key " + std::string(k)); }
+    auto on_start_object() -> bool             { return record("{"); }
+    auto on_end_object() -> bool               { return record("}"); }
+    auto on_start_array() -> bool              { return record("["); }
+    auto on_end_array() -> bool                { return record("]"); }
+};
+
+// feeds `source` in chunks of `size` bytes, each a separate copy so
+// nothing can reference a released chunk
+auto push_events(std::string_view source, std::size_t size) -> std::vector<std::string> {
+    auto handler = RecordingHandler{};
+    auto parser = json::PushParser<RecordingHandler>(handler);
+    for (std::size_t i = 0; i < source.size(); i += size) {
+        auto const chunk = std::string(source.substr(i, size));
+        parser.feed(chunk);
+    }
+    parser.finish();
+    return handler.events;
+}
+
+auto push_error(std::string_view source, std::size_t size) -> std::string {
+    try {
+        static_cast<void>(push_events(source, size));
+    } catch (json::JsonException const& e) {
+        return e.what();
+    }
+    return "no error";
+}
+
+auto pull_error(std::string_view source) -> std::string {
+    auto handler = RecordingHandler{};
+    try {
+        static_cast<void>(json::parse_sax(source, handler));
+    } catch (json::JsonException const& e) {
+        return e.what();
+    }
+    return "no error";
+}
+
+} // namespace
+
+TEST_CASE("PushParser resumes across any chunk boundary", "[PushParser]") {
+    using namespace json;
+
+    auto const source = std::string_view(
+        "{ \"key\": [1, -2.5e3, true, false, null],\n"
+        "  \"escaped \\\"quote\\\"\": \"tab\\tnew\\nline\\u0041\",\n"
+        "  \"nested\": { \"empty\": {}, \"list\": [[], [0.125]] } }");
+
+    auto reference = RecordingHandler{};
+    REQUIRE( parse_sax(source, reference) );
+
+    for (std::size_t size = 1; size <= source.size(); ++size) {
+        CAPTURE( size );
+        CHECK( push_events(source, size) == reference.events );
+    }
+
+    SECTION("Empty chunks are harmless") {
+        auto handler = RecordingHandler{};
+        auto parser = PushParser<RecordingHandler>(handler);
+        CHECK( parser.feed("") );
+        CHECK( parser.feed("[12") );
+        CHECK( parser.feed("") );
+        CHECK( parser.feed("34]") );
+        CHECK( parser.finish() );
+        CHECK( handler.events == std::vector<std::string>{ "[", std::to_string(1234.0), "]" } );
+    }
+
+    SECTION("A top-level number is only complete at the end of input") {
+        auto handler = RecordingHandler{};
+        auto parser = PushParser<RecordingHandler>(handler);
+        CHECK( parser.feed("42") );
+        CHECK( handler.events.empty() );
+        CHECK( parser.finish() );
+        CHECK( handler.events == std::vector<std::string>{ std::to_string(42.0) } );
+    }
+}
+
+TEST_CASE("PushParser reports the errors of Parser", "[PushParser]") {
+    auto const sources = std::vector<std::string>{
+        "", "   ", "[1,\n 2", "[1 2]", "{\"a\" 1}", "{1: 2}", "{\"a\": 1 \"b\": 2}",
+        "[1, ?]", "[1,]", "[", "{", "{\"a\":", "tru", "[nul]", "1 2",
+        "\"a\\qb\"", "\"\\u12g4\"", "\"\\ud800\"", "\"\\ud83dx\"", "\"\\ud83d\\n\"",
+        "\"\\ud83d\\u0041\"", "\"\\udc00\"", "[\"ok\", \"\xff\"]", "\"caf\xc3\"", "\"\\n\xed\xa0\x80\"",
+        "e", ".e+3", "[.5]", "[eel]", "[[}-]", "[}\"abc", "{\"a\": ]?",
+    };
+
+    for (auto const& source : sources) {
+        auto const expected = pull_error(source);
+        CAPTURE( source );
+        REQUIRE( expected != "no error" );
+        for (std::size_t size = 1; size <= std::max<std::size_t>(source.size(), 1); ++size) {
+            CAPTURE( size );
+            CHECK( push_error(source, size) == expected );
+        }
+    }
+
+    SECTION("Lexemes starting like a number") {
+        for (std::size_t size = 1; size <= 4; ++size) {
+            CHECK( push_error("e", size) == "Scan error at [1:1]: Cannot convert e to number" );
+            CHECK( push_error(".e+3", size) == "Scan error at [1:1]: Cannot convert .e+3 to number" );
+        }
+    }
+
+    SECTION("A rejected value fails after the token following it") {
+        for (std::size_t size = 1; size <= 5; ++size) {
+            CHECK( push_error("[[}-]", size) == "Scan error at [1:4]: Cannot convert - to number" );
+            CHECK( push_error("[[}]", size) == "Parse error at [1:3][RightBrace: \"}\"]: Invalid literal" );
+        }
+    }
+
+    SECTION("Unterminated strings") {
+        for (std::size_t size = 1; size <= 5; ++size) {
+            CHECK( push_error("\"abc", size) == "Scan error at [1:1]: Unterminated string" );
+            CHECK( push_error("[\"x\\", size) == "Scan error at [1:2]: Unterminated string" );
+            CHECK( push_error("\"\\u00", size) == "Scan error at [1:1]: Unterminated string" );
+        }
+    }
+
+    SECTION("Nesting deeper than max_nesting_depth") {
+        auto const source = std::string(2 * json::max_nesting_depth, '[');
+        for (auto const size : { std::size_t{1}, std::size_t{7}, source.size() }) {
+            CHECK( push_error(source, size) == pull_error(source) );
+        }
+        auto const followed = source + "?";
+        CHECK( push_error(followed, 1) == pull_error(followed) );
+    }
+}
+
+TEST_CASE("JsonPushParser builds a Json from chunks", "[PushParser]") {
+    using namespace json;
+
+    auto parser = JsonPushParser{};
+    parser.feed(R"({ "a": [1, 2, { "b": nu)");
+    parser.feed(R"(ll }], "c": "st)");
+    parser.feed(R"(r" })");
+    auto const json = parser.finish();
+
+    REQUIRE( json.is_object() );
+    CHECK( json.object().at("a").array().size() == 3 );
+    CHECK( json.object().at("a").array()[2].object().at("b").is_null() );
+    CHECK( json.object().at("c").string() == "str" );
+
+    SECTION("Duplicate keys throw like parse_string") {
+        auto duplicate = JsonPushParser{};
+        duplicate.feed(R"({ "a": 1, )");
+        CHECK_THROWS_WITH( duplicate.feed(R"("a": 2 })"),
+            "Parse error at [1:11][String: \"a\"]: Key \"a\" already exist" );
+    }
+}
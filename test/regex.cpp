@@ -0,0 +1,114 @@
+#include <catch2/catch.hpp>
+#include "json_parser/JsonException.h"
+#include "json_parser/detail/Regex.h"
+#include <string>
+
+namespace {
+
+auto search(char const* pattern, std::string const& text) -> bool {
+    return json::Regex(pattern).search(text);
+}
+
+} // namespace
+
+TEST_CASE("Regex search", "[Regex]") {
+    SECTION("Literals are unanchored") {
+        CHECK(search("bc", "abcd"));
+        CHECK_FALSE(search("bd", "abcd"));
+        CHECK(search("", ""));
+        CHECK(search("a\\.b\\/", "xa.b/"));
+        CHECK_FALSE(search("a\\.b", "axb"));
+    }
+    SECTION("Anchors") {
+        CHECK(search("^ab$", "ab"));
+        CHECK_FALSE(search("^ab$", "abc"));
+        CHECK_FALSE(search("^ab", "cab"));
+        CHECK(search("b$", "ab"));
+        CHECK(search("^a|b$", "xb"));
+        CHECK(search("^$", ""));
+    }
+    SECTION("Alternation and groups") {
+        CHECK(search("^(ab|cd)+$", "abcdab"));
+        CHECK_FALSE(search("^(ab|cd)+$", "abc"));
+        CHECK(search("^(?:a|)b$", "b"));
+        CHECK(search("^(?<year>\\d{4})-(?<month>\\d\\d)$", "2024-05"));
+    }
+    SECTION("Quantifiers") {
+        CHECK(search("^a*$", ""));
+        CHECK_FALSE(search("^a+$", ""));
+        CHECK(search("^ab?c$", "ac"));
+        CHECK(search("^a{2}$", "aa"));
+        CHECK_FALSE(search("^a{2}$", "aaa"));
+        CHECK(search("^a{2,}$", "aaaaa"));
+        CHECK_FALSE(search("^a{2,3}$", "aaaa"));
+        CHECK(search("^a{2,3}?$", "aaa"));
+        CHECK(search("^a*?b$", "aab"));
+        // not a quantifier, a literal brace
+        CHECK(search("^a{,2}$", "a{,2}"));
+        CHECK(search("^{$", "{"));
+    }
+    SECTION("Classes") {
+        CHECK(search("^[a-c_]+$", "ab_c"));
+        CHECK_FALSE(search("^[a-c]$", "d"));
+        CHECK(search("^[^a-c]$", "d"));
+        CHECK(search("^[\\d.-]+$", "1.5-2"));
+        CHECK(search("^\\w+\\s\\W$", "a_1 !"));
+        CHECK(search("^\\S\\D$", "ab"));
+        CHECK_FALSE(search("[]", "a"));
+        CHECK(search("^[^]$", "\n"));
+        CHECK(search("^[\\b]$", "\b"));
+        CHECK(search("^[\\]]$", "]"));
+    }
+    SECTION("Any character but line terminators") {
+        CHECK(search("^.$", "\xC3\xA9"));
+        CHECK(search("^.$", "\xF0\x9F\x98\x80"));
+        CHECK_FALSE(search("^.$", "\n"));
+        CHECK_FALSE(search("^.$", "\xE2\x80\xA8"));
+        // an invalid byte is one U+FFFD
+        CHECK(search("^.$", "\xFF"));
+        CHECK(search("^\\uFFFD$", "\xFF"));
+    }
+    SECTION("Escapes") {
+        CHECK(search("^\\x41\\u00e9\\t$", "A\xC3\xA9\t"));
+        CHECK(search("^\\uD83D\\uDE00$", "\xF0\x9F\x98\x80"));
+        CHECK(search("^\\u{1F600}$", "\xF0\x9F\x98\x80"));
+        CHECK(search("^\\cJ$", "\n"));
+        CHECK(search("^[\\u00e0-\\u00ff]+$", "\xC3\xA9\xC3\xA0"));
+    }
+    SECTION("Word boundaries") {
+        CHECK(search("\\bcat\\b", "a cat."));
+        CHECK_FALSE(search("\\bcat\\b", "concat"));
+        CHECK(search("\\Bcat", "concat"));
+    }
+    SECTION("Long texts") {
+        CHECK(search("^(a|b)*$", std::string(1'000'000, 'a')));
+        CHECK_FALSE(search("^(a|aa)*c$", std::string(100'000, 'a')));
+        CHECK(search("x$", std::string(1'000'000, 'a') + "x"));
+    }
+}
+
+TEST_CASE("Invalid regular expressions", "[Regex]") {
+    auto const invalid = [](char const* pattern) {
+        CHECK_THROWS_AS(json::Regex(pattern), json::JsonException);
+    };
+    invalid("(");
+    invalid("a)");
+    invalid("[a");
+    invalid("[b-a]");
+    invalid("[\\d-z]");
+    invalid("*a");
+    invalid("a**");
+    invalid("^*");
+    invalid("a{2,1}");
+    invalid("\\");
+    invalid("\\xZ1");
+    invalid("\\q");
+    invalid("(a)\\1");
+    invalid("(?=a)");
+    invalid("(?<!a)");
+    invalid("\\p{L}");
+    invalid("a{10001}");
+    invalid("(a{100}){101}");
+    invalid((std::string(300, '(') + std::string(300, ')')).c_str());
+    CHECK_THROWS_WITH(json::Regex("ab)"), "Invalid regular expression: Unmatched \")\" at offset 2");
+}
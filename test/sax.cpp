@@ -0,0 +1,53 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// records every event as a string
+struct RecordingHandler {
+    std::vector<std::string> events;
+    std::size_t stop_after = static_cast<std::size_t>(-1);
+
+    auto record(std::string event) -> bool {
+        events.push_back(std::move(event));
+        return events.size() < stop_after;
+    }
+
+    auto on_null() -> bool                     { return record("null"); }
+    auto on_bool(bool v) -> bool               { return record(v ? "true" : "false"); }
+    auto on_number(double v) -> bool           { return record(std::to_string(static_cast<int>(v))); }
+    auto on_string(std::string_view v) -> bool { return record("\"" + std::string(v) + "\""); }
+    auto on_key(std::string_view k) -> bool    { return record("key " + std::string(k)); }
+    auto on_start_object() -> bool             { return record("{"); }
+    auto on_end_object() -> bool               { return record("}"); }
+    auto on_start_array() -> bool              { return record("["); }
+    auto on_end_array() -> bool                { return record("]"); }
+};
+
+} // namespace
+
+TEST_CASE("parse_sax reports values in document order", "[Sax]") {
+    using namespace json;
+
+    auto handler = RecordingHandler{};
+    CHECK( parse_sax(R"({ "a": [1, true, null], "b": { "c": "x\ty" }, "d": [] })", handler) );
+    CHECK( handler.events == std::vector<std::string>{
+        "{", "key a", "[", "1", "true", "null", "]",
+        "key b", "{", "key c", "\"x\ty\"", "}",
+        "key d", "[", "]", "}" } );
+
+    SECTION("Handlers can stop early") {
+        auto stopping = RecordingHandler{};
+        stopping.stop_after = 3;
+        CHECK_FALSE( parse_sax(R"([1, 2, 3, 4])", stopping) );
+        CHECK( stopping.events == std::vector<std::string>{ "[", "1", "2" } );
+    }
+
+    SECTION("Syntax errors still throw") {
+        auto failing = RecordingHandler{};
+        CHECK_THROWS_WITH( parse_sax("[1 2]", failing),
+            "Parse error at [1:4][Number: 2]: Expected comma \",\" after element in array" );
+    }
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <string>
+
+TEST_CASE("serialize writes compact JSON", "[Serializer]") {
+    using namespace json;
+
+    auto const json = parse_string(R"({ "a": [1, 2.5, true, null], "b": {}, "c": [], "d": "x" })");
+    CHECK( serialize(json) == R"({"a":[1,2.5,true,null],"b":{},"c":[],"d":"x"})" );
+    CHECK( json.to_string() == serialize(json) );
+
+    SECTION("Empty containers") {
+        CHECK( Json(Type::Array).to_string() == "[]" );
+        CHECK( Json(Type::Object).to_string() == "{}" );
+    }
+
+    SECTION("Numbers are the shortest text reading back the same double") {
+        CHECK( Json(0.1).to_string() == "0.1" );
+        CHECK( Json(-3.0).to_string() == "-3" );
+        CHECK( Json(1e21).to_string() == "1e+21" );
+        auto const third = 1.0 / 3.0;
+        CHECK( parse_string(Json(third).to_string()).number() == third );
+        CHECK( Json(std::numeric_limits<double>::quiet_NaN()).to_string() == "null" );
+        CHECK( Json(std::numeric_limits<double>::infinity()).to_string() == "null" );
+    }
+
+    SECTION("Strings are escaped") {
+        CHECK( Json("quote \" backslash \\ slash /").to_string() == R"("quote \" backslash \\ slash /")" );
+        CHECK( Json("\b\f\n\r\t").to_string() == R"("\b\f\n\r\t")" );
+        CHECK( Json(std::string_view("\x01\x1f", 2)).to_string() == R"("\u0001\u001f")" );
+        CHECK( Json("caf\xc3\xa9").to_string() == "\"caf\xc3\xa9\"" );
+
+        // escapes after and between whole 16 byte blocks
+        auto const long_text = std::string(40, 'a') + "\"" + std::string(20, 'b') + "\n";
+        auto const expected = "\"" + std::string(40, 'a') + "\\\"" + std::string(20, 'b') + "\\n\"";
+        CHECK( Json(long_text).to_string() == expected );
+        auto const parsed = parse_string(expected);
+        CHECK( parsed.string() == long_text );
+    }
+}
+
+TEST_CASE("serialize indents on request", "[Serializer]") {
+    using namespace json;
+
+    auto const json = parse_string(R"({ "a": [1, { "b": null }], "c": [], "d": {} })");
+    auto options = SerializeOptions{};
+    options.indent = 2;
+    CHECK( serialize(json, options) ==
+        "{\n"
+        "  \"a\": [\n"
+        "    1,\n"
+        "    {\n"
+        "      \"b\": null\n"
+        "    }\n"
+        "  ],\n"
+        "  \"c\": [],\n"
+        "  \"d\": {}\n"
+        "}" );
+}
+
+TEST_CASE("Writer hands buffered output to sinks", "[Serializer]") {
+    using namespace json;
+
+    auto array = Json::array_t{};
+    for (int i = 0; i < 20'000; ++i) {
+        array.emplace_back("element " + std::to_string(i));
+    }
+    auto const json = Json(std::move(array));
+    auto const expected = serialize(json);
+    REQUIRE( expected.size() > 2 * Writer::flush_threshold );
+
+    SECTION("Callbacks receive blocks") {
+        auto received = std::string{};
+        std::size_t blocks = 0;
+        {
+            auto writer = Writer([&](std::string_view block) {
+                received += block;
+                ++blocks;
+            });
+            serialize(json, writer);
+        }
+        CHECK( received == expected );
+        CHECK( blocks > 2 );
+    }
+
+    SECTION("Files and file descriptors") {
+        for (bool const use_fd : { false, true }) {
+            auto* const file = std::tmpfile();
+            REQUIRE( file != nullptr );
+            {
+                auto writer = use_fd ? Writer(fileno(file)) : Writer(file);
+                serialize(json, writer);
+                writer.flush();
+            }
+            std::fflush(file);
+            std::rewind(file);
+            auto read = std::string(expected.size() + 1, '\0');
+            read.resize(std::fread(read.data(), 1, read.size(), file));
+            std::fclose(file);
+            CHECK( read == expected );
+        }
+    }
+}
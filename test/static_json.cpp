@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr char const* config_text = R"({
+    "service": "search",
+    "port": 8080,
+    "ratio": 0.25,
+    "limits": { "max": 18446744073709551615, "min": -9223372036854775808, "scale": -1.5e3 },
+    "hosts": ["alpha", "beta", "caf\u00e9 \uD83D\uDE00"],
+    "enabled": true,
+    "fallback": null,
+    "empty": { "list": [], "object": {} }
+})";
+
+constexpr auto config = JSON_PARSER_STATIC(config_text);
+
+// everything below is checked by the compiler
+static_assert(config.root().is_object());
+static_assert(config.root().size() == 8);
+static_assert(config.root()["service"].string() == "search");
+static_assert(config.root()["port"].integer() == 8080);
+static_assert(config.root()["ratio"].number() == 0.25);
+static_assert(config.root()["limits"]["max"].unsigned_integer() == 18446744073709551615u);
+static_assert(config.root()["limits"]["min"].integer() == -9223372036854775807 - 1);
+static_assert(config.root()["limits"]["scale"].number() == -1500.0);
+static_assert(config.root()["limits"]["scale"].integer() == -1500);
+static_assert(config.root()["hosts"].size() == 3);
+static_assert(config.root()["hosts"][1].string() == "beta");
+static_assert(config.root()["hosts"][2].string() == "caf\xc3\xa9 \xf0\x9f\x98\x80");
+static_assert(config.root()["enabled"].boolean());
+static_assert(config.root()["fallback"].is_null());
+static_assert(config.root()["empty"]["list"].size() == 0);
+static_assert(config.root()["empty"]["object"].size() == 0);
+static_assert(config.root().key(7) == "empty");
+static_assert(config.root().contains("port") && not config.root().contains("missing"));
+
+// sizes are exact: one node per value, the decoded bytes of escaped strings
+static_assert(sizeof(config.nodes_) / sizeof(json::StaticNode) == 17);
+static_assert(sizeof(config.strings_) == 10);
+
+} // namespace
+
+TEST_CASE("StaticJson is the tree of parse_string", "[StaticJson]") {
+    using namespace json;
+
+    CHECK( serialize(config.root().to_json()) == serialize(parse_string(config_text)) );
+
+    constexpr auto scalar = JSON_PARSER_STATIC(" -0 ");
+    CHECK( scalar.root().number_kind() == Number::Kind::Double );
+    CHECK( std::signbit(scalar.root().number()) );
+
+    SECTION("Doubles outside the fast path match parse_string") {
+        // halfway points and values next to them, subnormals, the largest
+        // double, and digits beyond the 780 that are kept deciding a tie
+        constexpr auto text = "[1e300, 2.2250738585072014e-308, 123456789012345678901234567890, 1e-5, 0.1e-300,"
+            " 3.38e130, 9.0032e178, 7.0983e-62, 9007199254740993.0, 9007199254740993.000001,"
+            " 1.00000000000000011102230246251565404236316680908203125,"
+            " 1.00000000000000011102230246251565404236316680908203124,"
+            " 2.2250738585072011e-308, 4.9e-324, 2.4703282292062328e-324, 2.4703282292062327e-324,"
+            " 1.7976931348623157e308, 1.7976931348623158079e308, 0.000000000000000000000000000000001e-290,"
+            " 1.00000000000000011102230246251565404236316680908203125"
+            "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+            "1]";
+        constexpr auto numbers = JSON_PARSER_STATIC(text);
+        auto const parsed = parse_string(text);
+        for (std::size_t i = 0; i < numbers.root().size(); ++i) {
+            CAPTURE( i );
+            CHECK( numbers.root()[i].number() == parsed.array()[i].number() );
+        }
+        static_assert(JSON_PARSER_STATIC("3.38e130").root().number() == 3.38e130);
+        static_assert(JSON_PARSER_STATIC("7.0983e-62").root().number() == 7.0983e-62);
+        CHECK_THROWS_AS( static_node_count("1.7976931348623159e308"), JsonException );
+        CHECK_THROWS_AS( parse_string("1.7976931348623159e308"), JsonException );
+    }
+    SECTION("Accessors throw like Json") {
+        CHECK_THROWS_WITH( config.root()["port"].string(), "Invalid cast from number to string" );
+        CHECK_THROWS_AS( config.root()["missing"], std::out_of_range );
+        CHECK_THROWS_AS( config.root()["hosts"][3], std::out_of_range );
+        CHECK_THROWS_AS( config.root()["ratio"].integer(), JsonException );
+    }
+}
+
+TEST_CASE("Invalid JSON literals are errors", "[StaticJson]") {
+    using namespace json;
+
+    // at compile time they fail the build, at run time they throw
+    CHECK_THROWS_WITH( static_node_count(R"({"a": 1,})"),
+        "Invalid JSON literal at offset 8: Key of object element must be a string" );
+    CHECK_THROWS_WITH( static_node_count("[1 2]"),
+        "Invalid JSON literal at offset 3: Expected comma \",\" after element in array" );
+    CHECK_THROWS_WITH( static_node_count("\"abc"), "Invalid JSON literal at offset 0: Unterminated string" );
+    CHECK_THROWS_WITH( (parse_static<3, 0>(R"({"a": 1, "a": 2})")),
+        "Invalid JSON literal at offset 9: Duplicate key in object" );
+    for (auto const source : { "", "[", "{\"a\" 1}", "01", "1.", "-", "1e", "tru", "nullx", "[1,]", "\"\\x\"",
+                               "\"\\ud800\"", "\"\\u12g4\"", "\"\xc3\"", "1e400", "{} 1", "[1-2]" }) {
+        CAPTURE( source );
+        CHECK_THROWS_AS( static_node_count(source), JsonException );
+        CHECK_THROWS_AS( parse_string(source), JsonException );
+    }
+}
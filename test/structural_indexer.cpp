@@ -0,0 +1,79 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include "json_parser/detail/StructuralIndexer.h"
+#include <string>
+#include <vector>
+
+using namespace json;
+
+// byte by byte reference of the positions StructuralIndexer must report
+static auto reference_index(std::string const& source) -> std::vector<std::size_t> {
+    auto const is_op = [](char c) { return std::string_view("{}[]:,").find(c) != std::string_view::npos; };
+    auto const is_ws = [](char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; };
+
+    std::vector<std::size_t> positions;
+    bool in_string = false;
+    bool in_scalar = false;
+    for (std::size_t i = 0; i < source.size(); ++i) {
+        char const c = source[i];
+        if (in_string) {
+            if      (c == '\\') { ++i; }
+            else if (c == '"')  { in_string = false; }
+            continue;
+        }
+        if (c == '"') {
+            positions.push_back(i);
+            in_string = true;
+            in_scalar = false;
+        } else if (is_op(c) || is_ws(c)) {
+            if (is_op(c)) { positions.push_back(i); }
+            in_scalar = false;
+        } else {
+            // a backslash outside of a string still escapes the next byte
+            if (not in_scalar) { positions.push_back(i); }
+            in_scalar = true;
+            if (c == '\\') { ++i; }
+        }
+    }
+    return positions;
+}
+
+static auto index_all(std::string const& source, InstructionSet set) -> std::vector<std::size_t> {
+    std::vector<std::size_t> positions;
+    StructuralIndexer indexer(source, set);
+    for (auto p = indexer.next(); p != source.size(); p = indexer.next()) {
+        positions.push_back(p);
+    }
+    return positions;
+}
+
+TEST_CASE("StructuralIndexer matches the byte by byte reference", "[StructuralIndexer]") {
+    std::vector<std::string> const sources = {
+        "",
+        R"({ "a": [1, 2.5e3, true, null], "b": "x\"y" })",
+        R"(["\\", "\\\"", "\\\\\"\\\\"  ,  "]"])",
+        std::string(63, ' ') + R"("\"")" + std::string(60, ' ') + "[\"\\\\\"]",
+        std::string(62, ' ') + "\"" + std::string(70, '\\') + "\" , 12 ]",
+        "[" + std::string(200, 'a') + "]  truefalse \"unterminated",
+        "{ \"\xc3\xa9t\xc3\xa9\" : \"\xe2\x82\xac\" }\n\t\r",
+    };
+
+    for (auto const set : { InstructionSet::Scalar, InstructionSet::Sse42, InstructionSet::Avx2 }) {
+        if (not is_supported(set)) { continue; }
+        for (auto const& source : sources) {
+            INFO( to_string(set) << ": " << source );
+            CHECK( index_all(source, set) == reference_index(source) );
+        }
+    }
+}
+
+TEST_CASE("Scanner skips whitespace through the structural index", "[StructuralIndexer]") {
+    auto const pretty = std::string("{\n") + std::string(100, ' ') + "\"key\"  :\n\n    [ 1 ,\t2 ]\n}\n";
+    auto const json = parse_string(pretty);
+    CHECK( json.object().at("key").array().size() == 2 );
+
+    CHECK_THROWS_WITH( parse_string("{\n    \"a\": [1,\n            2 ?]\n}"),
+        "Scan error at [3:15]: \"?\" is an invalid character" );
+    CHECK_THROWS_WITH( parse_string("[1  \n  "),
+        "Parse error at [2:2][Eof: EOF]: Need right bracket \"]\" to terminate an array" );
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace {
+
+auto const source = std::string(R"({
+    "name": "tape",
+    "version": 1.5,
+    "enabled": true,
+    "nothing": null,
+    "list": [1, "two", [3], { "four": 4 }, []],
+    "records": [
+        { "id": 1, "label": "a long label that is well past the size of shared strings, stored as is" },
+        { "id": 2, "label": "a long label that is well past the size of shared strings, stored as is" }
+    ],
+    "wide": { "k0": 0, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5, "k6": 6,
+              "k7": 7, "k8": 8, "k9": 9, "k10": 10, "": 11 }
+})");
+
+} // namespace
+
+TEST_CASE("A tape reads back like the Json it encodes", "[Tape]") {
+    using namespace json;
+
+    auto const json = parse_string(source);
+    auto const doc = TapeDocument(encode_tape(json));
+    auto const root = doc.root();
+
+    CHECK( root.to_json().to_string() == json.to_string() );
+
+    REQUIRE( root.is_object() );
+    auto const object = root.object();
+    CHECK( object.size() == 7 );
+    CHECK( object.at("name").string() == "tape" );
+    CHECK( object.at("version").number() == 1.5 );
+    CHECK( object.at("enabled").boolean() );
+    CHECK( object.at("nothing").is_null() );
+    CHECK( object.count("missing") == 0 );
+    CHECK( object.find("missing") == object.end() );
+
+    auto const list = object.at("list").array();
+    REQUIRE( list.size() == 5 );
+    CHECK( list[0].number() == 1 );
+    CHECK( list[1].string() == "two" );
+    CHECK( list[2].array()[0].number() == 3 );
+    CHECK( list[3].object().at("four").number() == 4 );
+    CHECK( list[4].array().empty() );
+    CHECK_THROWS_AS( list.at(5), std::out_of_range );
+
+    SECTION("Members keep their order and large objects are searched") {
+        auto const wide = object.at("wide").object();
+        auto expected = 0.0;
+        for (auto const [key, value] : wide) {
+            CHECK( value.number() == expected++ );
+        }
+        for (auto const key : { "k0", "k5", "k9", "k10", "" }) {
+            REQUIRE( wide.count(key) == 1 );
+            CHECK( (*wide.find(key)).first == key );
+        }
+        // found members continue in insertion order
+        auto next = wide.find("k9");
+        CHECK( (*++next).first == "k10" );
+        CHECK( wide.find("k11") == wide.end() );
+        CHECK( wide.find("a") == wide.end() );
+        CHECK( wide.find("z") == wide.end() );
+        CHECK_THROWS_WITH( wide.at("k11"), "Key \"k11\" does not exist" );
+    }
+    SECTION("Type mismatches throw like Json") {
+        CHECK_THROWS_WITH( object.at("name").number(), "Invalid cast from string to number" );
+        CHECK_THROWS_WITH( root.array(), "Invalid cast from object to array" );
+    }
+    SECTION("Repeated short strings are stored once") {
+        auto const once = encode_tape(parse_string(R"([ "id", "id", "id", "id" ])"));
+        auto const twice = encode_tape(parse_string(R"([ "id", "ie", "if", "ig" ])"));
+        CHECK( once.size() + 6 == twice.size() );
+    }
+    SECTION("Values stay valid when the document moves") {
+        auto moved = TapeDocument(encode_tape(json));
+        auto const name = moved.root().object().at("name");
+        auto const other = std::move(moved);
+        CHECK( name.string() == "tape" );
+    }
+    SECTION("Iterators outlive the view they came from") {
+        auto element = root.object().at("list").array().begin();
+        auto const end = root.object().at("list").array().end();
+        CHECK( (*element).number() == 1 );
+        CHECK( (*++element).string() == "two" );
+        auto member = root.object().find("version");
+        CHECK( (*member).second.number() == 1.5 );
+        CHECK( element != end );
+    }
+}
+
+TEST_CASE("Tape files are mapped back", "[Tape]") {
+    using namespace json;
+
+    auto const path = (std::filesystem::temp_directory_path() / "json_parser_test.tape").string();
+    auto const json = parse_string(source);
+    save_tape(json, path);
+
+    auto const doc = load_tape(path);
+    CHECK( doc.size_bytes() == std::filesystem::file_size(path) );
+    CHECK( doc.root().object().at("records").array()[1].object().at("id").number() == 2 );
+    CHECK( doc.root().to_json().to_string() == json.to_string() );
+    std::filesystem::remove(path);
+
+    CHECK_THROWS_AS( load_tape(path), std::system_error );
+    CHECK_THROWS_AS( save_tape(json, "/nonexistent/dir/file.tape"), std::system_error );
+}
+
+TEST_CASE("Damaged tapes are rejected", "[Tape]") {
+    using namespace json;
+
+    auto const tape = encode_tape(parse_string(R"({ "a": [1, 2, 3] })"));
+
+    CHECK_THROWS_WITH( TapeDocument(""), "Invalid tape: too short for a header" );
+    CHECK_THROWS_WITH( TapeDocument(tape.substr(0, tape.size() - 1)),
+        "Invalid tape: sizes do not match the data" );
+
+    auto bad_magic = tape;
+    bad_magic[0] = 'X';
+    CHECK_THROWS_WITH( TapeDocument(bad_magic), "Invalid tape: bad magic" );
+
+    auto bad_version = tape;
+    bad_version[8] = 9;
+    CHECK_THROWS_WITH( TapeDocument(bad_version), "Invalid tape: unsupported version 9" );
+
+    // the first element of "a" pointing past the end of the tape: the root
+    // is [tag][member] ["a" tag][offset], then the array [tag][elements]
+    auto bad_index = tape;
+    auto const past_end = std::uint64_t{1000};
+    auto const table = 32 + 5 * 8;
+    std::memcpy(bad_index.data() + table, &past_end, sizeof past_end);
+    auto const doc = TapeDocument(bad_index);
+    auto const a = doc.root().object().at("a").array();
+    CHECK( a.size() == 3 );
+    CHECK_THROWS_WITH( a[0].number(), "Invalid tape: node out of bounds" );
+
+    SECTION("Children pointing back at an ancestor") {
+        for (auto const ancestor : { std::uint64_t{0}, std::uint64_t{4} }) {
+            CAPTURE( ancestor );
+            auto cycle = tape;
+            std::memcpy(cycle.data() + table, &ancestor, sizeof ancestor);
+            auto const damaged = TapeDocument(cycle);
+            CHECK_THROWS_WITH( damaged.root().to_json(), "Invalid tape: child before its parent" );
+        }
+    }
+}
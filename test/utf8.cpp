@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+#include "json_parser/core.h"
+#include "json_parser/detail/Utf8.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+auto const instruction_sets = {
+    json::InstructionSet::Scalar, json::InstructionSet::Sse42, json::InstructionSet::Avx2,
+};
+
+} // namespace
+
+TEST_CASE("find_invalid_utf8 follows RFC 3629", "[Utf8]") {
+    using namespace json;
+
+    auto const npos = std::string_view::npos;
+
+    SECTION("Valid text") {
+        for (auto const text : { "", "plain ascii", "caf\xc3\xa9", "\xe2\x82\xac 20",
+                                 "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "\xf0\x9f\x98\x80",
+                                 "\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80", "\xef\xbf\xbf",
+                                 "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf" }) {
+            CAPTURE( text );
+            for (auto const set : instruction_sets) {
+                CHECK( find_invalid_utf8(text, set) == npos );
+            }
+        }
+    }
+    SECTION("Malformed sequences") {
+        struct Case { std::string_view text; std::size_t offset; };
+        for (auto const& [text, offset] : std::vector<Case>{
+                 { "\x80", 0 },                     // lone continuation byte
+                 { "ab\xc0\xaf", 2 },               // overlong '/'
+                 { "\xc1\xbf", 0 },                 // overlong
+                 { "\xe0\x9f\xbf", 0 },             // overlong three bytes
+                 { "\xf0\x8f\xbf\xbf", 0 },         // overlong four bytes
+                 { "x\xed\xa0\x80", 1 },            // surrogate U+D800
+                 { "\xed\xbf\xbf", 0 },             // surrogate U+DFFF
+                 { "\xf4\x90\x80\x80", 0 },         // above U+10FFFF
+                 { "\xf5\x80\x80\x80", 0 },
+                 { "\xff", 0 },
+                 { "caf\xc3", 3 },                  // cut by the end
+                 { "\xe2\x82", 0 },
+                 { "\xe2\x28\xa1", 0 },             // bad continuation byte
+             }) {
+            CAPTURE( text );
+            for (auto const set : instruction_sets) {
+                CHECK( find_invalid_utf8(text, set) == offset );
+            }
+        }
+    }
+    SECTION("Instruction sets agree past their block sizes") {
+        auto text = std::string();
+        for (auto i = 0; i < 40; ++i) { text += "0123456789abcdef\xc3\xa9\xe2\x82\xac"; }
+        for (auto const set : instruction_sets) {
+            CHECK( find_invalid_utf8(text, set) == npos );
+        }
+        for (auto position : { std::size_t{0}, std::size_t{15}, std::size_t{31}, std::size_t{32},
+                               std::size_t{63}, text.size() - 1 }) {
+            CAPTURE( position );
+            auto broken = text;
+            broken[position] = '\xff';
+            auto const expected = find_invalid_utf8(broken, InstructionSet::Scalar);
+            CHECK( expected <= position );
+            for (auto const set : instruction_sets) {
+                CHECK( find_invalid_utf8(broken, set) == expected );
+            }
+        }
+    }
+}
+
+TEST_CASE("find_quote_or_backslash finds the end of a string run", "[Utf8]") {
+    using namespace json;
+
+    auto const text = std::string_view("0123456789abcdefghij\\klmnop\"");
+    CHECK( find_quote_or_backslash(text, 0) == 20 );
+    CHECK( find_quote_or_backslash(text, 21) == 27 );
+    CHECK( find_quote_or_backslash(text, 28) == text.size() );
+    CHECK( find_quote_or_backslash("no special byte at all", 0) == 22 );
+}
+
+TEST_CASE("\\u escapes are decoded to UTF-8", "[Utf8]") {
+    using namespace json;
+
+    CHECK( parse_string(R"("\u0041")").string() == "A" );
+    CHECK( parse_string(R"("\u00e9t\u00E9")").string() == "\xc3\xa9t\xc3\xa9" );
+    CHECK( parse_string(R"("\u20ac")").string() == "\xe2\x82\xac" );
+    CHECK( parse_string(R"("\uffff")").string() == "\xef\xbf\xbf" );
+    CHECK( parse_string(R"("\u0000")").string() == std::string_view("\0", 1) );
+    CHECK( parse_string(R"("\uD83D\uDE00")").string() == "\xf0\x9f\x98\x80" );
+    CHECK( parse_string(R"("a\udbff\udfffb")").string() == "a\xf4\x8f\xbf\xbf" "b" );
+    CHECK( parse_string(R"("\u00ab\u00cd\u00ef")").string() == "\xc2\xab\xc3\x8d\xc3\xaf" );
+
+    SECTION("Pushed in chunks of any size") {
+        auto const source = std::string_view(R"(["\u00e9", "\uD83D\uDE00", "x\u20acy"])");
+        for (std::size_t size = 1; size <= source.size(); ++size) {
+            CAPTURE( size );
+            auto parser = JsonPushParser();
+            for (std::size_t at = 0; at < source.size(); at += size) {
+                parser.feed(source.substr(at, size));
+            }
+            auto const json = parser.finish();
+            CHECK( json.array()[0].string() == "\xc3\xa9" );
+            CHECK( json.array()[1].string() == "\xf0\x9f\x98\x80" );
+            CHECK( json.array()[2].string() == "x\xe2\x82\xacy" );
+        }
+    }
+}
+
+TEST_CASE("Malformed strings are errors", "[Utf8]") {
+    using namespace json;
+
+    CHECK_THROWS_WITH( parse_string(R"(["\ud800"])"),
+        "Scan error at [1:2]: Unpaired surrogate in \\u escape" );
+    CHECK_THROWS_WITH( parse_string(R"("\ud800\u0041")"),
+        "Scan error at [1:1]: Unpaired surrogate in \\u escape" );
+    CHECK_THROWS_WITH( parse_string(R"("\udc00")"),
+        "Scan error at [1:1]: Unpaired surrogate in \\u escape" );
+    CHECK_THROWS_WITH( parse_string(R"("\u12g4")"),
+        "Scan error at [1:7]: Escape hex-code character can only be in [0, 9] or [a, f] or [A, F], found \"g\"" );
+    CHECK_THROWS_WITH( parse_string("[\"ok\", \"caf\xc3\"]"),
+        "Scan error at [1:8]: Invalid UTF-8 in string" );
+    CHECK_THROWS_WITH( parse_string("\"\\n\xed\xa0\x80\""), "Scan error at [1:1]: Invalid UTF-8 in string" );
+
+    SECTION("Unterminated strings") {
+        CHECK_THROWS_WITH( parse_string("\"abc"), "Scan error at [1:1]: Unterminated string" );
+        CHECK_THROWS_WITH( parse_string("[\"a\\"), "Scan error at [1:2]: Unterminated string" );
+        CHECK_THROWS_WITH( parse_string("\"\\u00"), "Scan error at [1:1]: Unterminated string" );
+        CHECK_THROWS_WITH( parse_string("\"\\ud83d\\"), "Scan error at [1:1]: Unterminated string" );
+    }
+}